@@ -0,0 +1,42 @@
+@echo off
+rem Records the Noesis render captures of the demo screens used as render device benchmarks, then
+rem replays them with the NoesisRenderReplay commandlet. Captures are written to
+rem Saved\Noesis\Captures as MainPage, Buttons and QuestLog.noesiscapture.
+rem
+rem Usage: RecordNoesisCaptures.bat [Frames=120] [Iterations=10]
+rem Set UE_ROOT to the engine directory if it is not installed in the default location.
+
+setlocal
+if "%UE_ROOT%"=="" set "UE_ROOT=C:\Program Files\Epic Games\UE_5.4"
+set "FRAMES=%~1"
+if "%FRAMES%"=="" set "FRAMES=120"
+set "ITERATIONS=%~2"
+if "%ITERATIONS%"=="" set "ITERATIONS=10"
+
+set "EDITOR=%UE_ROOT%\Engine\Binaries\Win64\UnrealEditor.exe"
+set "EDITOR_CMD=%UE_ROOT%\Engine\Binaries\Win64\UnrealEditor-Cmd.exe"
+set "PROJECT=%~dp0..\..\NoesisDemo.uproject"
+set "GAME_ARGS=-game -windowed -ResX=1920 -ResY=1080 -NoSound -unattended"
+
+if not exist "%EDITOR%" (
+    echo UnrealEditor.exe not found in "%UE_ROOT%", set UE_ROOT to the engine directory
+    exit /b 1
+)
+
+rem Each screen is recorded from the level that opens it, the capture quits the game once it is saved
+call :Record MainPage L_Home || exit /b 1
+call :Record Buttons L_Buttons || exit /b 1
+call :Record QuestLog L_QuestLog || exit /b 1
+
+"%EDITOR_CMD%" "%PROJECT%" -run=NoesisRenderReplay -Iterations=%ITERATIONS% -unattended -stdout
+exit /b %ERRORLEVEL%
+
+:Record
+echo Recording %1
+del /q "%~dp0..\..\Saved\Noesis\Captures\%1.noesiscapture" 2>nul
+"%EDITOR%" "%PROJECT%" /Game/Map/%2 %GAME_ARGS% -ExecCmds="Noesis.RenderCapture.Start %1 %FRAMES% 0 1"
+if not exist "%~dp0..\..\Saved\Noesis\Captures\%1.noesiscapture" (
+    echo Capture of %1 was not saved
+    exit /b 1
+)
+exit /b 0
@@ -315,6 +315,15 @@ function createTMapProxy(owner, propName, tmap, enableLogging = false) {
                                 console.log(`[NoesisProxy] TMap.Reset: ${propName}`);
                             }
                             return resetResult;
+                        case 'AddMany':
+                        case 'RemoveMany':
+                            // 批量增删，只发一次 Reset 通知，避免逐个 key 通知
+                            const batchResult = value.apply(target, args);
+                            UE.NoesisNotifyHelperLibrary.NotifyMapPostReset(owner, propName);
+                            if (enableLogging) {
+                                console.log(`[NoesisProxy] TMap.${prop}: ${propName}`);
+                            }
+                            return batchResult;
                         default:
                             // 其他方法直接调用
                             return value.apply(target, args);
@@ -0,0 +1,153 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+ * This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+ */
+
+var global = global || (function () { return this; }());
+(function (global) {
+    "use strict";
+
+    const createWorker = global.__tgjsCreateWorker;
+    global.__tgjsCreateWorker = undefined;
+
+    const postMessageToWorker = global.__tgjsPostMessageToWorker;
+    global.__tgjsPostMessageToWorker = undefined;
+
+    const terminateWorker = global.__tgjsTerminateWorker;
+    global.__tgjsTerminateWorker = undefined;
+
+    const setWorkerMessageHandler = global.__tgjsSetWorkerMessageHandler;
+    global.__tgjsSetWorkerMessageHandler = undefined;
+
+    if (typeof createWorker !== 'function') return; // quickjs后端没有worker
+
+    const workers = new Map();
+
+    // 每帧由c++在游戏线程调用，worker里未捕获的异常以error参数传入
+    setWorkerMessageHandler(function(id, data, error) {
+        const worker = workers.get(id);
+        if (worker === undefined) return;
+        if (error !== undefined) {
+            worker._onError(error);
+        } else if (data !== null && typeof data === 'object' && data.__puertsTaskId !== undefined) {
+            worker._onReply(data.__puertsTaskId, data.result, data.error);
+        } else if (typeof worker.onmessage === 'function') {
+            worker.onmessage({data: data});
+        }
+    });
+
+    // 在独立线程的isolate上执行moduleName，worker里没有UE对象，只能通过postMessage交换可结构化克隆的数据
+    class Worker {
+        constructor(moduleName) {
+            this._id = createWorker(moduleName);
+            this._nextTaskId = 0;
+            this._pendingTasks = new Map();
+            this.onmessage = undefined;
+            this.onerror = undefined;
+            workers.set(this._id, this);
+        }
+
+        get id() {
+            return this._id;
+        }
+
+        // 尚未收到结果的request数量
+        get pendingCount() {
+            return this._pendingTasks.size;
+        }
+
+        postMessage(message, transfer) {
+            this._checkAlive();
+            postMessageToWorker(this._id, message, transfer);
+        }
+
+        // 由worker里的onrequest处理，返回的Promise在游戏线程上resolve/reject，
+        // 没有处理的reject跟其它Promise一样走puerts的unhandledRejection
+        request(data, transfer) {
+            this._checkAlive();
+            const taskId = ++this._nextTaskId;
+            return new Promise((resolve, reject) => {
+                postMessageToWorker(this._id, {__puertsTaskId: taskId, data: data}, transfer);
+                this._pendingTasks.set(taskId, {resolve, reject});
+            });
+        }
+
+        terminate() {
+            if (this._id === undefined) return;
+            terminateWorker(this._id);
+            workers.delete(this._id);
+            this._id = undefined;
+            const pendingTasks = this._pendingTasks;
+            this._pendingTasks = new Map();
+            for (const task of pendingTasks.values()) {
+                task.reject(new Error('worker terminated'));
+            }
+        }
+
+        _checkAlive() {
+            if (this._id === undefined) {
+                throw new Error('worker is terminated');
+            }
+        }
+
+        _onReply(taskId, result, error) {
+            const task = this._pendingTasks.get(taskId);
+            if (task === undefined) return;
+            this._pendingTasks.delete(taskId);
+            if (error !== undefined) {
+                task.reject(new Error(error));
+            } else {
+                task.resolve(result);
+            }
+        }
+
+        _onError(error) {
+            if (typeof this.onerror === 'function') {
+                this.onerror({message: error});
+            } else {
+                console.error(`Exception in Worker ${this._id}: ${error}`);
+            }
+        }
+    }
+
+    // 固定数量的worker，每个任务分给未完成任务最少的那个
+    class WorkerPool {
+        constructor(moduleName, size) {
+            if (!(size > 0)) {
+                throw new Error('pool size must be greater than 0');
+            }
+            this._workers = [];
+            for (let i = 0; i < size; i++) {
+                this._workers.push(new Worker(moduleName));
+            }
+        }
+
+        get size() {
+            return this._workers.length;
+        }
+
+        run(data, transfer) {
+            if (this._workers.length === 0) {
+                return Promise.reject(new Error('worker pool is terminated'));
+            }
+            let selected = this._workers[0];
+            for (let i = 1; i < this._workers.length; i++) {
+                if (this._workers[i].pendingCount < selected.pendingCount) {
+                    selected = this._workers[i];
+                }
+            }
+            return selected.request(data, transfer);
+        }
+
+        terminate() {
+            const workerList = this._workers;
+            this._workers = [];
+            workerList.forEach(worker => worker.terminate());
+        }
+    }
+
+    puerts.Worker = Worker;
+    puerts.WorkerPool = WorkerPool;
+}(global));
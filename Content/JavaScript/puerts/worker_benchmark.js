@@ -0,0 +1,78 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+ * This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+ */
+
+// puerts.Worker的压力测试：require('puerts/worker_benchmark').run({messages: 10000, payloadBytes: 1024, workers: 4})
+// 延迟为request发出到Promise resolve的往返时间，worker的结果在游戏线程每帧tick时分发，所以延迟至少包含等待下一帧的时间
+const now = (typeof performance !== 'undefined' && performance.now) ? () => performance.now() : () => Date.now();
+
+function percentile(sorted, p) {
+    if (sorted.length === 0) return 0;
+    return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+function makePayload(payloadBytes, useTransfer) {
+    if (useTransfer) {
+        return new ArrayBuffer(payloadBytes);
+    }
+    return {bytes: 'x'.repeat(payloadBytes)};
+}
+
+async function measureLatency(pool, rounds, payloadBytes, useTransfer) {
+    const latencies = new Array(rounds);
+    for (let i = 0; i < rounds; i++) {
+        const payload = makePayload(payloadBytes, useTransfer);
+        const start = now();
+        await pool.run(payload, useTransfer ? [payload] : undefined);
+        latencies[i] = now() - start;
+    }
+    latencies.sort((a, b) => a - b);
+    return {
+        avg: latencies.reduce((a, b) => a + b, 0) / Math.max(rounds, 1),
+        p50: percentile(latencies, 0.5),
+        p99: percentile(latencies, 0.99),
+        max: latencies.length > 0 ? latencies[latencies.length - 1] : 0,
+    };
+}
+
+async function measureThroughput(pool, messages, payloadBytes, useTransfer) {
+    const start = now();
+    const tasks = new Array(messages);
+    for (let i = 0; i < messages; i++) {
+        const payload = makePayload(payloadBytes, useTransfer);
+        tasks[i] = pool.run(payload, useTransfer ? [payload] : undefined);
+    }
+    await Promise.all(tasks);
+    const seconds = Math.max(now() - start, 1) / 1000;
+    return {
+        seconds: seconds,
+        messagesPerSecond: messages / seconds,
+        megabytesPerSecond: messages * payloadBytes * 2 / (1024 * 1024) / seconds,
+    };
+}
+
+async function run(options) {
+    options = options || {};
+    const messages = options.messages || 10000;
+    const payloadBytes = options.payloadBytes || 1024;
+    const workers = options.workers || 1;
+    const useTransfer = options.transfer !== false;
+    const latencyRounds = options.latencyRounds || Math.min(messages, 200);
+
+    const pool = new puerts.WorkerPool('puerts/worker_benchmark_echo', workers);
+    try {
+        const latency = await measureLatency(pool, latencyRounds, payloadBytes, useTransfer);
+        const throughput = await measureThroughput(pool, messages, payloadBytes, useTransfer);
+        console.log(`worker benchmark: workers=${workers} payload=${payloadBytes}B transfer=${useTransfer}`);
+        console.log(`  latency(ms): avg=${latency.avg.toFixed(3)} p50=${latency.p50.toFixed(3)} p99=${latency.p99.toFixed(3)} max=${latency.max.toFixed(3)} (${latencyRounds} round trips)`);
+        console.log(`  throughput: ${throughput.messagesPerSecond.toFixed(0)} msg/s, ${throughput.megabytesPerSecond.toFixed(2)} MB/s (${messages} messages in ${throughput.seconds.toFixed(3)}s)`);
+        return {latency, throughput};
+    } finally {
+        pool.terminate();
+    }
+}
+
+exports.run = run;
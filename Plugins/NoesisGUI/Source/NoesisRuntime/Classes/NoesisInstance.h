@@ -23,10 +23,15 @@
 
 // NoesisRuntime includes
 #include "NoesisBlueprint.h"
+#include "NoesisInputRouter.h"
 
 // Generated header include
 #include "NoesisInstance.generated.h"
 
+#if WITH_ENHANCED_INPUT
+enum class ETriggerEvent : uint8;
+#endif
+
 UENUM()
 enum class NoesisInstanceRenderFlags : uint8
 {
@@ -243,6 +248,18 @@ class NOESISRUNTIME_API UNoesisInstance : public UUserWidget
 	void RegisterInputAction(FInputActionBinding Binding);
 	void UnregisterInputAction(FInputActionBinding Binding);
 
+	// Input actions of triggers go through the routing table, Owner identifies the handler to remove
+	void AddInputActionHandler(FName ActionName, EInputEvent KeyEvent, const void* Owner, FSimpleDelegate Handler);
+	void RemoveInputActionHandler(FName ActionName, EInputEvent KeyEvent, const void* Owner);
+#if WITH_ENHANCED_INPUT
+	void AddEnhancedInputActionHandler(const class UInputAction* Action, ETriggerEvent TriggerEvent, const void* Owner, FSimpleDelegate Handler);
+	void RemoveEnhancedInputActionHandler(const class UInputAction* Action, ETriggerEvent TriggerEvent, const void* Owner);
+#endif
+	void OnRoutedInputAction(int32 RouteId);
+	void ResetInputRoutes();
+
+	FNoesisInputRouter InputRouter;
+
 #if WITH_ENHANCED_INPUT
 	void OnEnhancedInputActionTriggered(Noesis::Key);
 	void OnEnhancedInputActionCompleted(Noesis::Key);
@@ -0,0 +1,31 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Core includes
+#include "CoreMinimal.h"
+
+// Engine includes
+#include "Commandlets/Commandlet.h"
+
+// Generated header include
+#include "NoesisRenderReplayCommandlet.generated.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Replays render captures recorded with Noesis.RenderCapture.Start and logs the CPU time of each
+/// render device call. Commandlets run with NullRHI unless -AllowCommandletRendering is given.
+///
+/// Usage: -run=NoesisRenderReplay [-Capture=<file or directory>] [-Iterations=10]
+////////////////////////////////////////////////////////////////////////////////////////////////////
+UCLASS()
+class UNoesisRenderReplayCommandlet : public UCommandlet
+{
+	GENERATED_UCLASS_BODY()
+
+	// UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End of UCommandlet interface
+};
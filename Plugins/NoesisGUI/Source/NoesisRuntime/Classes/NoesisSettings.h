@@ -73,6 +73,14 @@ class NOESISRUNTIME_API UNoesisSettings : public UObject
 	UPROPERTY(EditAnywhere, Config, Category = "XAML")
 	bool LoadPlatformFonts;
 
+	/** Loads textures referenced by URI that are not in memory yet asynchronously instead of blocking the XAML load. A texture whose dimensions are not in the asset registry is still loaded synchronously */
+	UPROPERTY(EditAnywhere, Config, Category = "XAML")
+	bool AsyncTextureLoading;
+
+	/** Texture drawn while an asynchronously loaded texture is not available yet. When empty nothing is drawn, the layout uses the final texture dimensions in both cases */
+	UPROPERTY(EditAnywhere, Config, Category = "XAML", meta = (AllowedClasses = "/Script/Engine.Texture2D", EditCondition = "AsyncTextureLoading"))
+	FSoftObjectPath AsyncTexturePlaceholder;
+
 	/** Default value for FontSize when it is not specified in a control or text element */
 	UPROPERTY(EditAnywhere, Config, Category = "XAML", meta = (ClampMin = 0, UIMin = 0))
 	float DefaultFontSize;
@@ -113,6 +121,10 @@ class NOESISRUNTIME_API UNoesisSettings : public UObject
 	UPROPERTY(EditAnywhere, Config, Category = "Rendering", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
 	int32 OffscreenTextureHeight;
 
+	/** Video memory in MB for offscreen render targets kept for reuse. Idle targets are evicted beyond it (0 = no pooling) */
+	UPROPERTY(EditAnywhere, Config, Category = "Rendering", DisplayName = "Offscreen Pool Budget (MB)", meta = (ConfigRestartRequired = true, ClampMin = 0, UIMin = 0))
+	int32 OffscreenPoolBudget;
+
 	/** Sets the logging level for general messages */
 	UPROPERTY(EditAnywhere, Config, Category = "Editor Settings")
 	ENoesisLoggingSettings GeneralLogLevel;
@@ -17,6 +17,13 @@
 // Generated header include
 #include "NoesisWorldUIComponent.generated.h"
 
+enum class ENoesisWorldUILOD : uint8
+{
+	Full,
+	Low,
+	Culled
+};
+
 UCLASS( BlueprintType, ClassGroup=(Noesis), meta=(BlueprintSpawnableComponent) )
 class NOESISRUNTIME_API UNoesisWorldUIComponent: public USceneComponent
 {
@@ -28,6 +35,9 @@ public:
 	void Add3DElement();
 	void Remove3DElement();
 
+	/** Releases the DataTemplates shared by instanced components, they are created again on demand */
+	static void ClearTemplateCache();
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -49,9 +59,35 @@ public:
 	UPROPERTY(EditAnywhere, Category = Noesis)
 	bool Center;
 
+	/** Instantiates Xaml from a DataTemplate shared with every other instanced component instead of loading it for each one.
+		The root of Xaml (and LODXaml) must be a DataTemplate, the DataContext is used as its content. Visibility, LOD and
+		sorting of all instanced components are updated together once per frame */
+	UPROPERTY(EditAnywhere, Category = "Noesis|Instancing")
+	bool Instanced;
+
+	/** Simpler DataTemplate used beyond LODDistance. When not set the Xaml template is kept but stops being sorted */
+	UPROPERTY(EditAnywhere, Category = "Noesis|Instancing", meta = (EditCondition = "Instanced"))
+	UNoesisXaml* LODXaml;
+
+	/** Distance to the camera at which the LOD is used (0 = never) */
+	UPROPERTY(EditAnywhere, Category = "Noesis|Instancing", meta = (EditCondition = "Instanced", ClampMin = 0, UIMin = 0))
+	float LODDistance;
+
+	/** Distance to the camera at which the element is collapsed and stops being updated (0 = never) */
+	UPROPERTY(EditAnywhere, Category = "Noesis|Instancing", meta = (EditCondition = "Instanced", ClampMin = 0, UIMin = 0))
+	float CullDistance;
+
 	UFUNCTION(BlueprintCallable, Category = "NoesisGUI")
 	void SetDataContext(UObject* DataContext);
 
+	void SetLOD(ENoesisWorldUILOD InLOD);
+	void UpdateZIndex(const FVector& ViewLocation, const FVector& ViewForward);
+
 	Noesis::Ptr<Noesis::FrameworkElement> Element;
 	FDelegateHandle TransformUpdatedDelegateHandle;
+
+	bool IsInstancedElement;
+	bool TransformDirty;
+	ENoesisWorldUILOD LOD;
+	int32 ZIndex;
 };
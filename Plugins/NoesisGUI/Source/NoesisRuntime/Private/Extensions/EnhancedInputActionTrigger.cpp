@@ -13,17 +13,6 @@
 #include "NoesisRuntimeModule.h"
 #include "NoesisSupport.h"
 
-////////////////////////////////////////////////////////////////////////////////////////////////////
-class UNoesisEnhancedInputDelegateHandler : public UObject
-{
-public:
-    void ForwardAction(EnhancedInputActionTrigger* Trigger)
-    {
-        Trigger->OnInputAction();
-    }
-};
-
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 const Noesis::Uri& EnhancedInputActionTrigger::GetAction() const
 {
@@ -83,7 +72,7 @@ void EnhancedInputActionTrigger::RegisterAction()
     {
         auto InputComponent = mInstance->GetInputComponent();
 
-        if (auto EnhancedInputComponent = Cast<UEnhancedInputComponent>(InputComponent))
+        if (Cast<UEnhancedInputComponent>(InputComponent) != nullptr)
         {
             const Noesis::Uri& ActionUri = GetAction();
             FString ActionPath = NsProviderUriToAssetPath(ActionUri);
@@ -95,7 +84,11 @@ void EnhancedInputActionTrigger::RegisterAction()
                 return;
             }
 
-            InputBindingHandle = EnhancedInputComponent->BindAction(Action, TriggerEvent, GetMutableDefault<UNoesisEnhancedInputDelegateHandler>(), &UNoesisEnhancedInputDelegateHandler::ForwardAction, this).GetHandle();
+            // Triggers sharing the action and event are dispatched through a single binding
+            mInstance->AddEnhancedInputActionHandler(Action, TriggerEvent, this,
+                FSimpleDelegate::CreateRaw(this, &EnhancedInputActionTrigger::OnInputAction));
+            mRegisteredAction = Action;
+            mRegisteredEvent = TriggerEvent;
         }
     }
 }
@@ -103,15 +96,10 @@ void EnhancedInputActionTrigger::RegisterAction()
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void EnhancedInputActionTrigger::UnregisterAction()
 {
-    if (mInstance != nullptr && InputBindingHandle != 0)
+    if (mInstance != nullptr && mRegisteredAction != nullptr)
     {
-        auto InputComponent = mInstance->GetInputComponent();
-
-        if (auto EnhancedInputComponent = Cast<UEnhancedInputComponent>(InputComponent))
-        {
-            EnhancedInputComponent->RemoveBindingByHandle(InputBindingHandle);
-            InputBindingHandle = 0;
-        }
+        mInstance->RemoveEnhancedInputActionHandler(mRegisteredAction, mRegisteredEvent, this);
+        mRegisteredAction = nullptr;
     }
 }
 
@@ -72,9 +72,9 @@ void InputActionTrigger::RegisterAction(const char* action, InputActionType type
 {
     if (mInstance != nullptr && !Noesis::StrIsEmpty(action))
     {
-        FInputActionBinding binding(UTF8_TO_TCHAR(action), (EInputEvent)type);
-        binding.ActionDelegate.GetDelegateForManualSet().BindRaw(this, &InputActionTrigger::OnInputAction);
-        mInstance->RegisterInputAction(binding);
+        // Triggers sharing the action and type are dispatched through a single binding
+        mInstance->AddInputActionHandler(FName(UTF8_TO_TCHAR(action)), (EInputEvent)type, this,
+            FSimpleDelegate::CreateRaw(this, &InputActionTrigger::OnInputAction));
     }
 }
 
@@ -83,8 +83,7 @@ void InputActionTrigger::UnregisterAction(const char* action, InputActionType ty
 {
     if (mInstance != nullptr && !Noesis::StrIsEmpty(action))
     {
-        FInputActionBinding binding(UTF8_TO_TCHAR(action), (EInputEvent)type);
-        mInstance->UnregisterInputAction(binding);
+        mInstance->RemoveInputActionHandler(FName(UTF8_TO_TCHAR(action)), (EInputEvent)type, this);
     }
 }
 
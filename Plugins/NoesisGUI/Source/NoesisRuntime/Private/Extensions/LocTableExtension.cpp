@@ -4,6 +4,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Extensions/LocTableExtension.h"
+#include "Extensions/LocalizationRegistry.h"
 #include "NsGui/ContentPropertyMetaData.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +39,22 @@ static void DynamicConvert(const Noesis::Type* targetType, Noesis::Ptr<Noesis::B
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static FNoesisLocKey GetLocKey(const LocTableExtension* extension, Noesis::DependencyObject* object)
+{
+    const char* id = extension->GetId();
+    if (strlen(id) == 0)
+    {
+        id = object->GetValue<Noesis::String>(LocTableExtension::IdProperty).Str();
+    }
+
+    FNoesisLocKey Key;
+    Key.Kind = ENoesisLocSource::StringTable;
+    Key.Namespace = UTF8_TO_TCHAR(id);
+    Key.Key = UTF8_TO_TCHAR(extension->GetKey());
+    return Key;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 class LocTableExpression : public Noesis::Expression
 {
@@ -45,23 +62,20 @@ public:
     LocTableExpression(LocTableExtension* extension, Noesis::DependencyObject* targetObject, const Noesis::DependencyProperty* targetProperty,
         Noesis::Ptr<Noesis::IValueConverter> converter, Noesis::Ptr<BaseComponent> converterParameter)
         : mExtension(extension), mTargetObject(targetObject), mTargetProperty(targetProperty),
-        mConverter(converter), mConverterParameter(converterParameter)
+        mConverter(converter), mConverterParameter(converterParameter), mBinding(targetObject, targetProperty)
     {
-        CultureChangedHandle = FTextLocalizationManager::Get().OnTextRevisionChangedEvent.AddRaw(this, &LocTableExpression::OnCultureChanged);
     }
 
     ~LocTableExpression()
     {
-        FTextLocalizationManager::Get().OnTextRevisionChangedEvent.Remove(CultureChangedHandle);
+        FNoesisLocalizationRegistry::Get().Unbind(mBinding);
     }
 
     Noesis::Ptr<Noesis::BaseComponent> Evaluate() const
     {
-        FString DisplayString = mExtension->GetDisplayString(mTargetObject);
-
-        Noesis::String(TCHAR_TO_UTF8(*DisplayString));
-
-        Noesis::Ptr<Noesis::BaseComponent> sourceVal = Noesis::Boxing::Box(TCHAR_TO_UTF8(*DisplayString));
+        // Boxed strings are shared by every expression bound to the same table entry
+        Noesis::Ptr<Noesis::BaseComponent> sourceVal = FNoesisLocalizationRegistry::Get().Resolve(mBinding,
+            GetLocKey(mExtension, mTargetObject));
 
         Noesis::Ptr<BaseComponent> convertedVal;
         if (mConverter && mConverter->TryConvert(sourceVal, mTargetProperty->GetType(),
@@ -96,18 +110,13 @@ public:
     {
     }
 
-    void OnCultureChanged()
-    {
-        mTargetObject->InvalidateProperty(mTargetProperty);
-    }
-
 private:
     Noesis::Ptr<LocTableExtension> mExtension;
     Noesis::DependencyObject* mTargetObject;
     const Noesis::DependencyProperty* mTargetProperty;
     Noesis::Ptr<Noesis::IValueConverter> mConverter;
     Noesis::Ptr<BaseComponent> mConverterParameter;
-    FDelegateHandle CultureChangedHandle;
+    mutable FNoesisLocBinding mBinding;
 
     NS_IMPLEMENT_INLINE_REFLECTION_(LocTableExpression, Noesis::Expression)
 };
@@ -175,12 +184,9 @@ void LocTableExtension::SetConverterParameter(BaseComponent* value)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 FString LocTableExtension::GetDisplayString(Noesis::DependencyObject* object)
 {
-    const char* id = GetId();
-    if (strlen(id) == 0)
-    {
-        id = object->GetValue<Noesis::String>(IdProperty).Str();
-    }
-    return FText::FromStringTable(UTF8_TO_TCHAR(id), UTF8_TO_TCHAR(GetKey()), EStringTableLoadingPolicy::FindOrLoad).ToString();
+    FString DisplayString;
+    FNoesisLocalizationRegistry::LookupString(GetLocKey(this, object), DisplayString);
+    return DisplayString;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
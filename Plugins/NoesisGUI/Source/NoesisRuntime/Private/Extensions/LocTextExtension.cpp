@@ -4,30 +4,44 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Extensions/LocTextExtension.h"
+#include "Extensions/LocalizationRegistry.h"
 #include "NsGui/ContentPropertyMetaData.h"
 
-// Core includes
-#include "Misc/EngineVersionComparison.h"
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static FNoesisLocKey GetLocKey(const LocTextExtension* extension, Noesis::DependencyObject* object)
+{
+    const char* ns = extension->GetNamespace();
+    if (strlen(ns) == 0)
+    {
+        ns = object->GetValue<Noesis::String>(LocTextExtension::NamespaceProperty).Str();
+    }
+
+    FNoesisLocKey Key;
+    Key.Kind = ENoesisLocSource::TextNamespace;
+    Key.Namespace = UTF8_TO_TCHAR(ns);
+    Key.Key = UTF8_TO_TCHAR(extension->GetKey());
+    Key.Source = UTF8_TO_TCHAR(extension->GetSource());
+    return Key;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 class LocTextExpression : public Noesis::Expression
 {
 public:
     LocTextExpression(LocTextExtension* extension, Noesis::DependencyObject* targetObject, const Noesis::DependencyProperty* targetProperty)
-        : mExtension(extension), mTargetObject(targetObject), mTargetProperty(targetProperty)
+        : mExtension(extension), mTargetObject(targetObject), mTargetProperty(targetProperty),
+        mBinding(targetObject, targetProperty)
     {
-        CultureChangedHandle = FTextLocalizationManager::Get().OnTextRevisionChangedEvent.AddRaw(this, &LocTextExpression::OnCultureChanged);
     }
 
     ~LocTextExpression()
     {
-        FTextLocalizationManager::Get().OnTextRevisionChangedEvent.Remove(CultureChangedHandle);
+        FNoesisLocalizationRegistry::Get().Unbind(mBinding);
     }
 
     Noesis::Ptr<Noesis::BaseComponent> Evaluate() const
     {
-        FString DisplayString = mExtension->GetDisplayString(mTargetObject);
-        return Noesis::Boxing::Box(TCHAR_TO_UTF8(*DisplayString));
+        return FNoesisLocalizationRegistry::Get().Resolve(mBinding, GetLocKey(mExtension, mTargetObject));
     }
 
     Noesis::Ptr<Noesis::Expression> Reapply(Noesis::DependencyObject* targetObject, const Noesis::DependencyProperty* targetProperty) const
@@ -51,16 +65,11 @@ public:
     {
     }
 
-    void OnCultureChanged()
-    {
-        mTargetObject->InvalidateProperty(mTargetProperty);
-    }
-
 private:
     Noesis::Ptr<LocTextExtension> mExtension;
     Noesis::DependencyObject* mTargetObject;
     const Noesis::DependencyProperty* mTargetProperty;
-    FDelegateHandle CultureChangedHandle;
+    mutable FNoesisLocBinding mBinding;
 
     NS_IMPLEMENT_INLINE_REFLECTION_(LocTextExpression, Noesis::Expression)
 };
@@ -104,19 +113,9 @@ void LocTextExtension::SetSource(const char* value)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 FString LocTextExtension::GetDisplayString(Noesis::DependencyObject* object)
 {
-    const char* ns = GetNamespace();
-    if (strlen(ns) == 0)
-    {
-        ns = object->GetValue<Noesis::String>(NamespaceProperty).Str();
-    }
-    FText Text;
-    FString Source(UTF8_TO_TCHAR(GetSource()));
-#if UE_VERSION_OLDER_THAN(5, 5, 0)
-    FText::FindText(UTF8_TO_TCHAR(ns), UTF8_TO_TCHAR(GetKey()), Text, &Source);
-#else
-    FText::FindTextInLiveTable_Advanced(UTF8_TO_TCHAR(ns), UTF8_TO_TCHAR(GetKey()), Text, &Source);
-#endif
-    return Text.ToString();
+    FString DisplayString;
+    FNoesisLocalizationRegistry::LookupString(GetLocKey(this, object), DisplayString);
+    return DisplayString;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Extensions/LocalizationRegistry.h"
+
+// Core includes
+#include "Internationalization/StringTable.h"
+#include "Internationalization/StringTableRegistry.h"
+#include "Internationalization/TextLocalizationManager.h"
+#include "Misc/EngineVersionComparison.h"
+
+// NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
+
+DECLARE_CYCLE_STAT(TEXT("LocCultureSwitch"), STAT_NoesisLocCultureSwitch, STATGROUP_Noesis);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("LocCultureSwitch (ms)"), STAT_NoesisLocCultureSwitchMs, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("LocInvalidatedProperties"), STAT_NoesisLocInvalidatedProperties, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("LocKeys"), STAT_NoesisLocKeys, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("LocBindings"), STAT_NoesisLocBindings, STATGROUP_Noesis);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+FNoesisLocalizationRegistry& FNoesisLocalizationRegistry::Get()
+{
+    static FNoesisLocalizationRegistry Registry;
+    return Registry;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Noesis::Ptr<Noesis::BaseComponent> FNoesisLocalizationRegistry::Resolve(FNoesisLocBinding& Binding, const FNoesisLocKey& Key)
+{
+    int32 Index;
+    if (const int32* Found = GroupIndices.Find(Key))
+    {
+        Index = *Found;
+
+        // The string table may have been loaded since the key was first resolved
+        FGroup& Group = Groups[Index];
+        if (!Group.bFound)
+        {
+            FString DisplayString;
+            bool bFound = LookupString(Key, DisplayString);
+            UpdateValue(Group, MoveTemp(DisplayString), bFound);
+        }
+    }
+    else
+    {
+        Index = Groups.Add(FGroup());
+        FGroup& Group = Groups[Index];
+        Group.Key = Key;
+        FString DisplayString;
+        bool bFound = LookupString(Key, DisplayString);
+        UpdateValue(Group, MoveTemp(DisplayString), bFound);
+        GroupIndices.Add(Key, Index);
+
+        if (!TextRevisionChangedHandle.IsValid())
+        {
+            TextRevisionChangedHandle = FTextLocalizationManager::Get().OnTextRevisionChangedEvent.AddRaw(this,
+                &FNoesisLocalizationRegistry::OnTextRevisionChanged);
+        }
+    }
+
+    if (Binding.Group != Index)
+    {
+        Unbind(Binding);
+        Groups[Index].Bindings.Add(&Binding);
+        Binding.Group = Index;
+        NumBindings++;
+
+        SET_DWORD_STAT(STAT_NoesisLocKeys, Groups.Num());
+        SET_DWORD_STAT(STAT_NoesisLocBindings, NumBindings);
+    }
+
+    return Groups[Index].Value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisLocalizationRegistry::Unbind(FNoesisLocBinding& Binding)
+{
+    if (Binding.Group == INDEX_NONE)
+    {
+        return;
+    }
+
+    FGroup& Group = Groups[Binding.Group];
+    Group.Bindings.RemoveSingleSwap(&Binding, false);
+    NumBindings--;
+
+    if (Group.Bindings.Num() == 0)
+    {
+        GroupIndices.Remove(Group.Key);
+        Groups.RemoveAt(Binding.Group);
+
+        if (Groups.Num() == 0)
+        {
+            FTextLocalizationManager::Get().OnTextRevisionChangedEvent.Remove(TextRevisionChangedHandle);
+            TextRevisionChangedHandle.Reset();
+        }
+    }
+
+    Binding.Group = INDEX_NONE;
+
+    SET_DWORD_STAT(STAT_NoesisLocKeys, Groups.Num());
+    SET_DWORD_STAT(STAT_NoesisLocBindings, NumBindings);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool FNoesisLocalizationRegistry::LookupString(const FNoesisLocKey& Key, FString& OutDisplayString)
+{
+    switch (Key.Kind)
+    {
+        case ENoesisLocSource::StringTable:
+        {
+            FName TableId(*Key.Namespace);
+            OutDisplayString = FText::FromStringTable(TableId, Key.Key, EStringTableLoadingPolicy::FindOrLoad).ToString();
+            FStringTableConstPtr Table = FStringTableRegistry::Get().FindStringTable(TableId);
+            return Table.IsValid() && Table->FindEntry(Key.Key).IsValid();
+        }
+        case ENoesisLocSource::TextNamespace:
+        {
+            FText Text;
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+            bool bFound = FText::FindText(Key.Namespace, Key.Key, Text, &Key.Source);
+#else
+            bool bFound = FText::FindTextInLiveTable_Advanced(Key.Namespace, Key.Key, Text, &Key.Source);
+#endif
+            OutDisplayString = Text.ToString();
+            return bFound;
+        }
+    }
+
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisLocalizationRegistry::UpdateValue(FGroup& Group, FString&& DisplayString, bool bFound)
+{
+    Group.bFound = bFound;
+    if (!Group.Value || !DisplayString.Equals(Group.DisplayString, ESearchCase::CaseSensitive))
+    {
+        Group.Value = Noesis::Boxing::Box(TCHAR_TO_UTF8(*DisplayString));
+        Group.DisplayString = MoveTemp(DisplayString);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisLocalizationRegistry::OnTextRevisionChanged()
+{
+    SCOPE_CYCLE_COUNTER(STAT_NoesisLocCultureSwitch);
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Resolve every key first and invalidate afterwards, invalidating reevaluates expressions which
+    // can bind and unbind while the groups are being iterated
+    TArray<TPair<Noesis::Ptr<Noesis::DependencyObject>, const Noesis::DependencyProperty*>> Targets;
+    int32 NumChangedKeys = 0;
+    for (FGroup& Group : Groups)
+    {
+        FString DisplayString;
+        bool bFound = LookupString(Group.Key, DisplayString);
+        if (DisplayString.Equals(Group.DisplayString, ESearchCase::CaseSensitive))
+        {
+            Group.bFound = bFound;
+            continue;
+        }
+
+        UpdateValue(Group, MoveTemp(DisplayString), bFound);
+        NumChangedKeys++;
+
+        for (FNoesisLocBinding* Binding : Group.Bindings)
+        {
+            Targets.Emplace(Noesis::Ptr<Noesis::DependencyObject>(Binding->Object), Binding->Property);
+        }
+    }
+
+    for (auto& Target : Targets)
+    {
+        Target.Key->InvalidateProperty(Target.Value);
+    }
+
+    const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+    SET_FLOAT_STAT(STAT_NoesisLocCultureSwitchMs, ElapsedMs);
+    SET_DWORD_STAT(STAT_NoesisLocInvalidatedProperties, Targets.Num());
+    UE_LOG(LogNoesis, Verbose, TEXT("Localization revision changed: %d keys, %d changed, %d properties invalidated in %.3f ms"),
+        Groups.Num(), NumChangedKeys, Targets.Num(), ElapsedMs);
+}
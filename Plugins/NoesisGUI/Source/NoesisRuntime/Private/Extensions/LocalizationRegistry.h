@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Core includes
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+
+// Noesis includes
+#include "NoesisSDK.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class ENoesisLocSource : uint8
+{
+    StringTable,
+    TextNamespace
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Identifies a localized string: (table, key) for LocTable, (namespace, key, source) for LocText
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FNoesisLocKey
+{
+    ENoesisLocSource Kind;
+    FString Namespace;
+    FString Key;
+    FString Source;
+
+    bool operator==(const FNoesisLocKey& Other) const
+    {
+        return Kind == Other.Kind && Key == Other.Key && Namespace == Other.Namespace && Source == Other.Source;
+    }
+
+    friend uint32 GetTypeHash(const FNoesisLocKey& LocKey)
+    {
+        uint32 Hash = HashCombine(GetTypeHash(LocKey.Namespace), GetTypeHash(LocKey.Key));
+        return HashCombine(Hash, (uint32)LocKey.Kind);
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// A dependency property bound to a localized string, owned by a LocTable/LocText expression
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FNoesisLocBinding
+{
+    FNoesisLocBinding(Noesis::DependencyObject* InObject, const Noesis::DependencyProperty* InProperty)
+        : Object(InObject), Property(InProperty), Group(INDEX_NONE)
+    {
+    }
+
+    Noesis::DependencyObject* Object;
+    const Noesis::DependencyProperty* Property;
+    int32 Group;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Owns the only OnTextRevisionChangedEvent subscription used by localization extensions. Bindings
+/// are grouped by key, each key is resolved once and cached as a boxed UTF-8 string. On a culture
+/// change every key is resolved again and only the bindings whose string changed are invalidated.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class FNoesisLocalizationRegistry
+{
+public:
+    static FNoesisLocalizationRegistry& Get();
+
+    /// Moves the binding to the group of the given key and returns its cached string
+    Noesis::Ptr<Noesis::BaseComponent> Resolve(FNoesisLocBinding& Binding, const FNoesisLocKey& Key);
+
+    /// Must be called before the binding is destroyed
+    void Unbind(FNoesisLocBinding& Binding);
+
+    /// Looks up the current string of the key, returns false if it was not found
+    static bool LookupString(const FNoesisLocKey& Key, FString& OutDisplayString);
+
+private:
+    struct FGroup
+    {
+        FNoesisLocKey Key;
+        FString DisplayString;
+        Noesis::Ptr<Noesis::BaseComponent> Value;
+        TArray<FNoesisLocBinding*> Bindings;
+        bool bFound;
+    };
+
+    static void UpdateValue(FGroup& Group, FString&& DisplayString, bool bFound);
+
+    void OnTextRevisionChanged();
+
+    TSparseArray<FGroup> Groups;
+    TMap<FNoesisLocKey, int32> GroupIndices;
+    int32 NumBindings = 0;
+    FDelegateHandle TextRevisionChangedHandle;
+};
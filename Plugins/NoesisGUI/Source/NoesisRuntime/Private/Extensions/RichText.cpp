@@ -18,16 +18,95 @@
 #include "NsGui/UICollection.h"
 #include "NsGui/Uri.h"
 #include "NsGui/Style.h"
+#include "NsCore/Vector.h"
 
 #include <cctype>
+#include <cstring>
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 static RichText::TryCreateInlineCallback gTryCreateInline = nullptr;
+static bool gIncrementalParsing = true;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Remembers where each top-level Inline of a TextBlock came from in the markup, so that when new
+/// markup only appends to the previous one the existing Inlines can be kept and only the tail of
+/// the markup is parsed again.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class RichTextParseState final : public Noesis::BaseComponent
+{
+public:
+    struct Segment
+    {
+        uint32_t offset;
+        int inlineIndex;
+    };
+
+    void Reset()
+    {
+        segments.Clear();
+        length = 0;
+        inlineCount = 0;
+        complete = false;
+    }
+
+    void BeginSegment(const char* current, int inlineIndex)
+    {
+        segments.PushBack({ (uint32_t)(current - markup), inlineIndex });
+    }
+
+    /// Returns the offset to resume parsing from when oldText is replaced by text, removing the
+    /// Inlines that will be created again. Returns false if the whole markup must be parsed.
+    bool TryResume(const Noesis::String& oldText, const Noesis::String& text,
+        Noesis::InlineCollection* inlineCollection, uint32_t& offset)
+    {
+        const uint32_t oldSize = oldText.Size();
+        if (!complete || segments.Empty() || length != oldSize || text.Size() <= oldSize
+            || inlineCollection->Count() != inlineCount
+            || memcmp(text.Begin(), oldText.Begin(), oldSize) != 0)
+        {
+            return false;
+        }
+
+        // The last segment is always parsed again because appended text can extend it (a Run
+        // or an unterminated tag). A segment that ended within one char of the old end may have
+        // been cut short by it, so the segment before it is parsed again too.
+        while (!segments.Empty() && segments.Back().offset + 2 > oldSize)
+        {
+            segments.PopBack();
+        }
+        if (segments.Empty())
+        {
+            return false;
+        }
+
+        const Segment resume = segments.Back();
+        segments.PopBack();
+
+        for (int i = inlineCollection->Count() - 1; i >= resume.inlineIndex; i--)
+        {
+            inlineCollection->RemoveAt(i);
+        }
+
+        offset = resume.offset;
+        return true;
+    }
+
+    Noesis::Vector<Segment> segments;
+    const char* markup = nullptr;
+    uint32_t length = 0;
+    int inlineCount = 0;
+    bool complete = false;
+
+    NS_IMPLEMENT_INLINE_REFLECTION_(RichTextParseState, Noesis::BaseComponent)
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 static const char* TryParse(const char* begin, const char* end, const Noesis::TextBlock* parent, 
-    Noesis::InlineCollection* inlineCollection);
+    Noesis::InlineCollection* inlineCollection, RichTextParseState* state = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static const Noesis::DependencyProperty* ParseStateProperty;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /// This method allows for the creation of Spans for RichText tags which act as containers for other
@@ -392,17 +471,26 @@ static const char* ParseTag(const char* begin, const char* end, const Noesis::Te
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 static const char* TryParse(const char* begin, const char* end, const Noesis::TextBlock *parent, 
-    Noesis::InlineCollection* inlineCollection)
+    Noesis::InlineCollection* inlineCollection, RichTextParseState* state)
 {
     const char* current = begin;
 
     while (current != end)
     {
+        if (state != nullptr)
+        {
+            state->BeginSegment(current, inlineCollection->Count());
+        }
+
         if (*current == '<')
         {
             const char* next = current + 1;
             if (next != end && *next == '/')
             {
+                if (state != nullptr)
+                {
+                    state->complete = false;
+                }
                 return next;
             }
             current = ParseTag(current, end, parent, inlineCollection);
@@ -419,16 +507,38 @@ static const char* TryParse(const char* begin, const char* end, const Noesis::Te
 static void OnSourceChanged(Noesis::DependencyObject* obj,
     const Noesis::DependencyPropertyChangedEventArgs& args)
 {
-    const Noesis::TextBlock* textBlock = Noesis::DynamicCast<Noesis::TextBlock*>(obj);
+    Noesis::TextBlock* textBlock = Noesis::DynamicCast<Noesis::TextBlock*>(obj);
     if (textBlock)
     {
         Noesis::InlineCollection* inlineCollection = textBlock->GetInlines();
 
-        inlineCollection->Clear();
-
+        const Noesis::String& oldText = args.OldValue<Noesis::String>();
         const Noesis::String& text = args.NewValue<Noesis::String>();
 
-        TryParse(text.Begin(), text.End(), textBlock, inlineCollection);
+        RichTextParseState* state = Noesis::DynamicCast<RichTextParseState*>(
+            textBlock->GetValue<Noesis::Ptr<Noesis::BaseComponent>>(ParseStateProperty).GetPtr());
+
+        uint32_t offset = 0;
+        if (state == nullptr || !gIncrementalParsing
+            || !state->TryResume(oldText, text, inlineCollection, offset))
+        {
+            inlineCollection->Clear();
+
+            if (state == nullptr)
+            {
+                Noesis::Ptr<RichTextParseState> newState = Noesis::MakePtr<RichTextParseState>();
+                textBlock->SetValue<Noesis::Ptr<Noesis::BaseComponent>>(ParseStateProperty, newState);
+                state = newState;
+            }
+            state->Reset();
+        }
+
+        state->markup = text.Begin();
+        state->complete = true;
+        TryParse(text.Begin() + offset, text.End(), textBlock, inlineCollection, state);
+        state->markup = nullptr;
+        state->length = text.Size();
+        state->inlineCount = inlineCollection->Count();
     }
 }
 
@@ -438,6 +548,20 @@ void RichText::SetTryCreateInlineCallback(TryCreateInlineCallback callback)
     gTryCreateInline = callback;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void RichText::SetIncrementalParsing(bool enable)
+{
+    gIncrementalParsing = enable;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void RichText::AppendText(Noesis::TextBlock* textBlock, const char* markup)
+{
+    Noesis::String text(textBlock->GetValue<Noesis::String>(TextProperty));
+    text.Append(markup);
+    textBlock->SetValue<Noesis::String>(TextProperty, text);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 NS_BEGIN_COLD_REGION
 
@@ -446,6 +570,8 @@ NS_IMPLEMENT_REFLECTION(RichText, "NoesisGUIExtensions.RichText")
     Noesis::UIElementData* data = NsMeta<Noesis::UIElementData>(Noesis::TypeOf<SelfClass>());
     data->RegisterProperty<Noesis::String>(TextProperty, "Text", Noesis::PropertyMetadata::Create(
         Noesis::String(), Noesis::PropertyChangedCallback(OnSourceChanged)));
+    data->RegisterProperty<Noesis::Ptr<Noesis::BaseComponent>>(ParseStateProperty, "ParseState",
+        Noesis::PropertyMetadata::Create(Noesis::Ptr<Noesis::BaseComponent>()));
 }
 
 NS_END_COLD_REGION
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Extensions/RichText.h"
+
+// Core includes
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+// NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
+
+// Noesis includes
+#include "NsGui/ResourceDictionary.h"
+#include "NsGui/Span.h"
+#include "NsGui/Style.h"
+#include "NsGui/TextBlock.h"
+#include "NsGui/UICollection.h"
+
+#if !UE_BUILD_SHIPPING
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static Noesis::Ptr<Noesis::TextBlock> CreateBenchmarkTextBlock()
+{
+    Noesis::Ptr<Noesis::TextBlock> TextBlock = Noesis::MakePtr<Noesis::TextBlock>();
+    Noesis::Ptr<Noesis::ResourceDictionary> Resources = Noesis::MakePtr<Noesis::ResourceDictionary>();
+    Noesis::Ptr<Noesis::Style> Style = Noesis::MakePtr<Noesis::Style>();
+    Style->SetTargetType(Noesis::TypeOf<Noesis::Span>());
+    Resources->Add("B", Style);
+    TextBlock->SetResources(Resources);
+    return TextBlock;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void BuildBenchmarkLine(int32 Index, Noesis::BaseString& Line)
+{
+    Line.Clear();
+    Line.AppendFormat("<B>[%02d:%02d]</> Player%d hits \\<Target\\> for <B>%d</> damage\n", (Index / 60) % 60,
+        Index % 60, Index % 16, Index * 7 % 1000);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Appends lines one by one until the markup reaches SizeBytes, returns the elapsed seconds
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static double RunAppendBenchmark(int32 SizeBytes, bool bIncremental, int32& OutLines)
+{
+    Noesis::Ptr<Noesis::TextBlock> TextBlock = CreateBenchmarkTextBlock();
+    Noesis::FixedString<128> Line;
+
+    RichText::SetIncrementalParsing(bIncremental);
+    const double StartTime = FPlatformTime::Seconds();
+    OutLines = 0;
+    while ((int32)TextBlock->GetValue<Noesis::String>(RichText::TextProperty).Size() < SizeBytes)
+    {
+        BuildBenchmarkLine(OutLines++, Line);
+        RichText::AppendText(TextBlock, Line.Str());
+    }
+    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+    RichText::SetIncrementalParsing(true);
+
+    return Elapsed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void RichTextBenchmark(const TArray<FString>& Args)
+{
+    const int32 SizeKB = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 16;
+    const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+    const int32 SizeBytes = SizeKB * 1024;
+
+    Noesis::String Markup;
+    Noesis::FixedString<128> Line;
+    for (int32 Index = 0; (int32)Markup.Size() < SizeBytes; Index++)
+    {
+        BuildBenchmarkLine(Index, Line);
+        Markup.Append(Line);
+    }
+
+    // Full parse of multi-KB markup
+    Noesis::Ptr<Noesis::TextBlock> TextBlock = CreateBenchmarkTextBlock();
+    double ParseTime = 0.0;
+    for (int32 i = 0; i < Iterations; i++)
+    {
+        TextBlock->SetValue<Noesis::String>(RichText::TextProperty, Noesis::String());
+        const double StartTime = FPlatformTime::Seconds();
+        TextBlock->SetValue<Noesis::String>(RichText::TextProperty, Markup);
+        ParseTime += FPlatformTime::Seconds() - StartTime;
+    }
+    const double TotalMB = (double)Markup.Size() * Iterations / (1024.0 * 1024.0);
+    UE_LOG(LogNoesis, Display, TEXT("RichText full parse: %d bytes x %d, %d inlines, %.3f ms per parse, %.2f MB/s"),
+        Markup.Size(), Iterations, TextBlock->GetInlines()->Count(), ParseTime * 1000.0 / Iterations,
+        ParseTime > 0.0 ? TotalMB / ParseTime : 0.0);
+
+    // Streaming append, every line reparses the whole markup unless parsing is incremental
+    int32 Lines = 0;
+    const double FullTime = RunAppendBenchmark(SizeBytes, false, Lines);
+    const double IncrementalTime = RunAppendBenchmark(SizeBytes, true, Lines);
+    UE_LOG(LogNoesis, Display, TEXT("RichText append %d lines up to %d KB: full reparse %.2f ms, incremental %.2f ms (%.1fx)"),
+        Lines, SizeKB, FullTime * 1000.0, IncrementalTime * 1000.0,
+        IncrementalTime > 0.0 ? FullTime / IncrementalTime : 0.0);
+}
+
+static FAutoConsoleCommand RichTextBenchmarkCommand(TEXT("Noesis.RichTextBenchmark"),
+    TEXT("Measures RichText parse throughput. Usage: Noesis.RichTextBenchmark [SizeKB=16] [Iterations=20]"),
+    FConsoleCommandWithArgsDelegate::CreateStatic(&RichTextBenchmark));
+
+#endif
@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NoesisInputRouter.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FNoesisInputRouter::AddHandler(const FNoesisInputRouteKey& Key, const void* Owner, FSimpleDelegate Handler, bool& OutNeedsBinding)
+{
+	int32 RouteId;
+	if (const int32* Found = RouteIds.Find(Key))
+	{
+		RouteId = *Found;
+	}
+	else
+	{
+		RouteId = Routes.AddDefaulted();
+		Routes[RouteId].Key = Key;
+		RouteIds.Add(Key, RouteId);
+	}
+
+	FRoute& Route = Routes[RouteId];
+	OutNeedsBinding = Route.Handlers.Num() == 0;
+	Route.Handlers.Add({ Owner, MoveTemp(Handler) });
+	NumTotalHandlers++;
+
+	return RouteId;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+int32 FNoesisInputRouter::RemoveHandler(const FNoesisInputRouteKey& Key, const void* Owner)
+{
+	const int32* Found = RouteIds.Find(Key);
+	if (Found == nullptr)
+		return INDEX_NONE;
+
+	FRoute& Route = Routes[*Found];
+	int32 Index = Route.Handlers.IndexOfByPredicate([Owner](const FHandler& Handler) { return Handler.Owner == Owner; });
+	if (Index == INDEX_NONE)
+		return INDEX_NONE;
+
+	// Keep registration order, it is the order handlers are invoked
+	Route.Handlers.RemoveAt(Index, 1, false);
+	NumTotalHandlers--;
+
+	if (Route.Handlers.Num() == 0)
+	{
+		int32 BindingHandle = Route.BindingHandle;
+		Route.BindingHandle = INDEX_NONE;
+		return BindingHandle;
+	}
+
+	return INDEX_NONE;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisInputRouter::SetBindingHandle(int32 RouteId, int32 BindingHandle)
+{
+	Routes[RouteId].BindingHandle = BindingHandle;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisInputRouter::Dispatch(int32 RouteId) const
+{
+	if (!Routes.IsValidIndex(RouteId))
+		return;
+
+	// Handlers can add or remove triggers, for example invoking actions that unload elements. The
+	// handlers registered when the action fired are invoked from a copy, skipping the ones removed
+	// by a previous handler, and the route is looked up again every time in case it was reset
+	TArray<FHandler, TInlineAllocator<4>> Handlers(Routes[RouteId].Handlers);
+	for (const FHandler& Handler : Handlers)
+	{
+		if (!Routes.IsValidIndex(RouteId))
+			return;
+
+		const void* Owner = Handler.Owner;
+		if (Routes[RouteId].Handlers.ContainsByPredicate([Owner](const FHandler& Other) { return Other.Owner == Owner; }))
+		{
+			Handler.Delegate.ExecuteIfBound();
+		}
+	}
+}
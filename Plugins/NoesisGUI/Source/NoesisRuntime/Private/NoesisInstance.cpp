@@ -72,6 +72,7 @@
 #include "NoesisRuntimeModule.h"
 #include "NoesisBlueprintGeneratedClass.h"
 #include "Render/NoesisRenderDevice.h"
+#include "Render/NoesisRenderStats.h"
 #include "NoesisTypeClass.h"
 #include "NoesisXaml.h"
 #include "NoesisSupport.h"
@@ -107,6 +108,9 @@ DECLARE_CYCLE_STAT(TEXT("TouchMove"), STAT_NoesisInstance_OnTouchMoved, STATGROU
 DECLARE_CYCLE_STAT(TEXT("TouchUp"), STAT_NoesisInstance_OnTouchEnded, STATGROUP_Noesis);
 DECLARE_CYCLE_STAT(TEXT("MouseDoubleClick"), STAT_NoesisInstance_OnMouseButtonDoubleClick, STATGROUP_Noesis);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("RenderUpdates"), STAT_NoesisInstance_RenderUpdates, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RenderUpdateBatches"), STAT_NoesisInstance_RenderUpdateBatches, STATGROUP_Noesis);
+
 DECLARE_GPU_STAT_NAMED(NoesisOnscreen, TEXT("NoesisOnscreen"));
 DECLARE_GPU_STAT_NAMED(NoesisOffscreen, TEXT("NoesisOffscreen"));
 
@@ -178,6 +182,7 @@ public:
 	void RenderView(FRHICommandList& RHICmdList, const FViewInfo* View);
 
 	Noesis::Ptr<Noesis::IRenderer> Renderer;
+	TUniquePtr<FNoesisRenderStats> RenderStats;
 
 	float Left;
 	float Top;
@@ -203,10 +208,193 @@ FNoesisSlateElement::FNoesisSlateElement(Noesis::Ptr<Noesis::IRenderer> InRender
 {
 }
 
+// Render thread state an instance produces every tick. Instead of each instance enqueuing its own render
+// commands, the updates of all instances are collected in a frame packet and applied in one go on the
+// render thread, right before the world UI or the first Noesis Slate element of that frame is drawn.
+// Frames that draw none of them still drain the packet when the render thread ends the frame. Only the
+// newest update of each element in a frame is kept, and the scene of a world being cleaned up is cleared
+// from it.
+struct FNoesisRenderUpdate
+{
+	TSharedPtr<FNoesisSlateElement, ESPMode::ThreadSafe> NoesisSlateElement;
+	uint64 FrameNumber = 0;
+	FSceneInterface* Scene = nullptr;
+	FGameTime WorldTime;
+	bool HasSlateRect = false;
+	FSlateRect SlateRect;
+	FSlateRect CullingRect;
+	float EngineGamma = 2.2f;
+	float SlateContrast = 1.0f;
+	bool HasViewProjectionMatrix = false;
+	FMatrix ViewProjectionMatrix;
+};
+
+static FCriticalSection GNoesisRenderUpdatesLock;
+// Filled by the game thread, in frame order
+static TArray<FNoesisRenderUpdate> GNoesisRenderUpdates;
+// Index in GNoesisRenderUpdates of the newest pending update of each element
+static TMap<const FNoesisSlateElement*, int32> GNoesisRenderUpdateIndices;
+// Only accessed from the render thread, keeps its allocation between frames
+static TArray<FNoesisRenderUpdate> GNoesisRenderUpdatesRenderThread;
+static FDelegateHandle GNoesisEndFrameRTHandle;
+static FDelegateHandle GNoesisWorldCleanupHandle;
+
+static void NoesisQueueRenderUpdate(FNoesisRenderUpdate&& Update)
+{
+	check(IsInGameThread());
+	INC_DWORD_STAT(STAT_NoesisInstance_RenderUpdates);
+	Update.FrameNumber = GFrameCounter;
+
+	FScopeLock Lock(&GNoesisRenderUpdatesLock);
+	int32* PendingIndex = GNoesisRenderUpdateIndices.Find(Update.NoesisSlateElement.Get());
+
+	// An update of an earlier frame is left alone, the render thread only drains the frames it has reached
+	// and moving it to this frame would postpone it again every tick
+	if (PendingIndex == nullptr || GNoesisRenderUpdates[*PendingIndex].FrameNumber != Update.FrameNumber)
+	{
+		GNoesisRenderUpdateIndices.Add(Update.NoesisSlateElement.Get(), GNoesisRenderUpdates.Num());
+		GNoesisRenderUpdates.Add(MoveTemp(Update));
+		return;
+	}
+
+	// Merge into the pending update of this frame, keeping the parts the new one doesn't carry. Updates of
+	// the same frame are contiguous, so replacing it in place keeps the packet in frame order
+	FNoesisRenderUpdate& Pending = GNoesisRenderUpdates[*PendingIndex];
+	if (!Update.HasSlateRect && Pending.HasSlateRect)
+	{
+		Update.HasSlateRect = true;
+		Update.SlateRect = Pending.SlateRect;
+		Update.CullingRect = Pending.CullingRect;
+		Update.EngineGamma = Pending.EngineGamma;
+		Update.SlateContrast = Pending.SlateContrast;
+	}
+	if (!Update.HasViewProjectionMatrix && Pending.HasViewProjectionMatrix)
+	{
+		Update.HasViewProjectionMatrix = true;
+		Update.ViewProjectionMatrix = Pending.ViewProjectionMatrix;
+	}
+	Pending = MoveTemp(Update);
+}
+
+static void NoesisOnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	// The scene is destroyed after the world, pending updates must not hand it to the render thread
+	FSceneInterface* Scene = World != nullptr ? World->Scene : nullptr;
+	if (Scene == nullptr)
+	{
+		return;
+	}
+
+	FScopeLock Lock(&GNoesisRenderUpdatesLock);
+	for (FNoesisRenderUpdate& Update : GNoesisRenderUpdates)
+	{
+		if (Update.Scene == Scene)
+		{
+			Update.Scene = nullptr;
+		}
+	}
+}
+
+static void NoesisApplyRenderUpdates(FRHICommandListImmediate& RHICmdList, uint64 FrameNumber)
+{
+	check(IsInRenderingThread());
+	check(GNoesisRenderUpdatesRenderThread.Num() == 0);
+
+	{
+		FScopeLock Lock(&GNoesisRenderUpdatesLock);
+
+		// The game thread may already be producing the updates of the next frame
+		int32 Count = 0;
+		while (Count < GNoesisRenderUpdates.Num() && GNoesisRenderUpdates[Count].FrameNumber <= FrameNumber)
+		{
+			++Count;
+		}
+
+		if (Count == 0)
+		{
+			return;
+		}
+
+		if (Count == GNoesisRenderUpdates.Num())
+		{
+			Swap(GNoesisRenderUpdates, GNoesisRenderUpdatesRenderThread);
+			GNoesisRenderUpdateIndices.Reset();
+		}
+		else
+		{
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				GNoesisRenderUpdateIndices.Remove(GNoesisRenderUpdates[Index].NoesisSlateElement.Get());
+				GNoesisRenderUpdatesRenderThread.Add(MoveTemp(GNoesisRenderUpdates[Index]));
+			}
+			GNoesisRenderUpdates.RemoveAt(0, Count, false);
+			// An element can still have updates of several frames pending, the newest one is indexed
+			for (int32 Index = 0; Index < GNoesisRenderUpdates.Num(); ++Index)
+			{
+				GNoesisRenderUpdateIndices.Add(GNoesisRenderUpdates[Index].NoesisSlateElement.Get(), Index);
+			}
+		}
+	}
+
+	INC_DWORD_STAT(STAT_NoesisInstance_RenderUpdateBatches);
+	for (FNoesisRenderUpdate& Update : GNoesisRenderUpdatesRenderThread)
+	{
+		FNoesisSlateElement* NoesisSlateElement = Update.NoesisSlateElement.Get();
+		if (Update.HasViewProjectionMatrix)
+		{
+			NoesisSlateElement->ViewProjectionMatrix = Update.ViewProjectionMatrix;
+		}
+		if (Update.HasSlateRect)
+		{
+			NoesisSlateElement->EngineGamma = Update.EngineGamma;
+			NoesisSlateElement->SlateContrast = Update.SlateContrast;
+
+			NoesisSlateElement->Left = Update.SlateRect.Left;
+			NoesisSlateElement->Top = Update.SlateRect.Top;
+			NoesisSlateElement->Right = Update.SlateRect.Right;
+			NoesisSlateElement->Bottom = Update.SlateRect.Bottom;
+
+			NoesisSlateElement->CullingRect = Update.CullingRect;
+
+			NoesisSlateElement->IsMobileMultiView = false;
+		}
+		NoesisSlateElement->Scene = Update.Scene;
+		NoesisSlateElement->WorldTime = Update.WorldTime;
+		NoesisSlateElement->UpdateRenderTree();
+		NoesisSlateElement->RenderOffscreen(RHICmdList);
+	}
+
+	// Elements of instances destroyed in the meantime are released here, on the render thread
+	GNoesisRenderUpdatesRenderThread.Reset();
+}
+
+static void NoesisApplyRenderUpdates(FRHICommandListImmediate& RHICmdList)
+{
+	NoesisApplyRenderUpdates(RHICmdList, GFrameCounterRenderThread);
+}
+
+static void NoesisOnEndFrameRT()
+{
+	// Nothing may have drawn Noesis this frame, apply the updates anyway so the queue doesn't grow
+	NoesisApplyRenderUpdates(FRHICommandListExecutor::GetImmediateCommandList());
+}
+
+static void NoesisAddApplyRenderUpdatesPass(FRDGBuilder& GraphBuilder)
+{
+	GraphBuilder.AddPass(RDG_EVENT_NAME("NoesisRenderUpdates"), ERDGPassFlags::NeverCull,
+		[](FRHICommandListImmediate& RHICmdList)
+		{
+			NoesisApplyRenderUpdates(RHICmdList);
+		}
+	);
+}
+
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
 
 void FNoesisSlateElement::DrawRenderThread(FRHICommandListImmediate& RHICmdList, const void* InWindowBackBuffer)
 {
+	NoesisApplyRenderUpdates(RHICmdList);
+
 	ViewRect = GViewRect;
 	ViewProjectionMatrix = GViewProjectionMatrix;
 
@@ -261,6 +449,8 @@ void FNoesisSlateElement::DrawRenderThread(FRHICommandListImmediate& RHICmdList,
 
 void FNoesisSlateElement::Draw_RenderThread(FRDGBuilder& GraphBuilder, const FDrawPassInputs& Inputs)
 {
+	NoesisAddApplyRenderUpdatesPass(GraphBuilder);
+
 	const FRDGTextureDesc& ColorTargetDesc = Inputs.OutputTexture != nullptr ? Inputs.OutputTexture->Desc : FRDGTextureDesc();
 
 	ViewRect = GViewRect;
@@ -341,7 +531,17 @@ void FNoesisSlateElement::RenderOffscreen(FRHICommandList& RHICmdList) const
 	RenderDevice->SetScene(Scene);
 	RenderDevice->SetRHICmdList(&RHICmdList);
 	RenderDevice->SetGammaAndContrast(2.2f, 1.0f);
+	RenderDevice->SetRenderStats(RenderStats.Get());
+	if (RenderStats)
+	{
+		RenderStats->BeginScope(RHICmdList);
+	}
 	Renderer->RenderOffscreen();
+	if (RenderStats)
+	{
+		RenderStats->EndScope(RHICmdList);
+	}
+	RenderDevice->SetRenderStats(nullptr);
 	RenderDevice->SetRHICmdList(nullptr);
 }
 
@@ -361,6 +561,11 @@ void FNoesisSlateElement::RenderOnscreen(FRHICommandList& RHICmdList, bool WithV
 	RenderDevice->SetScene(Scene);
 	RenderDevice->SetRHICmdList(&RHICmdList);
 	RenderDevice->SetGammaAndContrast(EngineGamma, SlateContrast);
+	RenderDevice->SetRenderStats(RenderStats.Get());
+	if (RenderStats)
+	{
+		RenderStats->BeginScope(RHICmdList);
+	}
 	Renderer->SetRenderRegion(0.f, 0.f, Right - Left, Bottom - Top);
 	if (WithViewProj)
 	{
@@ -377,6 +582,11 @@ void FNoesisSlateElement::RenderOnscreen(FRHICommandList& RHICmdList, bool WithV
 	{
 		Renderer->Render();
 	}
+	if (RenderStats)
+	{
+		RenderStats->EndScope(RHICmdList);
+	}
+	RenderDevice->SetRenderStats(nullptr);
 	RenderDevice->DestroyView();
 	RenderDevice->SetRHICmdList(nullptr);
 }
@@ -644,6 +854,9 @@ void UNoesisInstance::InitInstance()
 			Noesis::Ptr<Noesis::IRenderer> Renderer(XamlView->GetRenderer());
 
 			NoesisSlateElement = MakeShared<FNoesisSlateElement, ESPMode::ThreadSafe>(Renderer);
+#if !UE_BUILD_SHIPPING
+			NoesisSlateElement->RenderStats = MakeUnique<FNoesisRenderStats>(FString::Printf(TEXT("%s (%s)"), *GetName(), *BaseXaml->GetName()));
+#endif
 
 			ENQUEUE_RENDER_COMMAND(FNoesisInstance_InitRenderer)
 			(
@@ -822,6 +1035,102 @@ void UNoesisInstance::UnregisterInputAction(FInputActionBinding Binding)
 	StopListeningForInputAction(Binding.GetActionName(), Binding.KeyEvent);
 }
 
+void UNoesisInstance::AddInputActionHandler(FName ActionName, EInputEvent KeyEvent, const void* Owner, FSimpleDelegate Handler)
+{
+	UInputComponent* ThisInputComponent = GetInputComponent();
+	if (ThisInputComponent == nullptr)
+		return;
+
+	FNoesisInputRouteKey Key;
+	Key.ActionName = ActionName;
+	Key.Event = (uint8)KeyEvent;
+
+	bool NeedsBinding;
+	int32 RouteId = InputRouter.AddHandler(Key, Owner, MoveTemp(Handler), NeedsBinding);
+	if (NeedsBinding)
+	{
+		FInputActionBinding Binding(ActionName, KeyEvent);
+		Binding.ActionDelegate.GetDelegateForManualSet().BindUObject(this, &UNoesisInstance::OnRoutedInputAction, RouteId);
+		InputRouter.SetBindingHandle(RouteId, ThisInputComponent->AddActionBinding(Binding).GetHandle());
+	}
+}
+
+void UNoesisInstance::RemoveInputActionHandler(FName ActionName, EInputEvent KeyEvent, const void* Owner)
+{
+	FNoesisInputRouteKey Key;
+	Key.ActionName = ActionName;
+	Key.Event = (uint8)KeyEvent;
+
+	int32 BindingHandle = InputRouter.RemoveHandler(Key, Owner);
+	if (BindingHandle != INDEX_NONE && InputComponent != nullptr)
+	{
+		InputComponent->RemoveActionBindingForHandle(BindingHandle);
+	}
+}
+
+#if WITH_ENHANCED_INPUT
+void UNoesisInstance::AddEnhancedInputActionHandler(const UInputAction* Action, ETriggerEvent TriggerEvent, const void* Owner, FSimpleDelegate Handler)
+{
+	UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(GetInputComponent());
+	if (EnhancedInputComponent == nullptr)
+		return;
+
+	FNoesisInputRouteKey Key;
+	Key.Action = Action;
+	Key.Event = (uint8)TriggerEvent;
+
+	bool NeedsBinding;
+	int32 RouteId = InputRouter.AddHandler(Key, Owner, MoveTemp(Handler), NeedsBinding);
+	if (NeedsBinding)
+	{
+		uint32 BindingHandle = EnhancedInputComponent->BindAction(Action, TriggerEvent, this, &UNoesisInstance::OnRoutedInputAction, RouteId).GetHandle();
+		InputRouter.SetBindingHandle(RouteId, (int32)BindingHandle);
+	}
+}
+
+void UNoesisInstance::RemoveEnhancedInputActionHandler(const UInputAction* Action, ETriggerEvent TriggerEvent, const void* Owner)
+{
+	FNoesisInputRouteKey Key;
+	Key.Action = Action;
+	Key.Event = (uint8)TriggerEvent;
+
+	int32 BindingHandle = InputRouter.RemoveHandler(Key, Owner);
+	if (BindingHandle != INDEX_NONE)
+	{
+		if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(InputComponent))
+		{
+			EnhancedInputComponent->RemoveBindingByHandle((uint32)BindingHandle);
+		}
+	}
+}
+#endif
+
+void UNoesisInstance::OnRoutedInputAction(int32 RouteId)
+{
+	InputRouter.Dispatch(RouteId);
+}
+
+void UNoesisInstance::ResetInputRoutes()
+{
+	InputRouter.Reset([this](const FNoesisInputRouteKey& Key, int32 BindingHandle)
+	{
+		if (InputComponent == nullptr)
+			return;
+
+#if WITH_ENHANCED_INPUT
+		if (Key.Action != nullptr)
+		{
+			if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(InputComponent))
+			{
+				EnhancedInputComponent->RemoveBindingByHandle((uint32)BindingHandle);
+			}
+			return;
+		}
+#endif
+		InputComponent->RemoveActionBindingForHandle(BindingHandle);
+	});
+}
+
 #if WITH_ENHANCED_INPUT
 void UNoesisInstance::OnEnhancedInputActionTriggered(Noesis::Key Key)
 {
@@ -1008,6 +1317,8 @@ void UNoesisInstance::Tick3DWidget(UWorld* World, ELevelTick TickType, float Del
 
 	if (XamlView != nullptr)
 	{
+		FNoesisRenderUpdate RenderUpdate;
+
 		APlayerController* PlayerController = GetOwningPlayer();
 		if (PlayerController)
 		{
@@ -1046,26 +1357,17 @@ void UNoesisInstance::Tick3DWidget(UWorld* World, ELevelTick TickType, float Del
 
 						Noesis::Matrix4 ViewProj = UnrealToNoesisViewProj(ViewProjForCulling, Width, Height);
 
-						ENQUEUE_RENDER_COMMAND(CopyViewProj)
-						(
-							[NoesisSlateElement = NoesisSlateElement, ViewProjectionMatrix = ViewProjForCulling](FRHICommandListImmediate& RHICmdList) mutable
-							{
-								NoesisSlateElement->ViewProjectionMatrix = ViewProjectionMatrix;
-							}
-						);
+						RenderUpdate.HasViewProjectionMatrix = true;
+						RenderUpdate.ViewProjectionMatrix = ViewProjForCulling;
 						XamlView->SetProjectionMatrix(ViewProj);
 								}
 					else
 					{
-						Noesis::Matrix4 ViewProj = UnrealToNoesisViewProj(ViewProjectionData.ComputeViewProjectionMatrix(), Width, Height);
+						FMatrix ViewProjectionMatrix = ViewProjectionData.ComputeViewProjectionMatrix();
+						Noesis::Matrix4 ViewProj = UnrealToNoesisViewProj(ViewProjectionMatrix, Width, Height);
 
-						ENQUEUE_RENDER_COMMAND(CopyViewProj)
-						(
-							[NoesisSlateElement = NoesisSlateElement, ViewProjectionMatrix = ViewProjectionData.ComputeViewProjectionMatrix()](FRHICommandListImmediate& RHICmdList) mutable
-							{
-								NoesisSlateElement->ViewProjectionMatrix = ViewProjectionMatrix;
-							}
-						);
+						RenderUpdate.HasViewProjectionMatrix = true;
+						RenderUpdate.ViewProjectionMatrix = ViewProjectionMatrix;
 						XamlView->SetProjectionMatrix(ViewProj);
 					}
 				}
@@ -1074,16 +1376,10 @@ void UNoesisInstance::Tick3DWidget(UWorld* World, ELevelTick TickType, float Del
 
 		Update();
 
-		ENQUEUE_RENDER_COMMAND(FNoesisInstance_Tick3DWidget_UpdateSlateElement)
-		(
-			[NoesisSlateElement = NoesisSlateElement, Scene = Scene, WorldTime = WorldTime](FRHICommandListImmediate& RHICmdList)
-			{
-				NoesisSlateElement->Scene = Scene;
-				NoesisSlateElement->WorldTime = WorldTime;
-				NoesisSlateElement->UpdateRenderTree();
-				NoesisSlateElement->RenderOffscreen(RHICmdList);
-			}
-		);
+		RenderUpdate.NoesisSlateElement = NoesisSlateElement;
+		RenderUpdate.Scene = Scene;
+		RenderUpdate.WorldTime = WorldTime;
+		NoesisQueueRenderUpdate(MoveTemp(RenderUpdate));
 	}
 }
 
@@ -1270,6 +1566,8 @@ void UNoesisInstance::TermInstance()
 {
 	if (XamlView)
 	{
+		ResetInputRoutes();
+
 #if WITH_ENHANCED_INPUT
 		auto ThisInputComponent = GetInputComponent();
 
@@ -1532,29 +1830,16 @@ int32 UNoesisInstance::NativePaint(const FPaintArgs& Args, const FGeometry& Allo
 
 	if (XamlView != nullptr)
 	{
-		ENQUEUE_RENDER_COMMAND(FNoesisInstance_NativePaint_UpdateSlateElement)
-		(
-			[NoesisSlateElement = NoesisSlateElement, EngineGamma = GEngine ? GEngine->GetDisplayGamma() : 2.2f, SlateContrast = GSlateContrast,
-			SlateRect = AllottedGeometry.GetLayoutBoundingRect().Round(),
-			Scene = Scene, WorldTime = WorldTime, CullingRect = MyCullingRect.Round()](FRHICommandListImmediate& RHICmdList)
-			{
-				NoesisSlateElement->EngineGamma = EngineGamma;
-				NoesisSlateElement->SlateContrast = SlateContrast;
-
-				NoesisSlateElement->Left = SlateRect.Left;
-				NoesisSlateElement->Top = SlateRect.Top;
-				NoesisSlateElement->Right = SlateRect.Right;
-				NoesisSlateElement->Bottom = SlateRect.Bottom;
-
-				NoesisSlateElement->CullingRect = CullingRect;
-
-				NoesisSlateElement->Scene = Scene;
-				NoesisSlateElement->IsMobileMultiView = false;
-				NoesisSlateElement->WorldTime = WorldTime;
-				NoesisSlateElement->UpdateRenderTree();
-				NoesisSlateElement->RenderOffscreen(RHICmdList);
-			}
-		);
+		FNoesisRenderUpdate RenderUpdate;
+		RenderUpdate.NoesisSlateElement = NoesisSlateElement;
+		RenderUpdate.HasSlateRect = true;
+		RenderUpdate.EngineGamma = GEngine ? GEngine->GetDisplayGamma() : 2.2f;
+		RenderUpdate.SlateContrast = GSlateContrast;
+		RenderUpdate.SlateRect = AllottedGeometry.GetLayoutBoundingRect().Round();
+		RenderUpdate.CullingRect = MyCullingRect.Round();
+		RenderUpdate.Scene = Scene;
+		RenderUpdate.WorldTime = WorldTime;
+		NoesisQueueRenderUpdate(MoveTemp(RenderUpdate));
 
 		FSlateDrawElement::MakeCustom(OutDrawElements, LayerId, NoesisSlateElement);
 
@@ -2245,6 +2530,8 @@ public:
 
 	virtual void PreRenderViewFamily_RenderThread(FRDGBuilder& GraphBuilder, FSceneViewFamily& InViewFamily) override
 	{
+		// World UI instances ticked this frame must be up to date before the scene renders them
+		NoesisAddApplyRenderUpdatesPass(GraphBuilder);
 	}
 
 	virtual void PreRenderView_RenderThread(FRDGBuilder& GraphBuilder, FSceneView& InView) override
@@ -2390,11 +2677,24 @@ TSharedPtr<ISceneViewExtension> NoesisRegisterSceneViewExtension()
 	{
 		FSlateApplication::Get().OnPreTick().AddStatic(&StaticPreTick);
 	}
+	GNoesisEndFrameRTHandle = FCoreDelegates::OnEndFrameRT.AddStatic(&NoesisOnEndFrameRT);
+	GNoesisWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddStatic(&NoesisOnWorldCleanup);
 	return FSceneViewExtensions::NewExtension<FNoesisSceneViewExtension>();
 }
 
 void NoesisUnregisterSceneViewExtension(TSharedPtr<class ISceneViewExtension>)
 {
+	FWorldDelegates::OnWorldCleanup.Remove(GNoesisWorldCleanupHandle);
+
+	// Release the elements of updates that were never drawn
+	ENQUEUE_RENDER_COMMAND(FNoesisInstance_FlushRenderUpdates)
+	(
+		[](FRHICommandListImmediate& RHICmdList)
+		{
+			FCoreDelegates::OnEndFrameRT.Remove(GNoesisEndFrameRTHandle);
+			NoesisApplyRenderUpdates(RHICmdList, MAX_uint64);
+		}
+	);
 
 }
 
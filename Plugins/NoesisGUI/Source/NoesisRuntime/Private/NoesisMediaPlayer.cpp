@@ -40,14 +40,28 @@
 
 #include "NsApp/MediaElement.h"
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("MediaElementsActive"), STAT_NoesisMediaElementsActive, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("MediaElementsIdle"), STAT_NoesisMediaElementsIdle, STATGROUP_Noesis);
+
+static int32 NumMediaPlayers = 0;
+static int32 NumTickingMediaPlayers = 0;
+
+static void UpdateMediaStats()
+{
+	SET_DWORD_STAT(STAT_NoesisMediaElementsActive, NumTickingMediaPlayers);
+	SET_DWORD_STAT(STAT_NoesisMediaElementsIdle, NumMediaPlayers - NumTickingMediaPlayers);
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 NoesisMediaPlayer::NoesisMediaPlayer(NoesisApp::MediaElement* Owner, const Noesis::Uri& Uri, void*):
 	MediaPlayer(nullptr), MediaTexture(nullptr), SoundComponent(nullptr),
-	TextureSource(*new Noesis::TextureSource()), View(nullptr), Volume(0.5f), Position(0.0),
-	Opened(false), Ended(false), KeepPlaying(false), IsBuffering(false)
+	TextureSource(*new Noesis::TextureSource()), View(nullptr), Rate(1.0f), Volume(0.5f), Position(0.0),
+	IsOpen(false), Opened(false), Ended(false), KeepPlaying(false), IsBuffering(false), Ticking(false)
 {
+	NumMediaPlayers++;
+	UpdateMediaStats();
+
 	MediaPlayer = NewObject<UMediaPlayer>(GetTransientPackage(), NAME_None, RF_Transient | RF_Public);
 	MediaPlayer->AddToRoot();
 
@@ -74,19 +88,19 @@ NoesisMediaPlayer::NoesisMediaPlayer(NoesisApp::MediaElement* Owner, const Noesi
 
 	FString VideoPath = NsProviderUriToAssetPath(Uri);
 	UMediaSource* MediaSource = LoadObject<UMediaSource>(nullptr, *VideoPath, nullptr, LOAD_NoWarn);
+	// The view is only ticked while there are pending notifications or audio to feed, the rest of
+	// state changes are driven by media events
 	if (MediaSource != nullptr && MediaPlayer->OpenSource(MediaSource))
 	{
 		MediaPlayer->OnMediaEvent().AddRaw(this, &NoesisMediaPlayer::OnMediaEvent);
 
 		View = Owner->GetView();
-		View->Rendering() += Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
 	}
 	else if (MediaPlayer->OpenFile(UTF8_TO_TCHAR(Uri.Str())))
 	{
 		MediaPlayer->OnMediaEvent().AddRaw(this, &NoesisMediaPlayer::OnMediaEvent);
 
 		View = Owner->GetView();
-		View->Rendering() += Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
 	}
 	else
 	{
@@ -97,10 +111,13 @@ NoesisMediaPlayer::NoesisMediaPlayer(NoesisApp::MediaElement* Owner, const Noesi
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 NoesisMediaPlayer::~NoesisMediaPlayer()
 {
-	if (View != nullptr)
+	if (Ticking)
 	{
 		View->Rendering() -= Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
+		NumTickingMediaPlayers--;
 	}
+	NumMediaPlayers--;
+	UpdateMediaStats();
 
 	MediaPlayer->OnMediaEvent().RemoveAll(this);
 	MediaPlayer->Close();
@@ -171,15 +188,16 @@ void NoesisMediaPlayer::SetPosition(double value)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 float NoesisMediaPlayer::GetSpeedRatio() const
 {
-	return MediaPlayer->GetRate();
+	return Rate;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void NoesisMediaPlayer::SetSpeedRatio(float value)
 {
-	// setting rate before media is opened does nothing, so we have to store the value for later
+	// setting rate before media is opened does nothing, so we have to store the value for later.
+	// A non-zero rate also resumes playback, so while paused it is only applied on the next Play
 	Rate = value;
-	MediaPlayer->SetRate(value);
+	UpdatePlayState();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -224,18 +242,21 @@ void NoesisMediaPlayer::SetIsMuted(bool value)
 void NoesisMediaPlayer::Play()
 {
 	KeepPlaying = true;
+	UpdatePlayState();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void NoesisMediaPlayer::Pause()
 {
 	KeepPlaying = false;
+	UpdatePlayState();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void NoesisMediaPlayer::Stop()
 {
 	KeepPlaying = false;
+	UpdatePlayState();
 	MediaPlayer->Rewind();
 }
 
@@ -251,7 +272,13 @@ void NoesisMediaPlayer::OnRendering(Noesis::IView*)
 	// Raise MediaOpened when texture is correctly created
 	if (Opened && MediaTexture->GetWidth() > 2 && MediaTexture->GetHeight() > 2)
 	{
-		TextureSource->SetTexture(FNoesisRenderDevice::CreateTexture(MediaTexture));
+		// The wrapper follows the texture reference of the media texture, so reopening the player
+		// only needs a new one when the size of the video changes
+		if (Texture == nullptr || Texture->GetWidth() != (uint32)MediaTexture->GetWidth() || Texture->GetHeight() != (uint32)MediaTexture->GetHeight())
+		{
+			Texture = FNoesisRenderDevice::CreateTexture(MediaTexture);
+			TextureSource->SetTexture(Texture);
+		}
 
 		// Some platforms need looping to be enabled in order to work correctly:
 		// Windows: The texture resource is discarded when the media ends.
@@ -274,24 +301,57 @@ void NoesisMediaPlayer::OnRendering(Noesis::IView*)
 		Ended = false;
 	}
 
-	// Check if we need to continue playing or player has been paused/stopped
-	if (KeepPlaying)
+	if (SoundComponent != nullptr)
 	{
-		if (!MediaPlayer->IsPlaying())
-		{
-			MediaPlayer->Play();
-		}
+		SoundComponent->UpdatePlayer();
 	}
-	else
+
+	UpdateTicking();
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void NoesisMediaPlayer::UpdatePlayState()
+{
+	// Commands sent before the media is opened are ignored, they are applied on MediaOpened
+	if (IsOpen)
 	{
-		MediaPlayer->Pause();
+		if (KeepPlaying)
+		{
+			// UMediaPlayer::Play() resets the rate to 1, the stored speed ratio is used instead
+			if (!MediaPlayer->IsPlaying() || !FMath::IsNearlyEqual(MediaPlayer->GetRate(), Rate))
+			{
+				MediaPlayer->SetRate(Rate);
+			}
+		}
+		else
+		{
+			MediaPlayer->Pause();
+		}
 	}
 
-	if (SoundComponent != nullptr)
+	UpdateTicking();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void NoesisMediaPlayer::UpdateTicking()
+{
+	bool NeedsTicking = View != nullptr && (Opened || Ended || (KeepPlaying && SoundComponent != nullptr));
+	if (NeedsTicking != Ticking)
 	{
-		SoundComponent->UpdatePlayer();
+		Ticking = NeedsTicking;
+		if (Ticking)
+		{
+			View->Rendering() += Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
+			NumTickingMediaPlayers++;
+		}
+		else
+		{
+			View->Rendering() -= Noesis::MakeDelegate(this, &NoesisMediaPlayer::OnRendering);
+			NumTickingMediaPlayers--;
+		}
+		UpdateMediaStats();
 	}
-};
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void NoesisMediaPlayer::OnMediaEvent(EMediaEvent Event)
@@ -306,6 +366,7 @@ void NoesisMediaPlayer::OnMediaEvent(EMediaEvent Event)
 		}
 		case EMediaEvent::MediaClosed:
 		{
+			IsOpen = false;
 			break;
 		}
 		case EMediaEvent::MediaConnecting:
@@ -314,7 +375,13 @@ void NoesisMediaPlayer::OnMediaEvent(EMediaEvent Event)
 		}
 		case EMediaEvent::MediaOpened:
 		{
+			IsOpen = true;
 			Opened = true;
+			if (Position > 0.0f)
+			{
+				MediaPlayer->Seek(FTimespan::FromSeconds(Position));
+			}
+			UpdatePlayState();
 			break;
 		}
 		case EMediaEvent::MediaOpenFailed:
@@ -325,6 +392,7 @@ void NoesisMediaPlayer::OnMediaEvent(EMediaEvent Event)
 		case EMediaEvent::PlaybackEndReached:
 		{
 			Ended = true;
+			UpdatePlayState();
 			break;
 		}
 		case EMediaEvent::PlaybackResumed:
@@ -346,6 +414,11 @@ void NoesisMediaPlayer::OnMediaEvent(EMediaEvent Event)
 			{
 				SoundComponent->Stop();
 			}
+			// Some players suspend on their own, after seeking or reaching the end
+			if (KeepPlaying)
+			{
+				UpdatePlayState();
+			}
 			break;
 		}
 		case EMediaEvent::SeekCompleted:
@@ -57,6 +57,8 @@ public:
 private:
 	void OnRendering(Noesis::IView* View);
 	void OnMediaEvent(EMediaEvent Event);
+	void UpdatePlayState();
+	void UpdateTicking();
 
 private:
 	class UMediaPlayer* MediaPlayer;
@@ -64,12 +66,15 @@ private:
 	class UMediaSoundComponent* SoundComponent;
 
 	Noesis::Ptr<Noesis::TextureSource> TextureSource;
+	Noesis::Ptr<Noesis::Texture> Texture;
 	Noesis::IView* View;
 	float Rate;
 	float Volume;
 	float Position;
+	bool IsOpen;
 	bool Opened;
 	bool Ended;
 	bool KeepPlaying;
 	bool IsBuffering;
+	bool Ticking;
 };
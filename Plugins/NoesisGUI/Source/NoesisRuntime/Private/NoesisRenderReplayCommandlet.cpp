@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NoesisRenderReplayCommandlet.h"
+
+// Core includes
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+// NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
+#include "Render/NoesisRenderCapture.h"
+
+UNoesisRenderReplayCommandlet::UNoesisRenderReplayCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UNoesisRenderReplayCommandlet::Main(const FString& Params)
+{
+	FString CapturePath = FNoesisRenderCapture::GetDefaultDirectory();
+	FParse::Value(*Params, TEXT("Capture="), CapturePath);
+	int32 Iterations = 10;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(1, Iterations);
+
+	TArray<FString> Files;
+	if (IFileManager::Get().DirectoryExists(*CapturePath))
+	{
+		IFileManager::Get().FindFiles(Files, *(CapturePath / TEXT("*") + FNoesisRenderCapture::GetFileExtension()), true, false);
+		Files.Sort();
+		for (FString& File : Files)
+		{
+			File = CapturePath / File;
+		}
+	}
+	else if (IFileManager::Get().FileExists(*CapturePath))
+	{
+		Files.Add(CapturePath);
+	}
+
+	if (Files.Num() == 0)
+	{
+		UE_LOG(LogNoesis, Error, TEXT("No render captures found in '%s'. Record them in a game or PIE session with ")
+			TEXT("'Noesis.RenderCapture.Start <Name> [Frames=60] [Linear=0] [Quit=0]', they are saved to '%s'"),
+			*CapturePath, *FNoesisRenderCapture::GetDefaultDirectory());
+		return 1;
+	}
+
+	int32 NumFailed = 0;
+	for (const FString& File : Files)
+	{
+		NumFailed += FNoesisRenderCapture::ReplayFile(File, Iterations) ? 0 : 1;
+	}
+
+	return NumFailed == 0 ? 0 : 1;
+}
@@ -18,11 +18,16 @@
 #include "Engine/Texture2D.h"
 #include "Engine/Font.h"
 #include "Engine/FontFace.h"
+#include "Engine/StreamableManager.h"
+
+// AssetRegistry includes
+#include "AssetRegistry/AssetRegistryModule.h"
 
 // NoesisRuntime includes
 #include "NoesisXaml.h"
 #include "NoesisSupport.h"
 #include "NoesisRive.h"
+#include "NoesisSettings.h"
 
 #if !WITH_EDITORONLY_DATA
 #if UE_VERSION_OLDER_THAN(5, 6, 0)
@@ -148,10 +153,216 @@ void FNoesisTextureProvider::OnTextureChanged(UTexture2D* Texture)
 #endif
 }
 
+static UTexture2D* FindTexture(const FString& TextureObjectPath)
+{
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	UTexture2D* Texture = FindObject<UTexture2D>(nullptr, *TextureObjectPath);
+#else
+	UTexture2D* Texture = FindFirstObject<UTexture2D>(*TextureObjectPath);
+#endif
+
+	// Textures still being loaded by someone else are treated as not found
+	if (Texture && Texture->HasAnyFlags(RF_NeedLoad | RF_NeedPostLoad))
+	{
+		return nullptr;
+	}
+
+	return Texture;
+}
+
+static bool GetTextureDimensions(const FString& TextureObjectPath, Noesis::TextureInfo& OutInfo)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FName(*TextureObjectPath));
+#else
+	FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(TextureObjectPath));
+#endif
+
+	FString Dimensions;
+	FString Width;
+	FString Height;
+	if (!AssetData.IsValid() || !AssetData.GetTagValue(TEXT("Dimensions"), Dimensions) || !Dimensions.Split(TEXT("x"), &Width, &Height))
+	{
+		return false;
+	}
+
+	OutInfo.width = (uint32)FCString::Atoi(*Width);
+	OutInfo.height = (uint32)FCString::Atoi(*Height);
+	return OutInfo.width != 0 && OutInfo.height != 0;
+}
+
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+typedef FTicker FTSTicker;
+#endif
+
+FNoesisTextureProvider::~FNoesisTextureProvider()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(ReleaseTickerHandle);
+
+	for (auto& Pair : PendingTextures)
+	{
+		if (Pair.Value.Handle.IsValid())
+		{
+			Pair.Value.Handle->CancelHandle();
+		}
+	}
+
+	for (auto& Pair : LoadedTextures)
+	{
+		Pair.Value.Handle->ReleaseHandle();
+	}
+}
+
+bool FNoesisTextureProvider::RequestAsyncLoad(const Noesis::Uri& Uri, const FString& TextureObjectPath, Noesis::TextureInfo& OutInfo)
+{
+	// Pending loads are only touched from the game thread
+	if (!IsInGameThread())
+	{
+		return false;
+	}
+
+	if (FPendingTexture* Pending = PendingTextures.Find(TextureObjectPath))
+	{
+		Pending->Uris.AddUnique(Uri.Str());
+		OutInfo = Pending->Info;
+		return true;
+	}
+
+	const UNoesisSettings* Settings = GetDefault<UNoesisSettings>();
+	if (!Settings->AsyncTextureLoading || !GetTextureDimensions(TextureObjectPath, OutInfo))
+	{
+		return false;
+	}
+
+	if (!StreamableManager.IsValid())
+	{
+		StreamableManager = MakeUnique<FStreamableManager>();
+
+		PlaceholderObject.Reset(Cast<UTexture2D>(Settings->AsyncTexturePlaceholder.TryLoad()));
+		if (PlaceholderObject.IsValid())
+		{
+			PlaceholderTexture = NoesisCreateTexture(PlaceholderObject.Get());
+		}
+	}
+
+	FPendingTexture& Pending = PendingTextures.Add(TextureObjectPath);
+	Pending.Info = OutInfo;
+	Pending.Uris.Add(Uri.Str());
+
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager->RequestAsyncLoad(FSoftObjectPath(TextureObjectPath),
+		FStreamableDelegate::CreateRaw(this, &FNoesisTextureProvider::OnAsyncLoadCompleted, TextureObjectPath));
+
+	// The delegate runs immediately when the texture finished loading in the meantime
+	if (FPendingTexture* StillPending = PendingTextures.Find(TextureObjectPath))
+	{
+		StillPending->Handle = Handle;
+	}
+	else if (Handle.IsValid())
+	{
+		AddLoadedTexture(TextureObjectPath, Handle);
+	}
+
+	return true;
+}
+
+void FNoesisTextureProvider::AddLoadedTexture(const FString& TextureObjectPath, const TSharedPtr<FStreamableHandle>& Handle)
+{
+	{
+		FScopeLock Lock(&LoadedTexturesLock);
+		FLoadedTexture& LoadedTexture = LoadedTextures.FindOrAdd(TextureObjectPath);
+		LoadedTexture.Handle = Handle;
+		LoadedTexture.LoadedTime = FPlatformTime::Seconds();
+	}
+
+	if (!ReleaseTickerHandle.IsValid())
+	{
+		ReleaseTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FNoesisTextureProvider::ReleaseUnusedTextures), 1.0f);
+	}
+}
+
+bool FNoesisTextureProvider::ReleaseUnusedTextures(float DeltaTime)
+{
+	// Time Noesis has to fetch a texture after its load completes, the element that requested it may
+	// have been unloaded in the meantime
+	const double FetchGracePeriod = 10.0;
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<TSharedPtr<FStreamableHandle>> UnusedHandles;
+	bool HasLoadedTextures;
+	{
+		FScopeLock Lock(&LoadedTexturesLock);
+		for (auto It = LoadedTextures.CreateIterator(); It; ++It)
+		{
+			// Only this provider holds the textures, Noesis released them
+			const TArray<Noesis::Ptr<Noesis::Texture>>& Textures = It.Value().Textures;
+			bool InUse = Textures.Num() == 0 && Now - It.Value().LoadedTime < FetchGracePeriod;
+			for (const Noesis::Ptr<Noesis::Texture>& Texture : Textures)
+			{
+				InUse |= Texture->GetNumReferences() > 1;
+			}
+
+			if (!InUse)
+			{
+				UnusedHandles.Add(MoveTemp(It.Value().Handle));
+				It.RemoveCurrent();
+			}
+		}
+		HasLoadedTextures = LoadedTextures.Num() != 0;
+	}
+
+	for (TSharedPtr<FStreamableHandle>& Handle : UnusedHandles)
+	{
+		Handle->ReleaseHandle();
+	}
+
+	if (!HasLoadedTextures)
+	{
+		ReleaseTickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FNoesisTextureProvider::OnAsyncLoadCompleted(FString TextureObjectPath)
+{
+	FPendingTexture Pending;
+	if (!PendingTextures.RemoveAndCopyValue(TextureObjectPath, Pending))
+	{
+		return;
+	}
+
+	// Keep the texture alive, Noesis only holds a reference to its render resource
+	if (Pending.Handle.IsValid())
+	{
+		AddLoadedTexture(TextureObjectPath, Pending.Handle);
+	}
+
+	// Reloading the URI swaps the placeholder with the loaded texture
+	for (const FString& Uri : Pending.Uris)
+	{
+		RaiseTextureChanged(TCHAR_TO_UTF8(*Uri));
+	}
+}
+
 Noesis::TextureInfo FNoesisTextureProvider::GetTextureInfo(const Noesis::Uri& Uri)
 {
 	FString TexturePath = NsProviderUriToAssetPath(Uri);
-	UTexture2D* Texture = LoadObject<UTexture2D>(nullptr, *TexturePath, nullptr, LOAD_NoWarn);
+	FString TextureObjectPath = TexturePath + TEXT(".") + FPackageName::GetShortName(TexturePath);
+	UTexture2D* Texture = FindTexture(TextureObjectPath);
+
+	if (!Texture)
+	{
+		// Layout only needs the dimensions, the texture itself is swapped in when the load completes
+		Noesis::TextureInfo Info;
+		if (RequestAsyncLoad(Uri, TextureObjectPath, Info))
+		{
+			return Info;
+		}
+
+		Texture = LoadObject<UTexture2D>(nullptr, *TexturePath, nullptr, LOAD_NoWarn);
+	}
 
 	if (Texture)
 	{
@@ -168,18 +379,23 @@ Noesis::Ptr<Noesis::Texture> FNoesisTextureProvider::LoadTexture(const Noesis::U
 {
 	FString TexturePath = NsProviderUriToAssetPath(Uri);
 	FString TextureObjectPath = TexturePath + TEXT(".") + FPackageName::GetShortName(TexturePath);
-#if UE_VERSION_OLDER_THAN(5, 1, 0)
-	UTexture2D* Texture = FindObject<UTexture2D>(nullptr, *TextureObjectPath);
-#else
-	UTexture2D* Texture = FindFirstObject<UTexture2D>(*TextureObjectPath);
-#endif
+	UTexture2D* Texture = FindTexture(TextureObjectPath);
 
 	if (Texture)
 	{
-		return NoesisCreateTexture(Texture);
+		Noesis::Ptr<Noesis::Texture> NoesisTexture = NoesisCreateTexture(Texture);
+
+		FScopeLock Lock(&LoadedTexturesLock);
+		FLoadedTexture* LoadedTexture = LoadedTextures.Find(TextureObjectPath);
+		if (LoadedTexture != nullptr)
+		{
+			LoadedTexture->Textures.Add(NoesisTexture);
+		}
+
+		return NoesisTexture;
 	}
 
-	return nullptr;
+	return PlaceholderTexture;
 };
 
 void FNoesisFontProvider::RegisterFont(const UFontFace* FontFace)
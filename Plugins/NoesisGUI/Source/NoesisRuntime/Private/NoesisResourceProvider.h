@@ -7,6 +7,11 @@
 
 // Core includes
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Misc/EngineVersionComparison.h"
+
+// CoreUObject includes
+#include "UObject/StrongObjectPtr.h"
 
 // Noesis includes
 #include "NoesisSDK.h"
@@ -30,6 +35,8 @@ public:
 class FNoesisTextureProvider : public Noesis::TextureProvider
 {
 public:
+	~FNoesisTextureProvider();
+
 	void OnTextureChanged(class UTexture2D* Texture);
 
 private:
@@ -38,6 +45,42 @@ private:
 	virtual Noesis::Ptr<Noesis::Texture> LoadTexture(const Noesis::Uri& Uri, Noesis::RenderDevice* RenderDevice) override;
 	// End of TextureProvider interface
 
+	bool RequestAsyncLoad(const Noesis::Uri& Uri, const FString& TextureObjectPath, Noesis::TextureInfo& OutInfo);
+	void OnAsyncLoadCompleted(FString TextureObjectPath);
+	void AddLoadedTexture(const FString& TextureObjectPath, const TSharedPtr<struct FStreamableHandle>& Handle);
+	bool ReleaseUnusedTextures(float DeltaTime);
+
+	struct FPendingTexture
+	{
+		TSharedPtr<struct FStreamableHandle> Handle;
+		Noesis::TextureInfo Info;
+		TArray<FString> Uris;
+	};
+
+	// Textures are requested on the game thread and swapped in with RaiseTextureChanged once loaded
+	TUniquePtr<struct FStreamableManager> StreamableManager;
+	TMap<FString, FPendingTexture> PendingTextures;
+
+	struct FLoadedTexture
+	{
+		TSharedPtr<struct FStreamableHandle> Handle;
+		// Textures handed to Noesis, the handle is released once Noesis is done with all of them
+		TArray<Noesis::Ptr<Noesis::Texture>> Textures;
+		// When the load completed, an entry Noesis never fetched is released after a grace period
+		double LoadedTime = 0.0;
+	};
+
+	// LoadTexture may be called outside the game thread
+	FCriticalSection LoadedTexturesLock;
+	TMap<FString, FLoadedTexture> LoadedTextures;
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	FDelegateHandle ReleaseTickerHandle;
+#else
+	FTSTicker::FDelegateHandle ReleaseTickerHandle;
+#endif
+	TStrongObjectPtr<class UTexture2D> PlaceholderObject;
+	Noesis::Ptr<Noesis::Texture> PlaceholderTexture;
+
 #if WITH_EDITOR
 	mutable TMap<class UTexture2D*, FString> NameMap;
 #endif
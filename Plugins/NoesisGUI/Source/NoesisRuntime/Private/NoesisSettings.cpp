@@ -27,11 +27,13 @@ UNoesisSettings::UNoesisSettings(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	OffscreenTextureSampleCount = ENoesisOffscreenSampleCount::One;
+	OffscreenPoolBudget = 128;
 	GlyphTextureSize = ENoesisGlyphCacheDimensions::x1024;
 	ApplicationResources = FSoftObjectPath("/NoesisGUI/Theme/NoesisTheme_DarkBlue.NoesisTheme_DarkBlue");
 	DefaultFonts.Add(FSoftObjectPath("/NoesisGUI/Theme/Fonts/PT_Root_UI_Regular.PT_Root_UI_Regular"));
 	DefaultFonts.Add(FSoftObjectPath("/NoesisGUI/Theme/Fonts/PT_Root_UI_Bold.PT_Root_UI_Bold"));
 	LoadPlatformFonts = true;
+	AsyncTextureLoading = true;
 	DefaultFontSize = 15.f;
 	DefaultFontWeight = ENoesisFontWeight::Normal;
 	DefaultFontStretch = ENoesisFontStretch::Normal;
@@ -3225,6 +3225,7 @@ void NoesisDestroyViews()
 		UNoesisWorldUIComponent* WorldUIComponent = *It;
 		WorldUIComponent->Remove3DElement();
 	}
+	UNoesisWorldUIComponent::ClearTemplateCache();
 
 	// We keep track of the rest of initialized views, and their DataContexts, as those may be running in game.
 	TArray<UNoesisInstance*> InstancesToRecreate;
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NoesisWorldUIComponent.h"
+
+// Core includes
+#include "HAL/IConsoleManager.h"
+
+// Engine includes
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+
+// NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
+#include "NoesisXaml.h"
+
+#if !UE_BUILD_SHIPPING
+
+static TArray<TWeakObjectPtr<AActor>> GBenchmarkActors;
+
+static void DestroyBenchmarkActors()
+{
+	for (TWeakObjectPtr<AActor>& Actor : GBenchmarkActors)
+	{
+		if (Actor.IsValid())
+		{
+			Actor->Destroy();
+		}
+	}
+	GBenchmarkActors.Empty();
+}
+
+// Spawns a grid of world UI components around the first player, to compare the cost of regular and
+// instanced components with 'stat Noesis'
+static void WorldUIBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+	DestroyBenchmarkActors();
+
+	if (Args.Num() == 0)
+	{
+		UE_LOG(LogNoesis, Display, TEXT("Usage: Noesis.WorldUIBenchmark XamlPath [Count=500] [Instanced=1] [LODXamlPath] [LODDistance=2000] [CullDistance=6000]"));
+		return;
+	}
+
+	if (World == nullptr || !World->IsGameWorld())
+	{
+		UE_LOG(LogNoesis, Warning, TEXT("Noesis.WorldUIBenchmark must be run in a game world"));
+		return;
+	}
+
+	UNoesisXaml* Xaml = LoadObject<UNoesisXaml>(nullptr, *Args[0]);
+	if (Xaml == nullptr)
+	{
+		UE_LOG(LogNoesis, Warning, TEXT("Noesis.WorldUIBenchmark: can't load Xaml '%s'"), *Args[0]);
+		return;
+	}
+
+	int32 Count = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : 500;
+	bool Instanced = Args.Num() > 2 ? FCString::Atoi(*Args[2]) != 0 : true;
+	UNoesisXaml* LODXaml = Args.Num() > 3 && Args[3] != TEXT("None") ? LoadObject<UNoesisXaml>(nullptr, *Args[3]) : nullptr;
+	float LODDistance = Args.Num() > 4 ? FCString::Atof(*Args[4]) : 2000.0f;
+	float CullDistance = Args.Num() > 5 ? FCString::Atof(*Args[5]) : 6000.0f;
+
+	FVector Origin = FVector::ZeroVector;
+	APlayerController* PlayerController = World->GetFirstPlayerController();
+	if (PlayerController != nullptr)
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(Origin, ViewRotation);
+	}
+
+	const float Spacing = 300.0f;
+	const int32 Columns = FMath::CeilToInt(FMath::Sqrt((float)Count));
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		FVector Location = Origin + FVector(((Index / Columns) + 1) * Spacing, ((Index % Columns) - Columns / 2) * Spacing, 0.0f);
+
+		AActor* Actor = World->SpawnActor<AActor>(Location, FRotator::ZeroRotator);
+		if (Actor == nullptr)
+			continue;
+
+		UNoesisWorldUIComponent* Component = NewObject<UNoesisWorldUIComponent>(Actor);
+		Component->Xaml = Xaml;
+		Component->Instanced = Instanced;
+		Component->LODXaml = LODXaml;
+		Component->LODDistance = LODDistance;
+		Component->CullDistance = CullDistance;
+		Actor->SetRootComponent(Component);
+		Component->SetWorldLocation(Location);
+		Component->RegisterComponent();
+
+		GBenchmarkActors.Add(Actor);
+	}
+
+	UE_LOG(LogNoesis, Display, TEXT("Noesis.WorldUIBenchmark: spawned %d %s world UI components, use 'stat Noesis' to see the cost"),
+		GBenchmarkActors.Num(), Instanced ? TEXT("instanced") : TEXT("regular"));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs WorldUIBenchmarkCommand(TEXT("Noesis.WorldUIBenchmark"),
+	TEXT("Spawns world UI components around the player. Usage: Noesis.WorldUIBenchmark XamlPath [Count=500] [Instanced=1] [LODXamlPath] [LODDistance=2000] [CullDistance=6000]. Without arguments removes them"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&WorldUIBenchmark));
+
+#endif
@@ -9,18 +9,159 @@
 #include "Blueprint/UserWidget.h"
 
 // NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
 #include "NoesisSupport.h"
 #include "NoesisTypeClass.h"
 #include "NoesisXaml.h"
 
-UNoesisWorldUIComponent::UNoesisWorldUIComponent(): Xaml(nullptr), Scale(1.0f), Center(true)
+DECLARE_CYCLE_STAT(TEXT("WorldUIUpdate"), STAT_NoesisWorldUIUpdate, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("WorldUIInstances"), STAT_NoesisWorldUIInstances, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUIInstancesLOD"), STAT_NoesisWorldUIInstancesLOD, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("WorldUIInstancesCulled"), STAT_NoesisWorldUIInstancesCulled, STATGROUP_Noesis);
+
+// Instanced components of each world, all of them are updated from a single OnWorldPreActorTick handler
+static TMap<UWorld*, TArray<UNoesisWorldUIComponent*>> GInstancedComponents;
+static int32 GNumInstancedComponents = 0;
+static FDelegateHandle GWorldPreActorTickHandle;
+
+// DataTemplates shared by instanced components, a null entry remembers a Xaml whose root is not a DataTemplate
+static TMap<TWeakObjectPtr<UNoesisXaml>, Noesis::Ptr<Noesis::DataTemplate>> GTemplateCache;
+
+static Noesis::DataTemplate* FindTemplate(UNoesisXaml* Xaml)
+{
+	if (Xaml == nullptr)
+		return nullptr;
+
+	if (Noesis::Ptr<Noesis::DataTemplate>* Found = GTemplateCache.Find(Xaml))
+	{
+		return Found->GetPtr();
+	}
+
+	Noesis::Ptr<Noesis::DataTemplate> Template = Noesis::DynamicPtrCast<Noesis::DataTemplate>(Xaml->LoadXaml());
+	if (Template == nullptr)
+	{
+		UE_LOG(LogNoesis, Warning, TEXT("Instanced world UI requires a DataTemplate as the root of '%s'"), *Xaml->GetPathName());
+	}
+	GTemplateCache.Add(Xaml, Template);
+
+	return Template;
+}
+
+static void UpdateInstancedComponents(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	TArray<UNoesisWorldUIComponent*>* Components = GInstancedComponents.Find(World);
+	if (Components == nullptr)
+		return;
+
+	APlayerController* PlayerController = World->GetFirstPlayerController();
+	if (PlayerController == nullptr)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_NoesisWorldUIUpdate);
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	FVector ViewForward = ViewRotation.RotateVector(FVector(-1.0f, 0.0f, 0.0f));
+
+	int32 NumLOD = 0;
+	int32 NumCulled = 0;
+	for (UNoesisWorldUIComponent* Component : *Components)
+	{
+		float DistanceSquared = FVector::DistSquared(Component->GetComponentLocation(), ViewLocation);
+
+		ENoesisWorldUILOD LOD = ENoesisWorldUILOD::Full;
+		if (Component->CullDistance > 0.0f && DistanceSquared > FMath::Square(Component->CullDistance))
+		{
+			LOD = ENoesisWorldUILOD::Culled;
+			NumCulled++;
+		}
+		else if (Component->LODDistance > 0.0f && DistanceSquared > FMath::Square(Component->LODDistance))
+		{
+			LOD = ENoesisWorldUILOD::Low;
+			NumLOD++;
+		}
+
+		Component->SetLOD(LOD);
+
+		// Far away elements keep their last sorting order
+		if (LOD == ENoesisWorldUILOD::Full)
+		{
+			Component->UpdateZIndex(ViewLocation, ViewForward);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_NoesisWorldUIInstancesLOD, NumLOD);
+	INC_DWORD_STAT_BY(STAT_NoesisWorldUIInstancesCulled, NumCulled);
+}
+
+static void RegisterInstancedComponent(UNoesisWorldUIComponent* Component)
+{
+	GInstancedComponents.FindOrAdd(Component->GetWorld()).Add(Component);
+
+	if (GNumInstancedComponents++ == 0)
+	{
+		GWorldPreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddStatic(&UpdateInstancedComponents);
+	}
+
+	SET_DWORD_STAT(STAT_NoesisWorldUIInstances, GNumInstancedComponents);
+}
+
+static void UnregisterInstancedComponent(UNoesisWorldUIComponent* Component)
+{
+	TArray<UNoesisWorldUIComponent*>* Components = GInstancedComponents.Find(Component->GetWorld());
+	if (Components == nullptr || Components->RemoveSingleSwap(Component, false) == 0)
+		return;
+
+	if (Components->Num() == 0)
+	{
+		GInstancedComponents.Remove(Component->GetWorld());
+	}
+
+	if (--GNumInstancedComponents == 0)
+	{
+		FWorldDelegates::OnWorldPreActorTick.Remove(GWorldPreActorTickHandle);
+		GWorldPreActorTickHandle.Reset();
+		UNoesisWorldUIComponent::ClearTemplateCache();
+	}
+
+	SET_DWORD_STAT(STAT_NoesisWorldUIInstances, GNumInstancedComponents);
+}
+
+UNoesisWorldUIComponent::UNoesisWorldUIComponent(): Xaml(nullptr), Scale(1.0f), Center(true), Instanced(false), LODXaml(nullptr),
+	LODDistance(0.0f), CullDistance(0.0f), IsInstancedElement(false), TransformDirty(false), LOD(ENoesisWorldUILOD::Full), ZIndex(0)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 }
 
+void UNoesisWorldUIComponent::ClearTemplateCache()
+{
+	GTemplateCache.Empty();
+}
+
 void UNoesisWorldUIComponent::Add3DElement()
 {
-	Element = Noesis::DynamicPtrCast<Noesis::FrameworkElement>(Xaml->LoadXaml());
+	IsInstancedElement = false;
+	if (Instanced)
+	{
+		Noesis::DataTemplate* Template = FindTemplate(Xaml);
+		if (Template != nullptr)
+		{
+			Noesis::Ptr<Noesis::ContentPresenter> Presenter = Noesis::MakePtr<Noesis::ContentPresenter>();
+			Presenter->SetContentTemplate(Template);
+			Element = Presenter;
+			IsInstancedElement = true;
+			TransformDirty = false;
+			LOD = ENoesisWorldUILOD::Full;
+			ZIndex = 0;
+		}
+	}
+
+	if (!IsInstancedElement)
+	{
+		Element = Noesis::DynamicPtrCast<Noesis::FrameworkElement>(Xaml->LoadXaml());
+	}
+
 	if (Element != nullptr)
 	{
 		Noesis::MatrixTransform3D* Transform3D = Noesis::DynamicCast<Noesis::MatrixTransform3D*>(Element->GetTransform3D());
@@ -34,6 +175,17 @@ void UNoesisWorldUIComponent::Add3DElement()
 		UNoesisInstance::Add3DElement(GetWorld(), Element);
 
 		OnTransformUpdated(this, EUpdateTransformFlags::None, ETeleportType::None);
+
+		if (IsInstancedElement)
+		{
+			RegisterInstancedComponent(this);
+		}
+	}
+
+	// Instanced components are updated all together
+	if (HasBegunPlay())
+	{
+		SetComponentTickEnabled(!IsInstancedElement);
 	}
 }
 
@@ -41,6 +193,12 @@ void UNoesisWorldUIComponent::Remove3DElement()
 {
 	if (Element != nullptr)
 	{
+		if (IsInstancedElement)
+		{
+			UnregisterInstancedComponent(this);
+			IsInstancedElement = false;
+		}
+
 		UNoesisInstance::Remove3DElement(GetWorld(), Element);
 		TransformUpdated.Remove(TransformUpdatedDelegateHandle);
 		Element.Reset();
@@ -65,18 +223,68 @@ void UNoesisWorldUIComponent::TickComponent(float DeltaTime, ELevelTick TickType
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	FTransform Transform = GetComponentToWorld();
 	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (Element == nullptr || IsInstancedElement || PlayerController == nullptr)
+		return;
+
 	FVector MonoLocation;
 	FRotator MonoRotation;
 	PlayerController->GetPlayerViewPoint(MonoLocation, MonoRotation);
 	FVector CameraForward = MonoRotation.RotateVector(FVector(-1.0f, 0.0f, 0.0f));
-	int32 ZIndex = (int32)CameraForward.Dot(Transform.GetLocation() - MonoLocation);
-	Element->SetValue<int32>(Noesis::Panel::ZIndexProperty, ZIndex);
+	UpdateZIndex(MonoLocation, CameraForward);
+}
+
+void UNoesisWorldUIComponent::SetLOD(ENoesisWorldUILOD InLOD)
+{
+	if (LOD == InLOD)
+		return;
+
+	LOD = InLOD;
+
+	if (LOD == ENoesisWorldUILOD::Culled)
+	{
+		// Collapsed elements are skipped by layout and rendering
+		Element->SetVisibility(Noesis::Visibility_Collapsed);
+		return;
+	}
+
+	Noesis::DataTemplate* Template = LOD == ENoesisWorldUILOD::Low ? FindTemplate(LODXaml) : nullptr;
+	if (Template == nullptr)
+	{
+		Template = FindTemplate(Xaml);
+	}
+
+	Noesis::ContentPresenter* Presenter = static_cast<Noesis::ContentPresenter*>(Element.GetPtr());
+	bool TemplateChanged = Presenter->GetContentTemplate() != Template;
+	Presenter->SetContentTemplate(Template);
+	Element->SetVisibility(Noesis::Visibility_Visible);
+
+	// The size of the template may be different, and culled elements don't track their transform
+	if (TemplateChanged || TransformDirty)
+	{
+		OnTransformUpdated(this, EUpdateTransformFlags::None, ETeleportType::None);
+	}
+}
+
+void UNoesisWorldUIComponent::UpdateZIndex(const FVector& ViewLocation, const FVector& ViewForward)
+{
+	int32 NewZIndex = (int32)ViewForward.Dot(GetComponentLocation() - ViewLocation);
+	if (NewZIndex != ZIndex)
+	{
+		ZIndex = NewZIndex;
+		Element->SetValue<int32>(Noesis::Panel::ZIndexProperty, ZIndex);
+	}
 }
 
 void UNoesisWorldUIComponent::OnTransformUpdated(USceneComponent*, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
 {
+	if (IsInstancedElement && LOD == ENoesisWorldUILOD::Culled)
+	{
+		TransformDirty = true;
+		return;
+	}
+	TransformDirty = false;
+
 	FTransform Transform = GetComponentToWorld();
 	FMatrix Matrix = Transform.ToMatrixWithScale();
 
@@ -118,6 +326,14 @@ void UNoesisWorldUIComponent::SetDataContext(UObject* InDataContext)
 	if (Element)
 	{
 		Noesis::Ptr<Noesis::BaseComponent> DataContext = NoesisCreateComponentForUObject(InDataContext);
-		Element->SetDataContext(DataContext);
+		if (IsInstancedElement)
+		{
+			// The content becomes the DataContext of the template
+			static_cast<Noesis::ContentPresenter*>(Element.GetPtr())->SetContent(DataContext);
+		}
+		else
+		{
+			Element->SetDataContext(DataContext);
+		}
 	}
 }
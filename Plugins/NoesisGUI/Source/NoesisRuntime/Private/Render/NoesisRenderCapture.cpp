@@ -0,0 +1,844 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NoesisRenderCapture.h"
+
+// Core includes
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// Engine includes
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "UnrealClient.h"
+
+// RenderCore includes
+#include "RenderingThread.h"
+
+// NoesisRuntime includes
+#include "NoesisRenderDevice.h"
+#include "NoesisRuntimeModule.h"
+
+static const uint32 GNoesisCaptureMagic = 0x3143524E; // 'NRC1'
+static const uint32 GNoesisCaptureVersion = 1;
+
+static TUniquePtr<FNoesisRenderCapture> GNoesisActiveCapture;
+
+static const TCHAR* GetCommandName(int32 Command)
+{
+	static const TCHAR* Names[] =
+	{
+		TEXT("CreateRenderTarget"), TEXT("CloneRenderTarget"), TEXT("CreateTexture"), TEXT("UpdateTexture"),
+		TEXT("BeginOffscreenRender"), TEXT("EndOffscreenRender"), TEXT("BeginOnscreenRender"), TEXT("EndOnscreenRender"),
+		TEXT("SetRenderTarget"), TEXT("BeginTile"), TEXT("EndTile"), TEXT("ResolveRenderTarget"),
+		TEXT("MapVertices"), TEXT("MapIndices"), TEXT("DrawBatch"), TEXT("EndFrame")
+	};
+	static_assert(UE_ARRAY_COUNT(Names) == (int32)ENoesisRenderCommand::Count, "Command names out of sync with ENoesisRenderCommand");
+
+	return Names[Command];
+}
+
+static uint32 GetBytesPerPixel(Noesis::Texture* Texture)
+{
+	FRHITexture* RHITexture = FNoesisRenderDevice::GetRHITexture(Texture);
+	return RHITexture != nullptr ? GPixelFormats[RHITexture->GetFormat()].BlockBytes : 4;
+}
+
+FNoesisRenderCapture::FNoesisRenderCapture(const FString& InPath, uint32 InNumFrames, uint32 ViewportWidth, uint32 ViewportHeight)
+	: Path(InPath), NumFrames(InNumFrames)
+{
+	Writer = MakeUnique<FMemoryWriter>(Data);
+	FArchive& Ar = *Writer;
+
+	uint32 Magic = GNoesisCaptureMagic;
+	uint32 Version = GNoesisCaptureVersion;
+	Ar << Magic << Version << ViewportWidth << ViewportHeight;
+}
+
+void FNoesisRenderCapture::Start(FNoesisRenderDevice* InDevice, const FString& Path, uint32 NumFrames, uint32 ViewportWidth, uint32 ViewportHeight,
+	bool QuitWhenSaved)
+{
+	check(IsInRenderingThread());
+	if (GNoesisActiveCapture.IsValid())
+	{
+		UE_LOG(LogNoesis, Warning, TEXT("A render capture is already in progress"));
+		return;
+	}
+
+	GNoesisActiveCapture = MakeUnique<FNoesisRenderCapture>(Path, NumFrames, ViewportWidth, ViewportHeight);
+	GNoesisActiveCapture->Device = InDevice;
+	GNoesisActiveCapture->QuitWhenSaved = QuitWhenSaved;
+	GNoesisActiveCapture->EndFrameHandle = FCoreDelegates::OnEndFrameRT.AddRaw(GNoesisActiveCapture.Get(), &FNoesisRenderCapture::OnEndFrame);
+	InDevice->Capture = GNoesisActiveCapture.Get();
+}
+
+void FNoesisRenderCapture::OnEndFrame()
+{
+	if (!Recording)
+	{
+		Recording = true;
+		return;
+	}
+
+	RecordCommand(ENoesisRenderCommand::EndFrame);
+	if (++NumRecordedFrames < NumFrames)
+		return;
+
+	Device->Capture = nullptr;
+	FCoreDelegates::OnEndFrameRT.Remove(EndFrameHandle);
+	Writer.Reset();
+
+	if (FFileHelper::SaveArrayToFile(Data, *Path))
+	{
+		UE_LOG(LogNoesis, Display, TEXT("Render capture of %u frames saved to '%s' (%d KB)"), NumRecordedFrames, *Path, Data.Num() / 1024);
+	}
+	else
+	{
+		UE_LOG(LogNoesis, Warning, TEXT("Can't save render capture to '%s'"), *Path);
+	}
+
+	if (QuitWhenSaved)
+	{
+		AsyncTask(ENamedThreads::GameThread, []() { FPlatformMisc::RequestExit(false); });
+	}
+
+	// Deletes this object, nothing can be accessed afterwards
+	GNoesisActiveCapture.Reset();
+}
+
+uint32 FNoesisRenderCapture::GetTextureId(Noesis::Texture* Texture)
+{
+	if (Texture == nullptr)
+		return 0;
+
+	if (const uint32* Found = TextureIds.Find(Texture))
+		return *Found;
+
+	// Created before the capture started, replayed as a blank texture
+	uint32 Id = ++NumTextures;
+	TextureIds.Add(Texture, Id);
+
+	FRHITexture* RHITexture = FNoesisRenderDevice::GetRHITexture(Texture);
+	uint32 Width = Texture->GetWidth();
+	uint32 Height = Texture->GetHeight();
+	uint32 NumLevels = RHITexture != nullptr ? RHITexture->GetNumMips() : 1;
+	uint8 Format = RHITexture != nullptr && RHITexture->GetFormat() == PF_G8 ? Noesis::TextureFormat::R8 : Noesis::TextureFormat::RGBA8;
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::CreateTexture;
+	Ar << Command << Id << Width << Height << NumLevels << Format;
+
+	return Id;
+}
+
+uint32 FNoesisRenderCapture::GetRenderTargetId(Noesis::RenderTarget* RenderTarget)
+{
+	if (const uint32* Found = RenderTargetIds.Find(RenderTarget))
+		return *Found;
+
+	// Created before the capture started, replayed as a blank render target
+	uint32 Id = ++NumRenderTargets;
+	RenderTargetIds.Add(RenderTarget, Id);
+	uint32 TextureId = ++NumTextures;
+	TextureIds.Add(RenderTarget->GetTexture(), TextureId);
+
+	uint32 Width = RenderTarget->GetTexture()->GetWidth();
+	uint32 Height = RenderTarget->GetTexture()->GetHeight();
+	uint32 SampleCount = 1;
+	uint8 NeedsStencil = 1;
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::CreateRenderTarget;
+	Ar << Command << Id << TextureId << Width << Height << SampleCount << NeedsStencil;
+
+	return Id;
+}
+
+void FNoesisRenderCapture::RecordCreateRenderTarget(Noesis::RenderTarget* RenderTarget, uint32 Width, uint32 Height, uint32 SampleCount, bool NeedsStencil)
+{
+	if (!Recording)
+		return;
+
+	uint32 Id = ++NumRenderTargets;
+	RenderTargetIds.Add(RenderTarget, Id);
+	uint32 TextureId = ++NumTextures;
+	TextureIds.Add(RenderTarget->GetTexture(), TextureId);
+	uint8 Stencil = NeedsStencil ? 1 : 0;
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::CreateRenderTarget;
+	Ar << Command << Id << TextureId << Width << Height << SampleCount << Stencil;
+}
+
+void FNoesisRenderCapture::RecordCloneRenderTarget(Noesis::RenderTarget* RenderTarget, Noesis::RenderTarget* SharedRenderTarget)
+{
+	if (!Recording)
+		return;
+
+	uint32 SharedId = GetRenderTargetId(SharedRenderTarget);
+	uint32 Id = ++NumRenderTargets;
+	RenderTargetIds.Add(RenderTarget, Id);
+	uint32 TextureId = ++NumTextures;
+	TextureIds.Add(RenderTarget->GetTexture(), TextureId);
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::CloneRenderTarget;
+	Ar << Command << Id << TextureId << SharedId;
+}
+
+void FNoesisRenderCapture::RecordCreateTexture(Noesis::Texture* Texture, uint32 Width, uint32 Height, uint32 NumLevels, Noesis::TextureFormat::Enum Format)
+{
+	if (!Recording)
+		return;
+
+	uint32 Id = ++NumTextures;
+	TextureIds.Add(Texture, Id);
+	uint8 TextureFormat = (uint8)Format;
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::CreateTexture;
+	Ar << Command << Id << Width << Height << NumLevels << TextureFormat;
+}
+
+void FNoesisRenderCapture::RecordUpdateTexture(Noesis::Texture* Texture, uint32 Level, uint32 X, uint32 Y, uint32 Width, uint32 Height, const void* InData)
+{
+	if (!Recording)
+		return;
+
+	uint32 Id = GetTextureId(Texture);
+	uint32 Bytes = Width * Height * GetBytesPerPixel(Texture);
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::UpdateTexture;
+	Ar << Command << Id << Level << X << Y << Width << Height << Bytes;
+	Ar.Serialize(const_cast<void*>(InData), Bytes);
+}
+
+void FNoesisRenderCapture::RecordCommand(ENoesisRenderCommand InCommand)
+{
+	if (!Recording)
+		return;
+
+	uint8 Command = (uint8)InCommand;
+	*Writer << Command;
+}
+
+void FNoesisRenderCapture::RecordRenderTargetCommand(ENoesisRenderCommand InCommand, Noesis::RenderTarget* RenderTarget)
+{
+	if (!Recording)
+		return;
+
+	uint32 Id = GetRenderTargetId(RenderTarget);
+	uint8 Command = (uint8)InCommand;
+	*Writer << Command << Id;
+}
+
+void FNoesisRenderCapture::RecordBeginTile(Noesis::RenderTarget* RenderTarget, const Noesis::Tile& InTile)
+{
+	if (!Recording)
+		return;
+
+	uint32 Id = GetRenderTargetId(RenderTarget);
+	Noesis::Tile Tile = InTile;
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::BeginTile;
+	Ar << Command << Id << Tile.x << Tile.y << Tile.width << Tile.height;
+}
+
+void FNoesisRenderCapture::RecordResolveRenderTarget(Noesis::RenderTarget* RenderTarget, const Noesis::Tile* Tiles, uint32 NumTiles)
+{
+	if (!Recording)
+		return;
+
+	uint32 Id = GetRenderTargetId(RenderTarget);
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::ResolveRenderTarget;
+	Ar << Command << Id << NumTiles;
+	for (uint32 Index = 0; Index < NumTiles; ++Index)
+	{
+		Noesis::Tile Tile = Tiles[Index];
+		Ar << Tile.x << Tile.y << Tile.width << Tile.height;
+	}
+}
+
+void FNoesisRenderCapture::MapVertices(const void* InData, uint32 Bytes)
+{
+	MappedVertices = InData;
+	MappedVertexBytes = Bytes;
+}
+
+void FNoesisRenderCapture::RecordUnmapVertices()
+{
+	if (!Recording || MappedVertices == nullptr)
+		return;
+
+	// The contents are read back from the mapped buffer before it is unlocked
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::MapVertices;
+	Ar << Command << MappedVertexBytes;
+	Ar.Serialize(const_cast<void*>(MappedVertices), MappedVertexBytes);
+	MappedVertices = nullptr;
+}
+
+void FNoesisRenderCapture::MapIndices(const void* InData, uint32 Bytes)
+{
+	MappedIndices = InData;
+	MappedIndexBytes = Bytes;
+}
+
+void FNoesisRenderCapture::RecordUnmapIndices()
+{
+	if (!Recording || MappedIndices == nullptr)
+		return;
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::MapIndices;
+	Ar << Command << MappedIndexBytes;
+	Ar.Serialize(const_cast<void*>(MappedIndices), MappedIndexBytes);
+	MappedIndices = nullptr;
+}
+
+void FNoesisRenderCapture::RecordDrawBatch(const Noesis::Batch& Batch)
+{
+	if (!Recording)
+		return;
+
+	// Texture ids first, unknown textures add their own commands to the stream
+	uint32 TextureIds[5] =
+	{
+		GetTextureId(Batch.pattern), GetTextureId(Batch.ramps), GetTextureId(Batch.image), GetTextureId(Batch.glyphs), GetTextureId(Batch.shadow)
+	};
+	uint8 Samplers[5] = { Batch.patternSampler.v, Batch.rampsSampler.v, Batch.imageSampler.v, Batch.glyphsSampler.v, Batch.shadowSampler.v };
+	const Noesis::UniformData* Uniforms[4] = { &Batch.vertexUniforms[0], &Batch.vertexUniforms[1], &Batch.pixelUniforms[0], &Batch.pixelUniforms[1] };
+
+	FArchive& Ar = *Writer;
+	uint8 Command = (uint8)ENoesisRenderCommand::DrawBatch;
+	uint8 Shader = Batch.shader.v;
+	uint8 RenderState = Batch.renderState.v;
+	uint8 StencilRef = Batch.stencilRef;
+	uint8 SinglePassStereo = Batch.singlePassStereo ? 1 : 0;
+	uint32 VertexOffset = Batch.vertexOffset;
+	uint32 NumVertices = Batch.numVertices;
+	uint32 StartIndex = Batch.startIndex;
+	uint32 NumIndices = Batch.numIndices;
+	uint8 HasPixelShader = Batch.pixelShader != nullptr ? 1 : 0;
+	Ar << Command << Shader << RenderState << StencilRef << SinglePassStereo << VertexOffset << NumVertices << StartIndex << NumIndices;
+	for (int32 Index = 0; Index < 5; ++Index)
+	{
+		Ar << TextureIds[Index] << Samplers[Index];
+	}
+	for (const Noesis::UniformData* Uniform : Uniforms)
+	{
+		uint32 NumDwords = Uniform->values != nullptr ? Uniform->numDwords : 0;
+		uint32 Hash = Uniform->hash;
+		Ar << NumDwords << Hash;
+		Ar.Serialize(const_cast<void*>(Uniform->values), NumDwords * 4);
+	}
+	Ar << HasPixelShader;
+}
+
+// Captures are loaded from disk, so every id and size read from them is checked before it reaches the
+// device. A bad value flags the reader as failed and the replay stops at the end of the command
+static bool CanReadBytes(FArchive& Reader, uint64 Bytes)
+{
+	if (Reader.IsError() || Bytes > (uint64)(Reader.TotalSize() - Reader.Tell()))
+	{
+		Reader.SetError();
+		return false;
+	}
+	return true;
+}
+
+// Ids are assigned in sequence from 1 as objects are recorded, a new one is always the next free slot
+template<class T>
+static bool IsNextReplayId(FArchive& Reader, const TArray<Noesis::Ptr<T>>& Objects, uint32 Id)
+{
+	if (Reader.IsError() || Id == 0 || (int64)Id > FMath::Max(Objects.Num(), 1))
+	{
+		Reader.SetError();
+		return false;
+	}
+	return true;
+}
+
+static bool IsValidReplaySize(FArchive& Reader, uint32 Width, uint32 Height)
+{
+	if (Reader.IsError() || Width == 0 || Height == 0 || Width > GetMax2DTextureDimension() || Height > GetMax2DTextureDimension())
+	{
+		Reader.SetError();
+		return false;
+	}
+	return true;
+}
+
+template<class T>
+static void SetReplayObject(TArray<Noesis::Ptr<T>>& Objects, uint32 Id, Noesis::Ptr<T> Object)
+{
+	if ((int32)Id >= Objects.Num())
+	{
+		Objects.SetNum(Id + 1);
+	}
+	Objects[Id] = MoveTemp(Object);
+}
+
+template<class T>
+static T* GetReplayObject(FArchive& Reader, TArray<Noesis::Ptr<T>>& Objects, uint32 Id)
+{
+	T* Object = Objects.IsValidIndex(Id) ? Objects[Id].GetPtr() : nullptr;
+	if (Object == nullptr)
+	{
+		Reader.SetError();
+	}
+	return Object;
+}
+
+bool FNoesisRenderCapture::Replay(FRHICommandListImmediate& RHICmdList, FNoesisRenderDevice* Device, const TArray<uint8>& Data,
+	int32 Iterations, FNoesisRenderReplayResult& OutResult)
+{
+	check(IsInRenderingThread());
+	FMemoryReader Reader(Data);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 ViewportWidth = 0;
+	uint32 ViewportHeight = 0;
+	Reader << Magic << Version << ViewportWidth << ViewportHeight;
+	if (Reader.IsError() || Magic != GNoesisCaptureMagic || Version != GNoesisCaptureVersion || ViewportWidth == 0 || ViewportHeight == 0)
+		return false;
+
+	const int64 CommandsOffset = Reader.Tell();
+	TArray<uint8> Payload;
+	TArray<uint32> UniformValues[4];
+
+	// Never record a replay into a capture in progress
+	FNoesisRenderCapture* ActiveCapture = Device->Capture;
+	Device->Capture = nullptr;
+	Device->SetRHICmdList(&RHICmdList);
+	for (int32 Iteration = 0; Iteration < Iterations && !Reader.IsError(); ++Iteration)
+	{
+		TArray<Noesis::Ptr<Noesis::Texture>> Textures;
+		TArray<Noesis::Ptr<Noesis::RenderTarget>> RenderTargets;
+
+		// Onscreen commands are drawn to a render target of the size of the captured viewport
+		Noesis::Ptr<Noesis::RenderTarget> Onscreen = Device->CreateRenderTarget("Replay.Onscreen", ViewportWidth, ViewportHeight, 1, true);
+		Noesis::Tile OnscreenTile = { 0, 0, ViewportWidth, ViewportHeight };
+		uint32 ReplayVertexBytes = 0;
+		uint32 ReplayIndexBytes = 0;
+
+		Reader.Seek(CommandsOffset);
+		while (!Reader.AtEnd() && !Reader.IsError())
+		{
+			uint8 Command = 0;
+			Reader << Command;
+			if (Command >= (uint8)ENoesisRenderCommand::Count)
+			{
+				Reader.SetError();
+				break;
+			}
+
+			uint64 StartCycles = 0;
+			switch ((ENoesisRenderCommand)Command)
+			{
+				case ENoesisRenderCommand::CreateRenderTarget:
+				{
+					uint32 Id, TextureId, Width, Height, SampleCount;
+					uint8 NeedsStencil;
+					Reader << Id << TextureId << Width << Height << SampleCount << NeedsStencil;
+					if (!IsNextReplayId(Reader, RenderTargets, Id) || !IsNextReplayId(Reader, Textures, TextureId) ||
+						!IsValidReplaySize(Reader, Width, Height) || SampleCount == 0 || SampleCount > 16)
+					{
+						Reader.SetError();
+						break;
+					}
+					StartCycles = FPlatformTime::Cycles64();
+					Noesis::Ptr<Noesis::RenderTarget> RenderTarget = Device->CreateRenderTarget("Replay", Width, Height, SampleCount, NeedsStencil != 0);
+					SetReplayObject(Textures, TextureId, Noesis::Ptr<Noesis::Texture>(RenderTarget->GetTexture()));
+					SetReplayObject(RenderTargets, Id, MoveTemp(RenderTarget));
+					break;
+				}
+				case ENoesisRenderCommand::CloneRenderTarget:
+				{
+					uint32 Id, TextureId, SharedId;
+					Reader << Id << TextureId << SharedId;
+					Noesis::RenderTarget* Shared = GetReplayObject(Reader, RenderTargets, SharedId);
+					if (Shared == nullptr || !IsNextReplayId(Reader, RenderTargets, Id) || !IsNextReplayId(Reader, Textures, TextureId))
+						break;
+					StartCycles = FPlatformTime::Cycles64();
+					Noesis::Ptr<Noesis::RenderTarget> RenderTarget = Device->CloneRenderTarget("Replay", Shared);
+					SetReplayObject(Textures, TextureId, Noesis::Ptr<Noesis::Texture>(RenderTarget->GetTexture()));
+					SetReplayObject(RenderTargets, Id, MoveTemp(RenderTarget));
+					break;
+				}
+				case ENoesisRenderCommand::CreateTexture:
+				{
+					uint32 Id, Width, Height, NumLevels;
+					uint8 Format;
+					Reader << Id << Width << Height << NumLevels << Format;
+					if (!IsNextReplayId(Reader, Textures, Id) || !IsValidReplaySize(Reader, Width, Height) ||
+						NumLevels == 0 || NumLevels > (uint32)FMath::FloorLog2(FMath::Max(Width, Height)) + 1 || Format >= Noesis::TextureFormat::Count)
+					{
+						Reader.SetError();
+						break;
+					}
+					StartCycles = FPlatformTime::Cycles64();
+					SetReplayObject(Textures, Id, Device->CreateTexture("Replay", Width, Height, NumLevels, (Noesis::TextureFormat::Enum)Format, nullptr));
+					break;
+				}
+				case ENoesisRenderCommand::UpdateTexture:
+				{
+					uint32 Id, Level, X, Y, Width, Height, Bytes;
+					Reader << Id << Level << X << Y << Width << Height << Bytes;
+					Noesis::Texture* Texture = GetReplayObject(Reader, Textures, Id);
+					if (Texture == nullptr || !CanReadBytes(Reader, Bytes))
+						break;
+
+					// The region has to fit in the level and the data has to cover it, or the device reads past either
+					const uint32 LevelWidth = Level < 32 ? FMath::Max(Texture->GetWidth() >> Level, 1u) : 0;
+					const uint32 LevelHeight = Level < 32 ? FMath::Max(Texture->GetHeight() >> Level, 1u) : 0;
+					if ((uint64)X + Width > LevelWidth || (uint64)Y + Height > LevelHeight || (uint64)Width * Height * GetBytesPerPixel(Texture) != Bytes)
+					{
+						Reader.SetError();
+						break;
+					}
+					Payload.SetNumUninitialized(Bytes);
+					Reader.Serialize(Payload.GetData(), Bytes);
+					StartCycles = FPlatformTime::Cycles64();
+					Device->UpdateTexture(Texture, Level, X, Y, Width, Height, Payload.GetData());
+					break;
+				}
+				case ENoesisRenderCommand::BeginOffscreenRender:
+				{
+					StartCycles = FPlatformTime::Cycles64();
+					Device->BeginOffscreenRender();
+					break;
+				}
+				case ENoesisRenderCommand::EndOffscreenRender:
+				{
+					StartCycles = FPlatformTime::Cycles64();
+					Device->EndOffscreenRender();
+					break;
+				}
+				case ENoesisRenderCommand::BeginOnscreenRender:
+				{
+					Device->SetRenderTarget(Onscreen);
+					StartCycles = FPlatformTime::Cycles64();
+					Device->BeginOnscreenRender();
+					break;
+				}
+				case ENoesisRenderCommand::EndOnscreenRender:
+				{
+					StartCycles = FPlatformTime::Cycles64();
+					Device->EndOnscreenRender();
+					OutResult.Cycles[Command] += FPlatformTime::Cycles64() - StartCycles;
+					StartCycles = 0;
+					OutResult.Calls[Command]++;
+					if (!RHICmdList.IsInsideRenderPass())
+					{
+						Reader.SetError();
+						break;
+					}
+					Device->ResolveRenderTarget(Onscreen, &OnscreenTile, 1);
+					break;
+				}
+				case ENoesisRenderCommand::SetRenderTarget:
+				{
+					uint32 Id;
+					Reader << Id;
+					Noesis::RenderTarget* RenderTarget = GetReplayObject(Reader, RenderTargets, Id);
+					if (RenderTarget == nullptr)
+						break;
+					StartCycles = FPlatformTime::Cycles64();
+					Device->SetRenderTarget(RenderTarget);
+					break;
+				}
+				case ENoesisRenderCommand::BeginTile:
+				{
+					uint32 Id;
+					Noesis::Tile Tile;
+					Reader << Id << Tile.x << Tile.y << Tile.width << Tile.height;
+					Noesis::RenderTarget* RenderTarget = GetReplayObject(Reader, RenderTargets, Id);
+					if (RenderTarget == nullptr || !RHICmdList.IsInsideRenderPass())
+					{
+						Reader.SetError();
+						break;
+					}
+					StartCycles = FPlatformTime::Cycles64();
+					Device->BeginTile(RenderTarget, Tile);
+					break;
+				}
+				case ENoesisRenderCommand::EndTile:
+				{
+					uint32 Id;
+					Reader << Id;
+					Noesis::RenderTarget* RenderTarget = GetReplayObject(Reader, RenderTargets, Id);
+					if (RenderTarget == nullptr || !RHICmdList.IsInsideRenderPass())
+					{
+						Reader.SetError();
+						break;
+					}
+					StartCycles = FPlatformTime::Cycles64();
+					Device->EndTile(RenderTarget);
+					break;
+				}
+				case ENoesisRenderCommand::ResolveRenderTarget:
+				{
+					uint32 Id, NumTiles;
+					Reader << Id << NumTiles;
+					Noesis::RenderTarget* RenderTarget = GetReplayObject(Reader, RenderTargets, Id);
+					if (RenderTarget == nullptr || !RHICmdList.IsInsideRenderPass() || NumTiles == 0 || !CanReadBytes(Reader, (uint64)NumTiles * 4 * sizeof(uint32)))
+					{
+						Reader.SetError();
+						break;
+					}
+					TArray<Noesis::Tile, TInlineAllocator<8>> Tiles;
+					Tiles.SetNum(NumTiles);
+					for (Noesis::Tile& Tile : Tiles)
+					{
+						Reader << Tile.x << Tile.y << Tile.width << Tile.height;
+					}
+					StartCycles = FPlatformTime::Cycles64();
+					Device->ResolveRenderTarget(RenderTarget, Tiles.GetData(), NumTiles);
+					break;
+				}
+				case ENoesisRenderCommand::MapVertices:
+				case ENoesisRenderCommand::MapIndices:
+				{
+					uint32 Bytes;
+					Reader << Bytes;
+					bool Vertices = Command == (uint8)ENoesisRenderCommand::MapVertices;
+					if (Bytes == 0 || Bytes > (uint32)(Vertices ? DYNAMIC_VB_SIZE : DYNAMIC_IB_SIZE) || !CanReadBytes(Reader, Bytes))
+					{
+						Reader.SetError();
+						break;
+					}
+					Payload.SetNumUninitialized(Bytes);
+					Reader.Serialize(Payload.GetData(), Bytes);
+					uint32& MappedBytes = Vertices ? ReplayVertexBytes : ReplayIndexBytes;
+					MappedBytes = Bytes;
+					StartCycles = FPlatformTime::Cycles64();
+					if (Vertices)
+					{
+						FMemory::Memcpy(Device->MapVertices(Bytes), Payload.GetData(), Bytes);
+						Device->UnmapVertices();
+					}
+					else
+					{
+						FMemory::Memcpy(Device->MapIndices(Bytes), Payload.GetData(), Bytes);
+						Device->UnmapIndices();
+					}
+					break;
+				}
+				case ENoesisRenderCommand::DrawBatch:
+				{
+					Noesis::Batch Batch;
+					FMemory::Memzero(Batch);
+					uint8 SinglePassStereo;
+					Reader << Batch.shader.v << Batch.renderState.v << Batch.stencilRef << SinglePassStereo;
+					Reader << Batch.vertexOffset << Batch.numVertices << Batch.startIndex << Batch.numIndices;
+					Batch.singlePassStereo = SinglePassStereo != 0;
+					if (Batch.shader.v >= Noesis::Shader::Count)
+					{
+						Reader.SetError();
+						break;
+					}
+
+					// Vertices and indices are read from what the last map commands wrote
+					const uint32 VertexStride = Noesis::SizeForFormat[Noesis::FormatForVertex[Noesis::VertexForShader[Batch.shader.v]]];
+					if ((uint64)Batch.vertexOffset + (uint64)Batch.numVertices * VertexStride > ReplayVertexBytes ||
+						((uint64)Batch.startIndex + Batch.numIndices) * sizeof(uint16) > ReplayIndexBytes)
+					{
+						Reader.SetError();
+						break;
+					}
+
+					Noesis::Texture** BatchTextures[5] = { &Batch.pattern, &Batch.ramps, &Batch.image, &Batch.glyphs, &Batch.shadow };
+					Noesis::SamplerState* BatchSamplers[5] = { &Batch.patternSampler, &Batch.rampsSampler, &Batch.imageSampler, &Batch.glyphsSampler, &Batch.shadowSampler };
+					for (int32 Index = 0; Index < 5; ++Index)
+					{
+						uint32 TextureId;
+						Reader << TextureId << BatchSamplers[Index]->v;
+						*BatchTextures[Index] = TextureId != 0 ? GetReplayObject(Reader, Textures, TextureId) : nullptr;
+					}
+
+					Noesis::UniformData* BatchUniforms[4] = { &Batch.vertexUniforms[0], &Batch.vertexUniforms[1], &Batch.pixelUniforms[0], &Batch.pixelUniforms[1] };
+					for (int32 Index = 0; Index < 4; ++Index)
+					{
+						uint32 NumDwords, Hash;
+						Reader << NumDwords << Hash;
+						if (!CanReadBytes(Reader, (uint64)NumDwords * 4))
+							break;
+						UniformValues[Index].SetNumUninitialized(NumDwords);
+						Reader.Serialize(UniformValues[Index].GetData(), NumDwords * 4);
+						BatchUniforms[Index]->values = NumDwords != 0 ? UniformValues[Index].GetData() : nullptr;
+						BatchUniforms[Index]->numDwords = NumDwords;
+						BatchUniforms[Index]->hash = Hash;
+					}
+
+					// Materials are not part of the capture, their batches use the built-in shaders
+					uint8 HasPixelShader;
+					Reader << HasPixelShader;
+					if (Reader.IsError() || !RHICmdList.IsInsideRenderPass() || !Device->IsValidBatch(Batch))
+					{
+						Reader.SetError();
+						break;
+					}
+					OutResult.NumMaterialBatches += HasPixelShader;
+
+					StartCycles = FPlatformTime::Cycles64();
+					Device->DrawBatch(Batch);
+					break;
+				}
+				case ENoesisRenderCommand::EndFrame:
+				{
+					OutResult.NumFrames++;
+					break;
+				}
+			}
+
+			if (StartCycles != 0)
+			{
+				OutResult.Cycles[Command] += FPlatformTime::Cycles64() - StartCycles;
+				OutResult.Calls[Command]++;
+			}
+		}
+	}
+	if (Reader.IsError())
+	{
+		// Leave the command list as the device found it, a bad command can stop the replay in the middle of a pass
+		if (RHICmdList.IsInsideRenderPass())
+		{
+			RHICmdList.EndRenderPass();
+		}
+		RHICmdList.SetStaticUniformBuffers({});
+	}
+	Device->SetRHICmdList(nullptr);
+	Device->Capture = ActiveCapture;
+
+	return !Reader.IsError();
+}
+
+bool FNoesisRenderCapture::ReplayFile(const FString& Path, int32 Iterations)
+{
+	check(IsInGameThread());
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path))
+	{
+		UE_LOG(LogNoesis, Warning, TEXT("Can't load render capture '%s'"), *Path);
+		return false;
+	}
+
+	bool Success = false;
+	FNoesisRenderReplayResult Result;
+	ENQUEUE_RENDER_COMMAND(FNoesisRenderCapture_Replay)
+	(
+		[&Data, &Success, &Result, Iterations](FRHICommandListImmediate& RHICmdList)
+		{
+			Success = Replay(RHICmdList, FNoesisRenderDevice::Get(), Data, Iterations, Result);
+		}
+	);
+	FlushRenderingCommands();
+
+	if (!Success)
+	{
+		UE_LOG(LogNoesis, Warning, TEXT("'%s' is not a valid render capture"), *Path);
+		return false;
+	}
+
+	Result.Log(FPaths::GetBaseFilename(Path));
+	return true;
+}
+
+FString FNoesisRenderCapture::GetDefaultDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("Noesis") / TEXT("Captures");
+}
+
+void FNoesisRenderReplayResult::Log(const FString& Name) const
+{
+	uint64 TotalCycles = 0;
+	for (uint64 CommandCycles : Cycles)
+	{
+		TotalCycles += CommandCycles;
+	}
+	const double TotalMs = FPlatformTime::ToMilliseconds64(TotalCycles);
+
+	UE_LOG(LogNoesis, Display, TEXT("Render replay '%s': %u frames, %.3f ms total, %.3f ms per frame, %u material batches drawn with built-in shaders"),
+		*Name, NumFrames, TotalMs, NumFrames > 0 ? TotalMs / NumFrames : 0.0, NumMaterialBatches);
+	for (int32 Command = 0; Command < (int32)ENoesisRenderCommand::Count; ++Command)
+	{
+		if (Calls[Command] != 0)
+		{
+			const double Ms = FPlatformTime::ToMilliseconds64(Cycles[Command]);
+			UE_LOG(LogNoesis, Display, TEXT("  %-20s %8u calls %10.3f ms %8.3f us/call"), GetCommandName(Command), Calls[Command], Ms,
+				Ms * 1000.0 / Calls[Command]);
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+static FString GetCapturePath(const FString& Name)
+{
+	FString Path = FPaths::IsRelative(Name) && FPaths::GetPath(Name).IsEmpty() ? FNoesisRenderCapture::GetDefaultDirectory() / Name : Name;
+	return FPaths::GetExtension(Path).IsEmpty() ? Path + FNoesisRenderCapture::GetFileExtension() : Path;
+}
+
+static void StartRenderCapture(const TArray<FString>& Args)
+{
+	FString Name = Args.Num() > 0 ? Args[0] : FDateTime::Now().ToString();
+	uint32 NumFrames = Args.Num() > 1 ? (uint32)FMath::Max(1, FCString::Atoi(*Args[1])) : 60;
+	bool Linear = Args.Num() > 2 && FCString::Atoi(*Args[2]) != 0;
+	bool Quit = Args.Num() > 3 && FCString::Atoi(*Args[3]) != 0;
+
+	FIntPoint ViewportSize(1920, 1080);
+	if (GEngine != nullptr && GEngine->GameViewport != nullptr && GEngine->GameViewport->Viewport != nullptr)
+	{
+		ViewportSize = GEngine->GameViewport->Viewport->GetSizeXY();
+	}
+
+	FString Path = GetCapturePath(Name);
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+	UE_LOG(LogNoesis, Display, TEXT("Capturing %u frames of the %s render device to '%s'"), NumFrames, Linear ? TEXT("linear") : TEXT("sRGB"), *Path);
+
+	ENQUEUE_RENDER_COMMAND(FNoesisRenderCapture_Start)
+	(
+		[Path, NumFrames, Linear, Quit, ViewportSize](FRHICommandListImmediate& RHICmdList)
+		{
+			FNoesisRenderDevice* Device = Linear ? FNoesisRenderDevice::GetLinear() : FNoesisRenderDevice::Get();
+			FNoesisRenderCapture::Start(Device, Path, NumFrames, ViewportSize.X, ViewportSize.Y, Quit);
+		}
+	);
+}
+
+static FAutoConsoleCommand StartRenderCaptureCommand(TEXT("Noesis.RenderCapture.Start"),
+	TEXT("Records the calls to the Noesis render device. Usage: Noesis.RenderCapture.Start [Name] [Frames=60] [Linear=0] [Quit=0]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&StartRenderCapture));
+
+static void ReplayRenderCapture(const TArray<FString>& Args)
+{
+	if (Args.Num() == 0)
+	{
+		UE_LOG(LogNoesis, Display, TEXT("Usage: Noesis.RenderCapture.Replay Name [Iterations=10]"));
+		return;
+	}
+
+	int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10;
+	FNoesisRenderCapture::ReplayFile(GetCapturePath(Args[0]), Iterations);
+}
+
+static FAutoConsoleCommand ReplayRenderCaptureCommand(TEXT("Noesis.RenderCapture.Replay"),
+	TEXT("Replays a render capture and logs the CPU time of each render device call. Usage: Noesis.RenderCapture.Replay Name [Iterations=10]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ReplayRenderCapture));
+
+#endif
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Core includes
+#include "CoreMinimal.h"
+
+// Noesis includes
+#include "NoesisSDK.h"
+
+class FNoesisRenderDevice;
+class FRHICommandListImmediate;
+
+enum class ENoesisRenderCommand : uint8
+{
+	CreateRenderTarget,
+	CloneRenderTarget,
+	CreateTexture,
+	UpdateTexture,
+	BeginOffscreenRender,
+	EndOffscreenRender,
+	BeginOnscreenRender,
+	EndOnscreenRender,
+	SetRenderTarget,
+	BeginTile,
+	EndTile,
+	ResolveRenderTarget,
+	MapVertices,
+	MapIndices,
+	DrawBatch,
+	EndFrame,
+
+	Count
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// CPU time spent by the render device in each kind of call while replaying a capture
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FNoesisRenderReplayResult
+{
+	uint64 Cycles[(int32)ENoesisRenderCommand::Count] = {};
+	uint32 Calls[(int32)ENoesisRenderCommand::Count] = {};
+	uint32 NumFrames = 0;
+	uint32 NumMaterialBatches = 0;
+
+	void Log(const FString& Name) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Records the calls Noesis makes to a render device, with the contents of textures, vertices,
+/// indices and uniforms, so they can be replayed later against the device to benchmark it without
+/// the UI that produced them. Objects created before the capture starts are recorded as blank
+/// textures and render targets of the same size the first time they are used. Render thread only
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class FNoesisRenderCapture
+{
+public:
+	FNoesisRenderCapture(const FString& InPath, uint32 InNumFrames, uint32 ViewportWidth, uint32 ViewportHeight);
+
+	/// Attaches a new capture to the device, it is saved to Path after NumFrames frames. With QuitWhenSaved
+	/// the application exits once the file is written, so captures can be recorded from a script
+	static void Start(FNoesisRenderDevice* Device, const FString& Path, uint32 NumFrames, uint32 ViewportWidth, uint32 ViewportHeight,
+		bool QuitWhenSaved = false);
+
+	/// Replays the capture Iterations times against the device
+	static bool Replay(FRHICommandListImmediate& RHICmdList, FNoesisRenderDevice* Device, const TArray<uint8>& Data,
+		int32 Iterations, FNoesisRenderReplayResult& OutResult);
+
+	/// Loads a capture file, replays it on the render thread and logs the result. Game thread only
+	static bool ReplayFile(const FString& Path, int32 Iterations);
+
+	/// Saved/Noesis/Captures, where captures are written when no path is given
+	static FString GetDefaultDirectory();
+	static const TCHAR* GetFileExtension() { return TEXT(".noesiscapture"); }
+
+	void RecordCreateRenderTarget(Noesis::RenderTarget* RenderTarget, uint32 Width, uint32 Height, uint32 SampleCount, bool NeedsStencil);
+	void RecordCloneRenderTarget(Noesis::RenderTarget* RenderTarget, Noesis::RenderTarget* SharedRenderTarget);
+	void RecordCreateTexture(Noesis::Texture* Texture, uint32 Width, uint32 Height, uint32 NumLevels, Noesis::TextureFormat::Enum Format);
+	void RecordUpdateTexture(Noesis::Texture* Texture, uint32 Level, uint32 X, uint32 Y, uint32 Width, uint32 Height, const void* Data);
+	void RecordCommand(ENoesisRenderCommand Command);
+	void RecordRenderTargetCommand(ENoesisRenderCommand Command, Noesis::RenderTarget* RenderTarget);
+	void RecordBeginTile(Noesis::RenderTarget* RenderTarget, const Noesis::Tile& Tile);
+	void RecordResolveRenderTarget(Noesis::RenderTarget* RenderTarget, const Noesis::Tile* Tiles, uint32 NumTiles);
+	void MapVertices(const void* Data, uint32 Bytes);
+	void RecordUnmapVertices();
+	void MapIndices(const void* Data, uint32 Bytes);
+	void RecordUnmapIndices();
+	void RecordDrawBatch(const Noesis::Batch& Batch);
+
+private:
+	void OnEndFrame();
+	uint32 GetTextureId(Noesis::Texture* Texture);
+	uint32 GetRenderTargetId(Noesis::RenderTarget* RenderTarget);
+
+	FString Path;
+	uint32 NumFrames;
+	uint32 NumRecordedFrames = 0;
+	// Recording starts at the first frame boundary, so the capture never begins in the middle of a pass
+	bool Recording = false;
+	bool QuitWhenSaved = false;
+	TArray<uint8> Data;
+	TUniquePtr<FArchive> Writer;
+
+	TMap<const Noesis::Texture*, uint32> TextureIds;
+	TMap<const Noesis::RenderTarget*, uint32> RenderTargetIds;
+	uint32 NumTextures = 0;
+	uint32 NumRenderTargets = 0;
+
+	const void* MappedVertices = nullptr;
+	uint32 MappedVertexBytes = 0;
+	const void* MappedIndices = nullptr;
+	uint32 MappedIndexBytes = 0;
+
+	FNoesisRenderDevice* Device = nullptr;
+	FDelegateHandle EndFrameHandle;
+};
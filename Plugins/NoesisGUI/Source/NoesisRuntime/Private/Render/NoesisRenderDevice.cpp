@@ -40,7 +40,10 @@
 #include "SceneRendering.h"
 
 // NoesisRuntime includes
+#include "Render/NoesisRenderCapture.h"
+#include "Render/NoesisRenderStats.h"
 #include "Render/NoesisShaders.h"
+#include "NoesisRuntimeModule.h"
 #include "NoesisSettings.h"
 
 class FNoesisTexture : public Noesis::Texture
@@ -210,13 +213,239 @@ private:
 	TWeakObjectPtr<UMaterialInterface> MaterialPtr;
 };
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("RenderTargetAllocations"), STAT_NoesisRenderTargetAllocations, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RenderTargetPoolHits"), STAT_NoesisRenderTargetPoolHits, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RenderTargetPoolResident"), STAT_NoesisRenderTargetPoolResident, STATGROUP_Noesis);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RenderTargetPoolIdle"), STAT_NoesisRenderTargetPoolIdle, STATGROUP_Noesis);
+DECLARE_MEMORY_STAT(TEXT("RenderTargetPoolMemory"), STAT_NoesisRenderTargetPoolMemory, STATGROUP_Noesis);
+DECLARE_MEMORY_STAT(TEXT("RenderTargetPoolIdleMemory"), STAT_NoesisRenderTargetPoolIdleMemory, STATGROUP_Noesis);
+
+struct FNoesisRenderTargetDesc
+{
+	uint32 Width;
+	uint32 Height;
+	uint32 SampleCount;
+	bool IsDepthStencil;
+	bool IsLinearColor;
+
+	bool operator==(const FNoesisRenderTargetDesc& Other) const
+	{
+		return Width == Other.Width && Height == Other.Height && SampleCount == Other.SampleCount &&
+			IsDepthStencil == Other.IsDepthStencil && IsLinearColor == Other.IsLinearColor;
+	}
+};
+
+// Keeps the RHI textures of released render targets, shared by all the views of both render devices.
+// Textures are bucketed in power of two size classes and only reused for the exact same description,
+// Noesis addresses surfaces with the dimensions it requested. The resident memory, textures in use
+// plus idle ones, is kept under the budget evicting the least recently used idle textures.
+class FNoesisRenderTargetPool
+{
+public:
+	void SetBudget(uint64 InBudget)
+	{
+		FScopeLock Lock(&CriticalSection);
+		Budget = InBudget;
+		EvictIdle(0);
+	}
+
+	bool Acquire(const FNoesisRenderTargetDesc& Desc, FTextureRHIRef& OutTarget, FTextureRHIRef& OutShaderResourceTexture)
+	{
+		FScopeLock Lock(&CriticalSection);
+		TArray<FIdleTexture>& Textures = IdleTextures[GetSizeClass(Desc)];
+		for (int32 Index = Textures.Num() - 1; Index >= 0; --Index)
+		{
+			FIdleTexture& IdleTexture = Textures[Index];
+			if (IdleTexture.Desc == Desc)
+			{
+				OutTarget = MoveTemp(IdleTexture.Target);
+				OutShaderResourceTexture = MoveTemp(IdleTexture.ShaderResourceTexture);
+				IdleSize -= IdleTexture.Size;
+				NumIdle--;
+				Textures.RemoveAt(Index, 1, false);
+
+				INC_DWORD_STAT(STAT_NoesisRenderTargetPoolHits);
+				UpdateStats();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void AddAllocation(FRHITexture* Target, FRHITexture* ShaderResourceTexture)
+	{
+		FScopeLock Lock(&CriticalSection);
+		ResidentSize += ComputeSize(Target, ShaderResourceTexture);
+		NumResident++;
+
+		INC_DWORD_STAT(STAT_NoesisRenderTargetAllocations);
+		UpdateStats();
+	}
+
+	void Release(const FNoesisRenderTargetDesc& Desc, FTextureRHIRef&& Target, FTextureRHIRef&& ShaderResourceTexture, bool CanReuse)
+	{
+		FScopeLock Lock(&CriticalSection);
+		uint64 Size = ComputeSize(Target, ShaderResourceTexture);
+		if (!CanReuse || Size > Budget)
+		{
+			ResidentSize -= Size;
+			NumResident--;
+			UpdateStats();
+			return;
+		}
+
+		FIdleTexture& IdleTexture = IdleTextures[GetSizeClass(Desc)].AddDefaulted_GetRef();
+		IdleTexture.Desc = Desc;
+		IdleTexture.Target = MoveTemp(Target);
+		IdleTexture.ShaderResourceTexture = MoveTemp(ShaderResourceTexture);
+		IdleTexture.Size = Size;
+		IdleTexture.LastUsedFrame = GFrameNumberRenderThread;
+		IdleSize += Size;
+		NumIdle++;
+
+		EvictIdle(0);
+		UpdateStats();
+	}
+
+	// Frees the textures that haven't been reused for a while, so a closed menu doesn't keep its surfaces
+	void Trim()
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (LastTrimFrame != GFrameNumberRenderThread)
+		{
+			LastTrimFrame = GFrameNumberRenderThread;
+			if (GFrameNumberRenderThread > MaxIdleFrames)
+			{
+				EvictIdle(GFrameNumberRenderThread - MaxIdleFrames);
+				UpdateStats();
+			}
+		}
+	}
+
+	// Frees every idle texture and stops pooling
+	void Flush()
+	{
+		SetBudget(0);
+		UpdateStats();
+	}
+
+private:
+	struct FIdleTexture
+	{
+		FNoesisRenderTargetDesc Desc;
+		FTextureRHIRef Target;
+		FTextureRHIRef ShaderResourceTexture;
+		uint64 Size;
+		uint32 LastUsedFrame;
+	};
+
+	static constexpr int32 NumSizeClasses = 16;
+	static constexpr uint32 MaxIdleFrames = 600;
+
+	static int32 GetSizeClass(const FNoesisRenderTargetDesc& Desc)
+	{
+		return FMath::Min((int32)FMath::CeilLogTwo(FMath::Max(Desc.Width, Desc.Height)), NumSizeClasses - 1);
+	}
+
+	static uint64 ComputeSize(FRHITexture* Target, FRHITexture* ShaderResourceTexture)
+	{
+		uint64 Size = RHIComputeMemorySize(Target);
+		if (ShaderResourceTexture != nullptr && ShaderResourceTexture != Target)
+		{
+			Size += RHIComputeMemorySize(ShaderResourceTexture);
+		}
+		return Size;
+	}
+
+	// Evicts idle textures last used before the given frame, and then the least recently used ones
+	// while the resident memory is over budget
+	void EvictIdle(uint32 MinFrame)
+	{
+		while (NumIdle > 0)
+		{
+			int32 OldestClass = INDEX_NONE;
+			int32 OldestIndex = INDEX_NONE;
+			for (int32 SizeClass = 0; SizeClass < NumSizeClasses; ++SizeClass)
+			{
+				TArray<FIdleTexture>& Textures = IdleTextures[SizeClass];
+				for (int32 Index = 0; Index < Textures.Num(); ++Index)
+				{
+					if (OldestClass == INDEX_NONE || Textures[Index].LastUsedFrame < IdleTextures[OldestClass][OldestIndex].LastUsedFrame)
+					{
+						OldestClass = SizeClass;
+						OldestIndex = Index;
+					}
+				}
+			}
+
+			FIdleTexture& Oldest = IdleTextures[OldestClass][OldestIndex];
+			if (ResidentSize <= Budget && Oldest.LastUsedFrame >= MinFrame)
+				break;
+
+			ResidentSize -= Oldest.Size;
+			IdleSize -= Oldest.Size;
+			NumResident--;
+			NumIdle--;
+			IdleTextures[OldestClass].RemoveAtSwap(OldestIndex, 1, false);
+		}
+	}
+
+	void UpdateStats()
+	{
+		SET_DWORD_STAT(STAT_NoesisRenderTargetPoolResident, NumResident);
+		SET_DWORD_STAT(STAT_NoesisRenderTargetPoolIdle, NumIdle);
+		SET_MEMORY_STAT(STAT_NoesisRenderTargetPoolMemory, ResidentSize);
+		SET_MEMORY_STAT(STAT_NoesisRenderTargetPoolIdleMemory, IdleSize);
+	}
+
+	FCriticalSection CriticalSection;
+	TArray<FIdleTexture> IdleTextures[NumSizeClasses];
+	uint64 Budget = 0;
+	uint64 ResidentSize = 0;
+	uint64 IdleSize = 0;
+	int32 NumResident = 0;
+	int32 NumIdle = 0;
+	uint32 LastTrimFrame = 0;
+};
+
+static FNoesisRenderTargetPool GNoesisRenderTargetPool;
+
+// Depth stencil buffer shared by a render target and its clones, it goes back to the pool when the last
+// of them is destroyed
+struct FNoesisDepthStencilTarget
+{
+	FNoesisDepthStencilTarget(FTextureRHIRef&& InTexture)
+		: Texture(MoveTemp(InTexture))
+	{
+	}
+
+	~FNoesisDepthStencilTarget()
+	{
+		FNoesisRenderTargetDesc Desc = { Texture->GetSizeX(), Texture->GetSizeY(), Texture->GetNumSamples(), true, false };
+		GNoesisRenderTargetPool.Release(Desc, MoveTemp(Texture), nullptr, true);
+	}
+
+	FTextureRHIRef Texture;
+};
+
 class FNoesisRenderTarget : public Noesis::RenderTarget
 {
 public:
 
-	FNoesisRenderTarget(FRHITexture* InShaderResourceTexture, FRHITexture* InColorTarget, FRHITexture* InDepthStencilTarget)
-		: Texture(Noesis::MakePtr<FNoesisTexture>(InShaderResourceTexture)), ColorTarget(InColorTarget), DepthStencilTarget(InDepthStencilTarget)
+	FNoesisRenderTarget(FRHITexture* InShaderResourceTexture, FRHITexture* InColorTarget, const TSharedPtr<FNoesisDepthStencilTarget>& InDepthStencilTarget, bool InIsLinearColor)
+		: Texture(Noesis::MakePtr<FNoesisTexture>(InShaderResourceTexture)), ColorTarget(InColorTarget), DepthStencilTarget(InDepthStencilTarget),
+		IsLinearColor(InIsLinearColor)
+	{
+	}
+
+	virtual ~FNoesisRenderTarget()
 	{
+		// The textures go back to the pool unless Noesis still holds the resolve texture
+		bool CanReuse = Texture->GetNumReferences() == 1;
+		FTextureRHIRef ShaderResourceTexture = Texture->GetTexture2D();
+		Texture.Reset();
+		FNoesisRenderTargetDesc Desc = { ColorTarget->GetSizeX(), ColorTarget->GetSizeY(), ColorTarget->GetNumSamples(), false, IsLinearColor };
+		GNoesisRenderTargetPool.Release(Desc, MoveTemp(ColorTarget), MoveTemp(ShaderResourceTexture), CanReuse);
 	}
 
 	FRHITexture* GetShaderResourceTexture()
@@ -229,7 +458,7 @@ public:
 		return ColorTarget;
 	}
 
-	FRHITexture* GetDepthStencilTarget()
+	const TSharedPtr<FNoesisDepthStencilTarget>& GetDepthStencilTarget()
 	{
 		return DepthStencilTarget;
 	}
@@ -250,14 +479,14 @@ public:
 		constexpr uint8 DontLoad_Resolve = (((uint8)ERenderTargetLoadAction::ENoAction << (uint8)ERenderTargetActions::LoadOpMask) | (uint8)ERenderTargetStoreAction::EMultisampleResolve);
 		ERenderTargetActions ColorTargetActions = NeedsResolve ? (ERenderTargetActions)DontLoad_Resolve : ERenderTargetActions::DontLoad_Store;
 
-		if (DepthStencilTarget != nullptr)
+		if (DepthStencilTarget.IsValid())
 		{
-			bool HasStencil = DepthStencilTarget != nullptr;
+			bool HasStencil = DepthStencilTarget.IsValid();
 			EDepthStencilTargetActions DepthStencilTargetActions =
 				MakeDepthStencilTargetActions(ERenderTargetActions::DontLoad_DontStore, HasStencil ? ERenderTargetActions::Clear_Store : ERenderTargetActions::DontLoad_DontStore);
 
 			FRHIRenderPassInfo RPInfo(ColorTarget, ColorTargetActions, nullptr,
-				DepthStencilTarget, DepthStencilTargetActions, nullptr, FExclusiveDepthStencil::DepthNop_StencilWrite);
+				DepthStencilTarget->Texture, DepthStencilTargetActions, nullptr, FExclusiveDepthStencil::DepthNop_StencilWrite);
 
 			// There's a bug in FRHIRenderPassInfo constructors. Can't pass it there.
 			// check(!ResolveColorRT || ResolveColorRT->IsMultisampled()) should be
@@ -337,7 +566,8 @@ private:
 
 	Noesis::Ptr<FNoesisTexture> Texture;
 	FTextureRHIRef ColorTarget;
-	FTextureRHIRef DepthStencilTarget;
+	TSharedPtr<FNoesisDepthStencilTarget> DepthStencilTarget;
+	bool IsLinearColor;
 };
 
 static TShaderRef<FNoesisMaterialPSBase> GetMaterialPixelShader(const FMaterial* Material, Noesis::Shader::Enum ShaderType, bool IsLinearColor, bool GammaCorrection)
@@ -1723,6 +1953,7 @@ FNoesisRenderDevice* FNoesisRenderDevice::Get()
 		NoesisRenderDevice->SetOffscreenMaxNumSurfaces((uint32)FMath::Max(0, GetDefault<UNoesisSettings>()->OffscreenMaxSurfaces));
 		NoesisRenderDevice->SetGlyphCacheWidth(GlyphCacheWidth[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
 		NoesisRenderDevice->SetGlyphCacheHeight(GlyphCacheHeight[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
+		GNoesisRenderTargetPool.SetBudget((uint64)FMath::Max(0, GetDefault<UNoesisSettings>()->OffscreenPoolBudget) * 1024 * 1024);
 	}
 	return NoesisRenderDevice;
 }
@@ -1739,12 +1970,14 @@ FNoesisRenderDevice* FNoesisRenderDevice::GetLinear()
 		LinearNoesisRenderDevice->SetOffscreenMaxNumSurfaces((uint32)FMath::Max(0, GetDefault<UNoesisSettings>()->OffscreenMaxSurfaces));
 		LinearNoesisRenderDevice->SetGlyphCacheWidth(GlyphCacheWidth[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
 		LinearNoesisRenderDevice->SetGlyphCacheHeight(GlyphCacheHeight[(uint8)GetDefault<UNoesisSettings>()->GlyphTextureSize]);
+		GNoesisRenderTargetPool.SetBudget((uint64)FMath::Max(0, GetDefault<UNoesisSettings>()->OffscreenPoolBudget) * 1024 * 1024);
 	}
 	return LinearNoesisRenderDevice;
 }
 
 void FNoesisRenderDevice::Destroy()
 {
+	GNoesisRenderTargetPool.Flush();
 	delete NoesisRenderDevice;
 	NoesisRenderDevice = nullptr;
 	delete LinearNoesisRenderDevice;
@@ -1992,19 +2225,24 @@ static void NoesisCreateTargetableShaderResource2D(
 	}
 }
 
-static Noesis::Ptr<Noesis::RenderTarget> CreateRenderTarget(const TCHAR* Name, uint32 Width, uint32 Height, uint32 SampleCount, FRHITexture* DepthStencilTarget, bool IsLinearColor)
+static Noesis::Ptr<Noesis::RenderTarget> CreateRenderTarget(const TCHAR* Name, uint32 Width, uint32 Height, uint32 SampleCount, const TSharedPtr<FNoesisDepthStencilTarget>& DepthStencilTarget, bool IsLinearColor)
 {
-	EPixelFormat Format = PF_R8G8B8A8;
-	uint32 NumMips = 1;
-	ETextureCreateFlags Flags = IsLinearColor ? TexCreate_SRGB : TexCreate_None;
-	ETextureCreateFlags TargetableTextureFlags = TexCreate_RenderTargetable | (IsLinearColor ? TexCreate_SRGB : TexCreate_None);
-	bool bForceSeparateTargetAndShaderResource = false;
-	FClearValueBinding ClearValue;
 	FTextureRHIRef ColorTarget;
 	FTextureRHIRef ShaderResourceTexture;
-	NoesisCreateTargetableShaderResource2D(Name, Width, Height, Format, NumMips, Flags, TargetableTextureFlags, bForceSeparateTargetAndShaderResource, false, ClearValue, ColorTarget, ShaderResourceTexture, SampleCount);
+	FNoesisRenderTargetDesc Desc = { Width, Height, SampleCount, false, IsLinearColor };
+	if (!GNoesisRenderTargetPool.Acquire(Desc, ColorTarget, ShaderResourceTexture))
+	{
+		EPixelFormat Format = PF_R8G8B8A8;
+		uint32 NumMips = 1;
+		ETextureCreateFlags Flags = IsLinearColor ? TexCreate_SRGB : TexCreate_None;
+		ETextureCreateFlags TargetableTextureFlags = TexCreate_RenderTargetable | (IsLinearColor ? TexCreate_SRGB : TexCreate_None);
+		bool bForceSeparateTargetAndShaderResource = false;
+		FClearValueBinding ClearValue;
+		NoesisCreateTargetableShaderResource2D(Name, Width, Height, Format, NumMips, Flags, TargetableTextureFlags, bForceSeparateTargetAndShaderResource, false, ClearValue, ColorTarget, ShaderResourceTexture, SampleCount);
+		GNoesisRenderTargetPool.AddAllocation(ColorTarget, ShaderResourceTexture);
+	}
 
-	FNoesisRenderTarget* RenderTarget = new FNoesisRenderTarget(ShaderResourceTexture, ColorTarget, DepthStencilTarget);
+	FNoesisRenderTarget* RenderTarget = new FNoesisRenderTarget(ShaderResourceTexture, ColorTarget, DepthStencilTarget, IsLinearColor);
 
 	return Noesis::Ptr<Noesis::RenderTarget>(*RenderTarget);
 }
@@ -2015,7 +2253,9 @@ Noesis::Ptr<Noesis::RenderTarget> FNoesisRenderDevice::CreateRenderTarget(const
 	Name.Append(TEXT("Noesis.RenderTarget.")).Append(UTF8_TO_TCHAR(Label));
 	FTextureRHIRef DepthStencilTarget;
 
-	if (NeedsStencil)
+	FNoesisRenderTargetDesc DepthStencilDesc = { Width, Height, SampleCount, true, false };
+	FTextureRHIRef Unused;
+	if (NeedsStencil && !GNoesisRenderTargetPool.Acquire(DepthStencilDesc, DepthStencilTarget, Unused))
 	{
 		TStringBuilder<64> DSName;
 		DSName.Append(*Name).Append(TEXT("_DS"));
@@ -2040,9 +2280,22 @@ Noesis::Ptr<Noesis::RenderTarget> FNoesisRenderDevice::CreateRenderTarget(const
 		DepthStencilTarget = RHICreateTexture(DepthStencilTargetDesc);
 #endif
 		NOESIS_BIND_DEBUG_TEXTURE_LABEL(DepthStencilTarget, *DSName);
+		GNoesisRenderTargetPool.AddAllocation(DepthStencilTarget, nullptr);
 	}
 
-	return ::CreateRenderTarget(*Name, Width, Height, SampleCount, DepthStencilTarget, IsLinearColor);
+	TSharedPtr<FNoesisDepthStencilTarget> SharedDepthStencilTarget;
+	if (DepthStencilTarget != nullptr)
+	{
+		SharedDepthStencilTarget = MakeShared<FNoesisDepthStencilTarget>(MoveTemp(DepthStencilTarget));
+	}
+
+	Noesis::Ptr<Noesis::RenderTarget> RenderTarget = ::CreateRenderTarget(*Name, Width, Height, SampleCount, SharedDepthStencilTarget, IsLinearColor);
+	if (Capture != nullptr)
+	{
+		Capture->RecordCreateRenderTarget(RenderTarget, Width, Height, SampleCount, NeedsStencil);
+	}
+
+	return RenderTarget;
 }
 
 Noesis::Ptr<Noesis::RenderTarget> FNoesisRenderDevice::CloneRenderTarget(const char* Label, Noesis::RenderTarget* InSharedRenderTarget)
@@ -2055,9 +2308,15 @@ Noesis::Ptr<Noesis::RenderTarget> FNoesisRenderDevice::CloneRenderTarget(const c
 	uint32 Width = ColorTarget->GetSizeX();
 	uint32 Height = ColorTarget->GetSizeY();
 	uint32 SampleCount = ColorTarget->GetNumSamples();
-	FRHITexture* DepthStencilTarget = SharedRenderTarget->GetDepthStencilTarget();
+	const TSharedPtr<FNoesisDepthStencilTarget>& DepthStencilTarget = SharedRenderTarget->GetDepthStencilTarget();
 
-	return ::CreateRenderTarget(*Name, Width, Height, SampleCount, DepthStencilTarget, IsLinearColor);
+	Noesis::Ptr<Noesis::RenderTarget> RenderTarget = ::CreateRenderTarget(*Name, Width, Height, SampleCount, DepthStencilTarget, IsLinearColor);
+	if (Capture != nullptr)
+	{
+		Capture->RecordCloneRenderTarget(RenderTarget, InSharedRenderTarget);
+	}
+
+	return RenderTarget;
 }
 
 Noesis::Ptr<Noesis::Texture> FNoesisRenderDevice::CreateTexture(const char* Label, uint32 Width, uint32 Height, uint32 NumLevels, Noesis::TextureFormat::Enum TextureFormat, const void** Data)
@@ -2089,6 +2348,12 @@ Noesis::Ptr<Noesis::Texture> FNoesisRenderDevice::CreateTexture(const char* Labe
 
 	Noesis::Ptr<FNoesisTexture> Texture = Noesis::MakePtr<FNoesisTexture>(ShaderResourceTexture);
 
+	// The initial contents are captured by the UpdateTexture calls below
+	if (Capture != nullptr)
+	{
+		Capture->RecordCreateTexture(Texture, Width, Height, NumLevels, TextureFormat);
+	}
+
 	if (Data != nullptr)
 	{
 		for (uint32 Level = 0; Level < NumMips; ++Level)
@@ -2106,6 +2371,11 @@ void FNoesisRenderDevice::UpdateTexture(Noesis::Texture* InTexture, uint32 Level
 {
 	FNoesisTexture* Texture = (FNoesisTexture*)InTexture;
 
+	if (Capture != nullptr)
+	{
+		Capture->RecordUpdateTexture(InTexture, Level, X, Y, Width, Height, Data);
+	}
+
 	int32 MipIndex = (int32)Level;
 	FUpdateTextureRegion2D UpdateRegion;
 	UpdateRegion.SrcX = 0;
@@ -2122,6 +2392,13 @@ void FNoesisRenderDevice::UpdateTexture(Noesis::Texture* InTexture, uint32 Level
 
 void FNoesisRenderDevice::BeginOffscreenRender()
 {
+	if (Capture != nullptr)
+	{
+		Capture->RecordCommand(ENoesisRenderCommand::BeginOffscreenRender);
+	}
+
+	GNoesisRenderTargetPool.Trim();
+
 	FUniformBufferStaticBindings StaticUniformBufferBindings;
 	StaticUniformBufferBindings.TryAddUniformBuffer(SceneTexturesUniformBuffer);
 	StaticUniformBufferBindings.TryAddUniformBuffer(MobileSceneTexturesUniformBuffer);
@@ -2131,11 +2408,21 @@ void FNoesisRenderDevice::BeginOffscreenRender()
 
 void FNoesisRenderDevice::EndOffscreenRender()
 {
+	if (Capture != nullptr)
+	{
+		Capture->RecordCommand(ENoesisRenderCommand::EndOffscreenRender);
+	}
+
 	RHICmdList->SetStaticUniformBuffers({});
 }
 
 void FNoesisRenderDevice::BeginOnscreenRender()
 {
+	if (Capture != nullptr)
+	{
+		Capture->RecordCommand(ENoesisRenderCommand::BeginOnscreenRender);
+	}
+
 	FUniformBufferStaticBindings StaticUniformBufferBindings;
 	StaticUniformBufferBindings.TryAddUniformBuffer(SceneTexturesUniformBuffer);
 	StaticUniformBufferBindings.TryAddUniformBuffer(MobileSceneTexturesUniformBuffer);
@@ -2145,12 +2432,22 @@ void FNoesisRenderDevice::BeginOnscreenRender()
 
 void FNoesisRenderDevice::EndOnscreenRender()
 {
+	if (Capture != nullptr)
+	{
+		Capture->RecordCommand(ENoesisRenderCommand::EndOnscreenRender);
+	}
+
 	RHICmdList->SetStaticUniformBuffers({});
 }
 
 void FNoesisRenderDevice::SetRenderTarget(Noesis::RenderTarget* Surface)
 {
 	check(RHICmdList);
+	if (Capture != nullptr)
+	{
+		Capture->RecordRenderTargetCommand(ENoesisRenderCommand::SetRenderTarget, Surface);
+	}
+
 #if UE_VERSION_OLDER_THAN(5, 5, 0)
 #if WANTS_DRAW_MESH_EVENTS
 	BEGIN_DRAW_EVENTF(*RHICmdList, SetRenderTarget, SetRenderTargetEvent, TEXT("SetRenderTarget"));
@@ -2187,6 +2484,11 @@ void FNoesisRenderDevice::SetRenderTarget(Noesis::RenderTarget* Surface)
 void FNoesisRenderDevice::BeginTile(Noesis::RenderTarget* Surface, const Noesis::Tile& Tile)
 {
 	check(RHICmdList);
+	if (Capture != nullptr)
+	{
+		Capture->RecordBeginTile(Surface, Tile);
+	}
+
 	FNoesisRenderTarget* RenderTarget = (FNoesisRenderTarget*)Surface;
 	RenderTarget->BeginTile(RHICmdList, Tile);
 }
@@ -2194,6 +2496,11 @@ void FNoesisRenderDevice::BeginTile(Noesis::RenderTarget* Surface, const Noesis:
 void FNoesisRenderDevice::EndTile(Noesis::RenderTarget* Surface)
 {
 	check(RHICmdList);
+	if (Capture != nullptr)
+	{
+		Capture->RecordRenderTargetCommand(ENoesisRenderCommand::EndTile, Surface);
+	}
+
 	FNoesisRenderTarget* RenderTarget = (FNoesisRenderTarget*)Surface;
 	RenderTarget->EndTile(RHICmdList);
 }
@@ -2202,6 +2509,11 @@ void FNoesisRenderDevice::ResolveRenderTarget(Noesis::RenderTarget* Surface, con
 {
 	check(RHICmdList);
 	check(RHICmdList->IsInsideRenderPass());
+	if (Capture != nullptr)
+	{
+		Capture->RecordResolveRenderTarget(Surface, Tiles, NumTiles);
+	}
+
 	SCOPED_DRAW_EVENT(*RHICmdList, Resolve);
 	FNoesisRenderTarget* RenderTarget = (FNoesisRenderTarget*)Surface;
 	RenderTarget->ResolveRenderTarget(RHICmdList, Tiles, NumTiles);
@@ -2229,11 +2541,20 @@ void* FNoesisRenderDevice::MapVertices(uint32 Bytes)
 #else
 	void* Result = RHICmdList->LockBuffer(DynamicVertexBuffer, 0, Bytes, RLM_WriteOnly);
 #endif
+	if (Capture != nullptr)
+	{
+		Capture->MapVertices(Result, Bytes);
+	}
 	return Result;
 }
 
 void FNoesisRenderDevice::UnmapVertices()
 {
+	if (Capture != nullptr)
+	{
+		Capture->RecordUnmapVertices();
+	}
+
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
 	RHIUnlockVertexBuffer(DynamicVertexBuffer);
 #elif UE_VERSION_OLDER_THAN(5, 3, 0)
@@ -2252,11 +2573,20 @@ void* FNoesisRenderDevice::MapIndices(uint32 Bytes)
 #else
 	void* Result = RHICmdList->LockBuffer(DynamicIndexBuffer, 0, Bytes, RLM_WriteOnly);
 #endif
+	if (Capture != nullptr)
+	{
+		Capture->MapIndices(Result, Bytes);
+	}
 	return Result;
 }
 
 void FNoesisRenderDevice::UnmapIndices()
 {
+	if (Capture != nullptr)
+	{
+		Capture->RecordUnmapIndices();
+	}
+
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
 	RHIUnlockIndexBuffer(DynamicIndexBuffer);
 #elif UE_VERSION_OLDER_THAN(5, 3, 0)
@@ -2506,9 +2836,41 @@ static inline bool ConditionalUpdateUniformBuffer(FRHICommandList* RHICmdList, F
 	return true;
 }
 
+static inline bool UniformDataFits(const FUniformBufferRHIRef* UniformBuffer, const Noesis::UniformData& UniformData)
+{
+	if (UniformData.values == nullptr)
+		return true;
+
+	return UniformBuffer != nullptr && UniformBuffer->IsValid() && UniformData.numDwords * 4 <= (*UniformBuffer)->GetLayout().ConstantBufferSize;
+}
+
+bool FNoesisRenderDevice::IsValidBatch(const Noesis::Batch& Batch) const
+{
+	if (Batch.shader.v >= Noesis::Shader::Count || Batch.renderState.f.blendMode >= Noesis::BlendMode::Count ||
+		Batch.renderState.f.stencilMode >= Noesis::StencilMode::Count)
+		return false;
+
+	const Noesis::SamplerState Samplers[] = { Batch.patternSampler, Batch.rampsSampler, Batch.imageSampler, Batch.glyphsSampler, Batch.shadowSampler };
+	for (Noesis::SamplerState Sampler : Samplers)
+	{
+		if (Sampler.v >= UE_ARRAY_COUNT(SamplerStates))
+			return false;
+	}
+
+	return UniformDataFits(Batch.singlePassStereo ? &VSConstantBufferStereo : &VSConstantBuffer, Batch.vertexUniforms[0]) &&
+		UniformDataFits(&TextureSizeBuffer, Batch.vertexUniforms[1]) &&
+		UniformDataFits(PixelShaderConstantBuffer0[Batch.shader.v], Batch.pixelUniforms[0]) &&
+		UniformDataFits(PixelShaderConstantBuffer1[Batch.shader.v], Batch.pixelUniforms[1]);
+}
+
 void FNoesisRenderDevice::DrawBatch(const Noesis::Batch& Batch)
 {
 	check(RHICmdList);
+	if (Capture != nullptr)
+	{
+		Capture->RecordDrawBatch(Batch);
+	}
+
 	FGraphicsPipelineStateInitializer GraphicsPSOInit;
 	RHICmdList->ApplyCachedRenderTargets(GraphicsPSOInit);
 
@@ -2687,5 +3049,10 @@ void FNoesisRenderDevice::DrawBatch(const Noesis::Batch& Batch)
 	RHICmdList->SetStencilRef(Batch.stencilRef);
 	RHICmdList->SetStreamSource(0, DynamicVertexBuffer, Batch.vertexOffset);
 
+	if (RenderStats != nullptr)
+	{
+		RenderStats->AddBatch(ShaderCode, Batch.numIndices / 3 * NumInstances, UsingMaterialShader, UsingCustomEffect);
+	}
+
 	RHICmdList->DrawIndexedPrimitive(DynamicIndexBuffer, 0, 0, Batch.numVertices, Batch.startIndex, Batch.numIndices / 3, NumInstances);
 }
@@ -40,6 +40,9 @@
 	#define NOESIS_BIND_DEBUG_BUFFER_LABEL(Buffer, Name) NOESIS_BIND_DEBUG_LABEL(Buffer, Name)
 #endif
 
+class FNoesisRenderStats;
+class FNoesisRenderCapture;
+
 class FNoesisRenderDevice : public Noesis::RenderDevice
 {
 #if UE_VERSION_OLDER_THAN(5, 0, 0)
@@ -84,6 +87,8 @@ public:
 	FSceneViewFamily* ViewFamily = nullptr;
 	FViewInfo* View = nullptr;
 	FSceneInterface* Scene = nullptr;
+	FNoesisRenderStats* RenderStats = nullptr;
+	FNoesisRenderCapture* Capture = nullptr;
 	uint32 ViewLeft, ViewTop, ViewRight, ViewBottom;
 	bool IsWorldUI = false;
 	bool IsLinearColor = false;
@@ -130,6 +135,10 @@ public:
 	void SetWorldTime(FGameTime InWorldTime);
 	void SetScene(FSceneInterface* InScene);
 	void SetGammaAndContrast(float InGamma, float InContrast) { Gamma = InGamma; Contrast = InContrast; }
+	void SetRenderStats(FNoesisRenderStats* InRenderStats) { RenderStats = InRenderStats; }
+
+	// Checks the states and uniforms of a batch that doesn't come from Noesis, like a replayed one, fit the device
+	bool IsValidBatch(const Noesis::Batch& Batch) const;
 
 	void CreateView(uint32 Left, uint32 Top, uint32 Right, uint32 Bottom, const FIntRect& ViewRect, const FMatrix& ViewProjectionMatrix);
 	void DestroyView();
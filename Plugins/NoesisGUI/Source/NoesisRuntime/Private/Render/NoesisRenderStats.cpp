@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NoesisRenderStats.h"
+
+// Core includes
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+// Engine includes
+#include "Debug/DebugDrawService.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+
+// RHI includes
+#include "RHICommandList.h"
+
+// RenderCore includes
+#include "RenderingThread.h"
+
+// NoesisRuntime includes
+#include "NoesisRuntimeModule.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("DrawCalls"), STAT_NoesisDrawCalls, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Triangles"), STAT_NoesisTriangles, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("MaterialBatches"), STAT_NoesisMaterialBatches, STATGROUP_Noesis);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CustomEffectBatches"), STAT_NoesisCustomEffectBatches, STATGROUP_Noesis);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("GPUTime (ms)"), STAT_NoesisGPUTime, STATGROUP_Noesis);
+
+static TAutoConsoleVariable<int32> CVarNoesisRenderStatsGPUTiming(
+	TEXT("Noesis.RenderStats.GPUTiming"),
+	1,
+	TEXT("Measures the GPU time of every view with timestamp queries."),
+	ECVF_RenderThreadSafe);
+
+// Timestamps are read back once the GPU is done with them, so never before this many frames
+static const uint64 GNoesisQueryLatency = 3;
+// Stop issuing queries for a view if the RHI doesn't resolve them
+static const int32 GNoesisMaxPendingQueries = 64;
+// Views not rendered in this many frames are left out of the overlay
+static const uint64 GNoesisStaleFrames = 30;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Last results of every view, written by the render thread and read by the game thread
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FNoesisRenderStatsSnapshot
+{
+	FString Name;
+	uint64 FrameNumber = 0;
+	FNoesisRenderStats::FFrame Frame;
+	float GPUTimeMs = -1.0f;
+};
+
+static FCriticalSection GNoesisRenderStatsLock;
+static TMap<const FNoesisRenderStats*, FNoesisRenderStatsSnapshot> GNoesisRenderStatsSnapshots;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+FNoesisRenderStats::FNoesisRenderStats(const FString& InName)
+	: Name(InName)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+FNoesisRenderStats::~FNoesisRenderStats()
+{
+	FScopeLock Lock(&GNoesisRenderStatsLock);
+	GNoesisRenderStatsSnapshots.Remove(this);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisRenderStats::BeginScope(FRHICommandList& RHICmdList)
+{
+	check(IsInRenderingThread());
+	if (FrameNumber != GFrameCounterRenderThread)
+	{
+		BeginFrame(GFrameCounterRenderThread);
+	}
+
+	if (GSupportsTimestampRenderQueries && CVarNoesisRenderStatsGPUTiming.GetValueOnRenderThread() != 0 &&
+		PendingQueries.Num() < GNoesisMaxPendingQueries)
+	{
+		ScopeBegin = FreeQueries.Num() > 0 ? FreeQueries.Pop(false) : RHICreateRenderQuery(RQT_AbsoluteTime);
+		RHICmdList.EndRenderQuery(ScopeBegin);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisRenderStats::EndScope(FRHICommandList& RHICmdList)
+{
+	if (ScopeBegin.IsValid())
+	{
+		FRenderQueryRHIRef ScopeEnd = FreeQueries.Num() > 0 ? FreeQueries.Pop(false) : RHICreateRenderQuery(RQT_AbsoluteTime);
+		RHICmdList.EndRenderQuery(ScopeEnd);
+		PendingQueries.Add({ MoveTemp(ScopeBegin), MoveTemp(ScopeEnd), FrameNumber });
+		ScopeBegin.SafeRelease();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisRenderStats::AddBatch(Noesis::Shader::Enum Shader, uint32 NumTriangles, bool IsMaterial, bool IsCustomEffect)
+{
+	Frame.DrawCalls++;
+	Frame.Triangles += NumTriangles;
+	Frame.ShaderBatches[Shader]++;
+
+	INC_DWORD_STAT(STAT_NoesisDrawCalls);
+	INC_DWORD_STAT_BY(STAT_NoesisTriangles, NumTriangles);
+
+	if (IsCustomEffect)
+	{
+		Frame.CustomEffectBatches++;
+		INC_DWORD_STAT(STAT_NoesisCustomEffectBatches);
+	}
+	else if (IsMaterial)
+	{
+		Frame.MaterialBatches++;
+		INC_DWORD_STAT(STAT_NoesisMaterialBatches);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisRenderStats::BeginFrame(uint64 InFrameNumber)
+{
+	if (FrameNumber != 0)
+	{
+		FScopeLock Lock(&GNoesisRenderStatsLock);
+		FNoesisRenderStatsSnapshot& Snapshot = GNoesisRenderStatsSnapshots.FindOrAdd(this);
+		Snapshot.Name = Name;
+		Snapshot.FrameNumber = FrameNumber;
+		Snapshot.Frame = Frame;
+	}
+
+	Frame = FFrame();
+	FrameNumber = InFrameNumber;
+
+	ResolveQueries();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisRenderStats::ResolveQueries()
+{
+	// Queries are kept in frame order, a frame is complete once all its queries are resolved
+	int32 NumResolved = 0;
+	for (; NumResolved < PendingQueries.Num(); ++NumResolved)
+	{
+		FTimerQuery& Query = PendingQueries[NumResolved];
+		if (Query.FrameNumber + GNoesisQueryLatency > FrameNumber)
+			break;
+
+		uint64 BeginTime = 0;
+		uint64 EndTime = 0;
+		if (!RHIGetRenderQueryResult(Query.Begin, BeginTime, false) || !RHIGetRenderQueryResult(Query.End, EndTime, false))
+			break;
+
+		if (Query.FrameNumber != ResolvingFrameNumber)
+		{
+			if (ResolvingFrameNumber != 0)
+			{
+				PublishGPUTime(ResolvingMicroseconds);
+			}
+			ResolvingFrameNumber = Query.FrameNumber;
+			ResolvingMicroseconds = 0;
+		}
+
+		ResolvingMicroseconds += EndTime > BeginTime ? EndTime - BeginTime : 0;
+		FreeQueries.Add(MoveTemp(Query.Begin));
+		FreeQueries.Add(MoveTemp(Query.End));
+	}
+	PendingQueries.RemoveAt(0, NumResolved, false);
+
+	if (ResolvingFrameNumber != 0 && (PendingQueries.Num() == 0 || PendingQueries[0].FrameNumber != ResolvingFrameNumber))
+	{
+		PublishGPUTime(ResolvingMicroseconds);
+		ResolvingFrameNumber = 0;
+		ResolvingMicroseconds = 0;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void FNoesisRenderStats::PublishGPUTime(uint64 Microseconds)
+{
+	float GPUTimeMs = Microseconds / 1000.0f;
+	INC_FLOAT_STAT_BY(STAT_NoesisGPUTime, GPUTimeMs);
+
+	FScopeLock Lock(&GNoesisRenderStatsLock);
+	GNoesisRenderStatsSnapshots.FindOrAdd(this).GPUTimeMs = GPUTimeMs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const TCHAR* FNoesisRenderStats::GetShaderName(Noesis::Shader::Enum Shader)
+{
+	static const TCHAR* Names[] =
+	{
+		TEXT("RGBA"), TEXT("Mask"), TEXT("Clear"),
+		TEXT("Path_Solid"), TEXT("Path_Linear"), TEXT("Path_Radial"), TEXT("Path_Pattern"), TEXT("Path_Pattern_Clamp"),
+		TEXT("Path_Pattern_Repeat"), TEXT("Path_Pattern_MirrorU"), TEXT("Path_Pattern_MirrorV"), TEXT("Path_Pattern_Mirror"),
+		TEXT("Path_AA_Solid"), TEXT("Path_AA_Linear"), TEXT("Path_AA_Radial"), TEXT("Path_AA_Pattern"), TEXT("Path_AA_Pattern_Clamp"),
+		TEXT("Path_AA_Pattern_Repeat"), TEXT("Path_AA_Pattern_MirrorU"), TEXT("Path_AA_Pattern_MirrorV"), TEXT("Path_AA_Pattern_Mirror"),
+		TEXT("SDF_Solid"), TEXT("SDF_Linear"), TEXT("SDF_Radial"), TEXT("SDF_Pattern"), TEXT("SDF_Pattern_Clamp"),
+		TEXT("SDF_Pattern_Repeat"), TEXT("SDF_Pattern_MirrorU"), TEXT("SDF_Pattern_MirrorV"), TEXT("SDF_Pattern_Mirror"),
+		TEXT("SDF_LCD_Solid"), TEXT("SDF_LCD_Linear"), TEXT("SDF_LCD_Radial"), TEXT("SDF_LCD_Pattern"), TEXT("SDF_LCD_Pattern_Clamp"),
+		TEXT("SDF_LCD_Pattern_Repeat"), TEXT("SDF_LCD_Pattern_MirrorU"), TEXT("SDF_LCD_Pattern_MirrorV"), TEXT("SDF_LCD_Pattern_Mirror"),
+		TEXT("Opacity_Solid"), TEXT("Opacity_Linear"), TEXT("Opacity_Radial"), TEXT("Opacity_Pattern"), TEXT("Opacity_Pattern_Clamp"),
+		TEXT("Opacity_Pattern_Repeat"), TEXT("Opacity_Pattern_MirrorU"), TEXT("Opacity_Pattern_MirrorV"), TEXT("Opacity_Pattern_Mirror"),
+		TEXT("Upsample"), TEXT("Downsample"), TEXT("Shadow"), TEXT("Blur"), TEXT("Custom_Effect")
+	};
+	static_assert(UE_ARRAY_COUNT(Names) == Noesis::Shader::Count, "Shader names out of sync with Noesis::Shader::Enum");
+
+	return (uint32)Shader < (uint32)Noesis::Shader::Count ? Names[Shader] : TEXT("Unknown");
+}
+
+#if !UE_BUILD_SHIPPING
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static TArray<FNoesisRenderStatsSnapshot> GetRankedSnapshots(bool OnlyRecent)
+{
+	TArray<FNoesisRenderStatsSnapshot> Snapshots;
+	{
+		FScopeLock Lock(&GNoesisRenderStatsLock);
+		for (const auto& Pair : GNoesisRenderStatsSnapshots)
+		{
+			if (!OnlyRecent || Pair.Value.FrameNumber + GNoesisStaleFrames >= GFrameCounter)
+			{
+				Snapshots.Add(Pair.Value);
+			}
+		}
+	}
+
+	// Without GPU timings views are ranked by the work they submit
+	Snapshots.Sort([](const FNoesisRenderStatsSnapshot& A, const FNoesisRenderStatsSnapshot& B)
+	{
+		if (A.GPUTimeMs != B.GPUTimeMs)
+			return A.GPUTimeMs > B.GPUTimeMs;
+		return A.Frame.Triangles > B.Frame.Triangles;
+	});
+
+	return Snapshots;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static FString GetTopShaders(const FNoesisRenderStats::FFrame& Frame, int32 MaxShaders)
+{
+	TArray<TPair<uint32, int32>> Shaders;
+	for (int32 Shader = 0; Shader < Noesis::Shader::Count; ++Shader)
+	{
+		if (Frame.ShaderBatches[Shader] != 0)
+		{
+			Shaders.Emplace(Frame.ShaderBatches[Shader], Shader);
+		}
+	}
+	Shaders.Sort([](const TPair<uint32, int32>& A, const TPair<uint32, int32>& B) { return A.Key > B.Key; });
+
+	FString Result;
+	for (int32 Index = 0; Index < Shaders.Num() && (MaxShaders <= 0 || Index < MaxShaders); ++Index)
+	{
+		Result += FString::Printf(TEXT("%s%s %u"), Index > 0 ? TEXT(", ") : TEXT(""),
+			FNoesisRenderStats::GetShaderName((Noesis::Shader::Enum)Shaders[Index].Value), Shaders[Index].Key);
+	}
+	return Result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static FString FormatSnapshot(const FNoesisRenderStatsSnapshot& Snapshot)
+{
+	FString GPUTime = Snapshot.GPUTimeMs >= 0.0f ? FString::Printf(TEXT("%.3f ms"), Snapshot.GPUTimeMs) : TEXT("n/a");
+	return FString::Printf(TEXT("%s: GPU %s, %u draws, %u triangles, %u material, %u custom effect"), *Snapshot.Name,
+		*GPUTime, Snapshot.Frame.DrawCalls, Snapshot.Frame.Triangles, Snapshot.Frame.MaterialBatches, Snapshot.Frame.CustomEffectBatches);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void DrawRenderStatsOverlay(UCanvas* Canvas, APlayerController*)
+{
+	const int32 MaxRows = 10;
+	UFont* Font = GEngine->GetSmallFont();
+	float X = 50.0f;
+	float Y = 50.0f;
+
+	TArray<FNoesisRenderStatsSnapshot> Snapshots = GetRankedSnapshots(true);
+	Canvas->SetDrawColor(FColor::Yellow);
+	Y += Canvas->DrawText(Font, FString::Printf(TEXT("Noesis views by GPU cost (%d rendered)"), Snapshots.Num()), X, Y);
+
+	for (int32 Index = 0; Index < Snapshots.Num() && Index < MaxRows; ++Index)
+	{
+		const FNoesisRenderStatsSnapshot& Snapshot = Snapshots[Index];
+		Canvas->SetDrawColor(Index == 0 ? FColor::Orange : FColor::White);
+		Y += Canvas->DrawText(Font, FString::Printf(TEXT("%d. %s"), Index + 1, *FormatSnapshot(Snapshot)), X, Y);
+		Canvas->SetDrawColor(FColor::Silver);
+		Y += Canvas->DrawText(Font, FString::Printf(TEXT("     %s"), *GetTopShaders(Snapshot.Frame, 4)), X, Y);
+	}
+}
+
+static FDelegateHandle GNoesisRenderStatsOverlayHandle;
+
+static TAutoConsoleVariable<int32> CVarNoesisRenderStatsOverlay(
+	TEXT("Noesis.RenderStats.Overlay"),
+	0,
+	TEXT("Shows on screen the Noesis views ranked by GPU time, with their draw calls, triangles and batches per shader."),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable* Variable)
+	{
+		if (Variable->GetInt() != 0 && !GNoesisRenderStatsOverlayHandle.IsValid())
+		{
+			GNoesisRenderStatsOverlayHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateStatic(&DrawRenderStatsOverlay));
+		}
+		else if (Variable->GetInt() == 0 && GNoesisRenderStatsOverlayHandle.IsValid())
+		{
+			UDebugDrawService::Unregister(GNoesisRenderStatsOverlayHandle);
+			GNoesisRenderStatsOverlayHandle.Reset();
+		}
+	}));
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static void DumpRenderStats()
+{
+	TArray<FNoesisRenderStatsSnapshot> Snapshots = GetRankedSnapshots(false);
+	UE_LOG(LogNoesis, Display, TEXT("Noesis render stats, %d views"), Snapshots.Num());
+	for (const FNoesisRenderStatsSnapshot& Snapshot : Snapshots)
+	{
+		UE_LOG(LogNoesis, Display, TEXT("  %s (frame %llu)"), *FormatSnapshot(Snapshot), Snapshot.FrameNumber);
+		UE_LOG(LogNoesis, Display, TEXT("    %s"), *GetTopShaders(Snapshot.Frame, 0));
+	}
+}
+
+static FAutoConsoleCommand DumpRenderStatsCommand(TEXT("Noesis.RenderStats.Dump"),
+	TEXT("Logs the GPU time, draw calls, triangles and batches per shader of every Noesis view"),
+	FConsoleCommandDelegate::CreateStatic(&DumpRenderStats));
+
+#endif
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Core includes
+#include "CoreMinimal.h"
+
+// RHI includes
+#include "RHI.h"
+#include "RHIResources.h"
+
+// Noesis includes
+#include "NoesisSDK.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Render statistics of a single view. The render device feeds it every batch drawn while the view
+/// is being rendered, and the GPU time of its passes is measured with timestamp queries that are
+/// read back a few frames later, without waiting. Totals are shown in 'stat Noesis', the ranking
+/// of views in the overlay enabled with Noesis.RenderStats.Overlay. Only used on the render thread
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class FNoesisRenderStats
+{
+public:
+	struct FFrame
+	{
+		uint32 DrawCalls = 0;
+		uint32 Triangles = 0;
+		uint32 MaterialBatches = 0;
+		uint32 CustomEffectBatches = 0;
+		uint32 ShaderBatches[Noesis::Shader::Count] = {};
+	};
+
+	FNoesisRenderStats(const FString& InName);
+	~FNoesisRenderStats();
+
+	/// Brackets the commands the view records into RHICmdList, offscreen and onscreen
+	void BeginScope(FRHICommandList& RHICmdList);
+	void EndScope(FRHICommandList& RHICmdList);
+
+	void AddBatch(Noesis::Shader::Enum Shader, uint32 NumTriangles, bool IsMaterial, bool IsCustomEffect);
+
+	static const TCHAR* GetShaderName(Noesis::Shader::Enum Shader);
+
+private:
+	void BeginFrame(uint64 FrameNumber);
+	void ResolveQueries();
+	void PublishGPUTime(uint64 Microseconds);
+
+	struct FTimerQuery
+	{
+		FRenderQueryRHIRef Begin;
+		FRenderQueryRHIRef End;
+		uint64 FrameNumber;
+	};
+
+	FString Name;
+	FFrame Frame;
+	uint64 FrameNumber = 0;
+
+	TArray<FTimerQuery> PendingQueries;
+	TArray<FRenderQueryRHIRef> FreeQueries;
+	FRenderQueryRHIRef ScopeBegin;
+	uint64 ResolvingFrameNumber = 0;
+	uint64 ResolvingMicroseconds = 0;
+};
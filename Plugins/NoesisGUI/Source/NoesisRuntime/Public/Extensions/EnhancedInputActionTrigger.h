@@ -70,9 +70,9 @@ private:
 
 private:
     UNoesisInstance* mInstance = nullptr;
-    uint32 InputBindingHandle = 0;
+    const class UInputAction* mRegisteredAction = nullptr;
+    ETriggerEvent mRegisteredEvent = ETriggerEvent::None;
 
-    friend class UNoesisEnhancedInputDelegateHandler;
 
     NS_DECLARE_REFLECTION(EnhancedInputActionTrigger, NoesisApp::TriggerBaseT<Noesis::FrameworkElement>)
 };
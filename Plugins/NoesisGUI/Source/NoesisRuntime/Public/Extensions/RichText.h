@@ -95,6 +95,14 @@ struct NOESISRUNTIME_API RichText
         Noesis::ArrayRef<Parameter> parameters, const Noesis::TextBlock* parent);
     static void SetTryCreateInlineCallback(TryCreateInlineCallback callback);
 
+    /// When the new *Text* only appends to the previous one, the existing Inlines are kept and just
+    /// the tail of the markup is parsed. Enabled by default
+    static void SetIncrementalParsing(bool enable);
+
+    /// Appends markup to the *Text* of the TextBlock, parsing only the appended segment. Intended
+    /// for logs and chat windows. Note that this sets a local value, replacing any binding on *Text*
+    static void AppendText(Noesis::TextBlock* textBlock, const char* markup);
+
     static const Noesis::DependencyProperty* TextProperty;
 
     NS_DECLARE_REFLECTION(RichText, Noesis::NoParent)
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// NoesisGUI - http://www.noesisengine.com
+// Copyright (c) 2013 Noesis Technologies S.L. All Rights Reserved.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Core includes
+#include "CoreMinimal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// An input action routed to the triggers of a view: an action name and EInputEvent for legacy
+/// input, or an UInputAction and ETriggerEvent for Enhanced Input
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FNoesisInputRouteKey
+{
+	FName ActionName;
+	const UObject* Action = nullptr;
+	uint8 Event = 0;
+
+	bool operator==(const FNoesisInputRouteKey& Other) const
+	{
+		return ActionName == Other.ActionName && Action == Other.Action && Event == Other.Event;
+	}
+
+	friend uint32 GetTypeHash(const FNoesisInputRouteKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.ActionName), GetTypeHash(Key.Action)), Key.Event);
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Routing table of the input actions used by a view. Each action is resolved once to a small
+/// integer id that is bound a single time to the input component, and the handlers registered for
+/// it are grouped under that id. Dispatching an action only visits its own handlers, no matter how
+/// many triggers the view has. Ids stay valid until Reset, that also returns the bindings to remove
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class NOESISRUNTIME_API FNoesisInputRouter
+{
+public:
+	/// Adds a handler identified by Owner and returns the id of its route. OutNeedsBinding is set
+	/// when the route had no handlers, the caller must then bind the id and call SetBindingHandle
+	int32 AddHandler(const FNoesisInputRouteKey& Key, const void* Owner, FSimpleDelegate Handler, bool& OutNeedsBinding);
+
+	/// Removes the handler of Owner. Returns the binding handle when the route is left without
+	/// handlers so the caller can unbind it, INDEX_NONE otherwise
+	int32 RemoveHandler(const FNoesisInputRouteKey& Key, const void* Owner);
+
+	void SetBindingHandle(int32 RouteId, int32 BindingHandle);
+
+	/// Invokes the handlers of the route
+	void Dispatch(int32 RouteId) const;
+
+	/// Calls Func(Key, BindingHandle) for every bound route and clears the table
+	template<class F>
+	void Reset(F&& Func)
+	{
+		for (const FRoute& Route : Routes)
+		{
+			if (Route.BindingHandle != INDEX_NONE)
+			{
+				Func(Route.Key, Route.BindingHandle);
+			}
+		}
+		RouteIds.Empty();
+		Routes.Empty();
+	}
+
+	int32 NumRoutes() const { return Routes.Num(); }
+	int32 NumHandlers() const { return NumTotalHandlers; }
+
+private:
+	struct FHandler
+	{
+		const void* Owner;
+		FSimpleDelegate Delegate;
+	};
+
+	struct FRoute
+	{
+		FNoesisInputRouteKey Key;
+		TArray<FHandler> Handlers;
+		int32 BindingHandle = INDEX_NONE;
+	};
+
+	TMap<FNoesisInputRouteKey, int32> RouteIds;
+	TArray<FRoute> Routes;
+	int32 NumTotalHandlers = 0;
+};
@@ -300,6 +300,9 @@ var global = global || (function () { return this; }());
     const newContainer = global.__tgjsNewContainer;
     global.__tgjsNewContainer = undefined;
     
+    // TSet/TMap迭代时每次从native批量取出的元素个数
+    const ITERATOR_BATCH_SIZE = 64;
+    
     function translateType(t) {
         if (typeof t !== 'number') {
             if (Object.prototype.hasOwnProperty.call(t, '__puerts_ufield')) {
@@ -335,13 +338,11 @@ var global = global || (function () { return this; }());
         var ret = newContainer(1, t1);
         if (!("[Symbol.iterator]" in ret)) {
             ret.constructor.prototype[Symbol.iterator] = function*() {
+                let batch = [];
                 let index = 0;
-                let maxIndex = this.GetMaxIndex();
-                while (index < maxIndex) {
-                    if (this.IsValidIndex(index)) {
-                        yield this.Get(index);
-                    }
-                    index++;
+                while (index >= 0) {
+                    index = this.NextBatch(index, ITERATOR_BATCH_SIZE, batch);
+                    yield* batch;
                 }
             }
         }
@@ -355,15 +356,11 @@ var global = global || (function () { return this; }());
         var ret = newContainer(2, t1, t2);
         if (!("[Symbol.iterator]" in ret)) {
             ret.constructor.prototype[Symbol.iterator] = function*() {
+                let batch = [];
                 let index = 0;
-                let maxIndex = this.GetMaxIndex();
-                while (index < maxIndex) {
-                    if (this.IsValidIndex(index)) {
-                        let key = this.GetKey(index);
-                        let value = this.Get(key);
-                        yield [key, value];
-                    }
-                    index++;
+                while (index >= 0) {
+                    index = this.NextBatch(index, ITERATOR_BATCH_SIZE, batch);
+                    yield* batch;
                 }
             }
         }
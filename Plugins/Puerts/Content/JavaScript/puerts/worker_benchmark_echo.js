@@ -0,0 +1,14 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+ * This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+ */
+
+// worker_benchmark.js用的worker模块，原样返回收到的数据，ArrayBuffer再transfer回去
+self.onrequest = function(data) {
+    if (data instanceof ArrayBuffer) {
+        return transfer(data, [data]);
+    }
+    return data;
+};
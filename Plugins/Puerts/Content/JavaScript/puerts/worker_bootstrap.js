@@ -0,0 +1,144 @@
+/*
+* Tencent is pleased to support the open source community by making Puerts available.
+* Copyright (C) 2020 Tencent.  All rights reserved.
+* Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may be subject to their corresponding license terms.
+* This file is subject to the terms and conditions defined in file 'LICENSE', which is part of this source code package.
+*/
+
+// worker线程isolate的启动脚本：只有纯js运行时，没有UE对象，require走与主虚拟机相同的模块加载器
+var global = global || (function () { return this; }());
+(function (global) {
+    "use strict";
+
+    let postMessageToHost = global.__tgjsWorkerPostMessage;
+    global.__tgjsWorkerPostMessage = undefined;
+
+    let loadModule = global.__tgjsWorkerLoadModule;
+    global.__tgjsWorkerLoadModule = undefined;
+
+    let evalScript = global.__tgjsWorkerEvalScript;
+    global.__tgjsWorkerEvalScript = undefined;
+
+    let log = global.__tgjsWorkerLog;
+    global.__tgjsWorkerLog = undefined;
+
+    let setMessageDispatcher = global.__tgjsWorkerSetMessageDispatcher;
+    global.__tgjsWorkerSetMessageDispatcher = undefined;
+
+    function toLogString(args) {
+        return Array.prototype.map.call(args, x => {
+            try {
+                return typeof x === 'object' ? JSON.stringify(x) : String(x);
+            } catch (err) {
+                return String(x);
+            }
+        }).join(',');
+    }
+
+    global.console = {
+        log: function() { log(0, toLogString(arguments)); },
+        info: function() { log(1, toLogString(arguments)); },
+        warn: function() { log(2, toLogString(arguments)); },
+        error: function() { log(3, toLogString(arguments)); },
+    };
+
+    let moduleCache = Object.create(null);
+
+    function genRequire(requiringDir) {
+        function require(moduleName) {
+            let found = loadModule(moduleName, requiringDir);
+            if (!found) {
+                throw new Error("can not find module " + moduleName);
+            }
+            let [fullPath, debugPath, script] = found;
+            let m = moduleCache[fullPath];
+            if (m) {
+                return m.exports;
+            }
+            m = { exports: {} };
+            moduleCache[fullPath] = m;
+            if (fullPath.endsWith(".json")) {
+                m.exports = JSON.parse(script);
+                return m.exports;
+            }
+            let fullDir = fullPath.substring(0, fullPath.lastIndexOf("/"));
+            try {
+                let wrapped = evalScript("(function (exports, require, module, __filename, __dirname) { " + script + "\n});", debugPath);
+                wrapped(m.exports, genRequire(fullDir), m, fullPath, fullDir);
+            } catch (e) {
+                delete moduleCache[fullPath];
+                throw e;
+            }
+            return m.exports;
+        }
+        return require;
+    }
+
+    global.require = genRequire("");
+    global.self = global;
+    global.workerId = global.__tgjsWorkerId;
+    global.postMessage = function(message, transfer) {
+        postMessageToHost(message, transfer);
+    };
+    global.onmessage = undefined;
+
+    // onrequest处理主虚拟机Worker.request/WorkerPool.run发来的任务，返回值（可以是Promise）作为结果回传，
+    // 结果里需要transfer的ArrayBuffer用transfer(result, [buffer])包装
+    global.onrequest = undefined;
+
+    class TransferResult {
+        constructor(value, transferList) {
+            this.value = value;
+            this.transferList = transferList;
+        }
+    }
+
+    global.transfer = function(value, transferList) {
+        return new TransferResult(value, transferList);
+    };
+
+    function reply(taskId, result) {
+        // 结果无法序列化时也要回复，否则宿主端的request()永远不会结束
+        try {
+            if (result instanceof TransferResult) {
+                postMessageToHost({__puertsTaskId: taskId, result: result.value}, result.transferList);
+            } else {
+                postMessageToHost({__puertsTaskId: taskId, result: result});
+            }
+        } catch (e) {
+            replyError(taskId, e);
+        }
+    }
+
+    function replyError(taskId, err) {
+        let message = (err instanceof Error) ? (err.stack || err.message) : String(err);
+        postMessageToHost({__puertsTaskId: taskId, error: message});
+    }
+
+    function handleRequest(taskId, data) {
+        if (typeof global.onrequest !== 'function') {
+            replyError(taskId, "worker " + global.workerId + " has no onrequest handler");
+            return;
+        }
+        let result;
+        try {
+            result = global.onrequest(data);
+        } catch (e) {
+            replyError(taskId, e);
+            return;
+        }
+        if (result instanceof Promise) {
+            result.then(r => reply(taskId, r), e => replyError(taskId, e));
+        } else {
+            reply(taskId, result);
+        }
+    }
+
+    setMessageDispatcher(function(data) {
+        if (data !== null && typeof data === 'object' && data.__puertsTaskId !== undefined) {
+            handleRequest(data.__puertsTaskId, data.data);
+        } else if (typeof global.onmessage === 'function') {
+            global.onmessage({data: data});
+        }
+    });
+}(global));
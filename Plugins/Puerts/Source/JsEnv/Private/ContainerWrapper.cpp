@@ -283,6 +283,10 @@ v8::Local<v8::FunctionTemplate> FScriptSetWrapper::ToFunctionTemplate(v8::Isolat
     Result->PrototypeTemplate()->Set(
         FV8Utils::InternalString(Isolate, "IsValidIndex"), v8::FunctionTemplate::New(Isolate, IsValidIndex));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Empty"), v8::FunctionTemplate::New(Isolate, Empty));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "NextBatch"), v8::FunctionTemplate::New(Isolate, NextBatch));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Values"), v8::FunctionTemplate::New(Isolate, Values));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "AddMany"), v8::FunctionTemplate::New(Isolate, AddMany));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "RemoveMany"), v8::FunctionTemplate::New(Isolate, RemoveMany));
 
     return Result;
 }
@@ -453,6 +457,201 @@ void FScriptSetWrapper::Empty(const v8::FunctionCallbackInfo<v8::Value>& Info)
     FScriptSetEx::Empty(Self, Inner->Property);
 }
 
+void FScriptSetWrapper::NextBatch(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS_LEN(3);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptSet>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    if (!Info[2]->IsArray())
+    {
+        FV8Utils::ThrowException(Isolate, "the third argument must be an array");
+        return;
+    }
+    auto Property = Inner->Property;
+
+    int32 Index = FMath::Max(Info[0]->Int32Value(Context).ToChecked(), 0);
+    const int32 MaxCount = Info[1]->Int32Value(Context).ToChecked();
+    if (MaxCount < 1)
+    {
+        // 否则返回的索引不变，调用方的循环永远不会结束
+        FV8Utils::ThrowException(Isolate, "the batch size must be greater than 0");
+        return;
+    }
+    auto Out = Info[2].As<v8::Array>();
+
+    auto ScriptLayout = FScriptSet::GetScriptLayout(Property->GetSize(), Property->GetMinAlignment());
+    const int32 MaxIndex = Self->GetMaxIndex();
+    int32 Count = 0;
+    for (; Index < MaxIndex && Count < MaxCount; ++Index)
+    {
+        if (Self->IsValidIndex(Index))
+        {
+            Out->Set(Context, Count++, Inner->UEToJs(Isolate, Context, Self->GetData(Index, ScriptLayout), false)).Check();
+        }
+    }
+    Out->Set(Context, FV8Utils::InternalString(Isolate, "length"), v8::Integer::New(Isolate, Count)).Check();
+    Info.GetReturnValue().Set(Index < MaxIndex ? Index : INDEX_NONE);
+}
+
+void FScriptSetWrapper::Values(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    auto Self = FV8Utils::GetPointerFast<FScriptSet>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    auto Property = Inner->Property;
+
+    auto ScriptLayout = FScriptSet::GetScriptLayout(Property->GetSize(), Property->GetMinAlignment());
+    auto Result = v8::Array::New(Isolate, Self->Num());
+    const int32 MaxIndex = Self->GetMaxIndex();
+    uint32 Count = 0;
+    for (int32 i = 0; i < MaxIndex; ++i)
+    {
+        if (Self->IsValidIndex(i))
+        {
+            Result->Set(Context, Count++, Inner->UEToJs(Isolate, Context, Self->GetData(i, ScriptLayout), false)).Check();
+        }
+    }
+    Info.GetReturnValue().Set(Result);
+}
+
+void FScriptSetWrapper::AddMany(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS(EArgObject);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptSet>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    if (!Info[0]->IsArray())
+    {
+        FV8Utils::ThrowException(Isolate, "the argument must be an array");
+        return;
+    }
+    auto Property = Inner->Property;
+    auto Elements = Info[0].As<v8::Array>();
+
+    auto ScriptLayout = FScriptSet::GetScriptLayout(Property->GetSize(), Property->GetMinAlignment());
+    auto GetHash = [Property](const void* Element) { return Property->GetValueTypeHash(Element); };
+    auto Equals = [Property](const void* A, const void* B) { return Property->Identical(A, B); };
+
+    // 新加入的元素在rehash前不在hash表里，批内去重只能靠这里记录
+    TMultiMap<uint32, int32> Pending;
+    // 空容器的hash表可能还没分配，不能用FindIndex
+    const bool bHashed = Self->Num() > 0;
+
+    void* DataPtr = FMemory_Alloca(GetSizeWithAlignment(Property));
+    Property->InitializeValue(DataPtr);
+
+    const uint32 Length = Elements->Length();
+    for (uint32 i = 0; i < Length; ++i)
+    {
+        Inner->JsToUE(Isolate, Context, Elements->Get(Context, i).ToLocalChecked(), DataPtr, false);
+        if (bHashed && Self->FindIndex(DataPtr, ScriptLayout, GetHash, Equals) != INDEX_NONE)
+        {
+            continue;
+        }
+        const uint32 Hash = GetHash(DataPtr);
+        bool Duplicated = false;
+        for (auto It = Pending.CreateConstKeyIterator(Hash); It; ++It)
+        {
+            if (Equals(Self->GetData(It.Value(), ScriptLayout), DataPtr))
+            {
+                Duplicated = true;
+                break;
+            }
+        }
+        if (!Duplicated)
+        {
+            int32 Index = Self->AddUninitialized(ScriptLayout);
+            void* Element = Self->GetData(Index, ScriptLayout);
+            Property->InitializeValue(Element);
+            Property->CopySingleValue(Element, DataPtr);
+            Pending.Add(Hash, Index);
+        }
+    }
+    Property->DestroyValue(DataPtr);
+
+    if (Pending.Num() > 0)
+    {
+        Self->Rehash(ScriptLayout, GetHash);
+    }
+}
+
+void FScriptSetWrapper::RemoveMany(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS(EArgObject);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptSet>(Info.Holder(), 0);
+    auto Inner = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    if (!Inner->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "item info is invalid!");
+        return;
+    }
+    if (!Info[0]->IsArray())
+    {
+        FV8Utils::ThrowException(Isolate, "the argument must be an array");
+        return;
+    }
+    auto Property = Inner->Property;
+    auto Elements = Info[0].As<v8::Array>();
+
+    int32 Removed = 0;
+    if (Self->Num() > 0)
+    {
+        auto ScriptLayout = FScriptSet::GetScriptLayout(Property->GetSize(), Property->GetMinAlignment());
+
+        void* DataPtr = FMemory_Alloca(GetSizeWithAlignment(Property));
+        Property->InitializeValue(DataPtr);
+
+        const uint32 Length = Elements->Length();
+        for (uint32 i = 0; i < Length && Self->Num() > 0; ++i)
+        {
+            Inner->JsToUE(Isolate, Context, Elements->Get(Context, i).ToLocalChecked(), DataPtr, false);
+            int32 Index = Self->FindIndex(
+                DataPtr, ScriptLayout, [Property](const void* Element) { return Property->GetValueTypeHash(Element); },
+                [Property](const void* A, const void* B) { return Property->Identical(A, B); });
+            if (Index != INDEX_NONE)
+            {
+                FScriptSetEx::Destruct(Self, Property, Index, 1);
+                Self->RemoveAt(Index, ScriptLayout);
+                ++Removed;
+            }
+        }
+        Property->DestroyValue(DataPtr);
+    }
+    Info.GetReturnValue().Set(Removed);
+}
+
 int32 FScriptSetWrapper::FindIndexInner(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
@@ -501,6 +700,12 @@ v8::Local<v8::FunctionTemplate> FScriptMapWrapper::ToFunctionTemplate(v8::Isolat
         FV8Utils::InternalString(Isolate, "IsValidIndex"), v8::FunctionTemplate::New(Isolate, IsValidIndex));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "GetKey"), v8::FunctionTemplate::New(Isolate, GetKey));
     Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Empty"), v8::FunctionTemplate::New(Isolate, Empty));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "NextBatch"), v8::FunctionTemplate::New(Isolate, NextBatch));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Keys"), v8::FunctionTemplate::New(Isolate, Keys));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Values"), v8::FunctionTemplate::New(Isolate, Values));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "Entries"), v8::FunctionTemplate::New(Isolate, Entries));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "AddMany"), v8::FunctionTemplate::New(Isolate, AddMany));
+    Result->PrototypeTemplate()->Set(FV8Utils::InternalString(Isolate, "RemoveMany"), v8::FunctionTemplate::New(Isolate, RemoveMany));
 
     return Result;
 }
@@ -730,6 +935,270 @@ void FScriptMapWrapper::Empty(const v8::FunctionCallbackInfo<v8::Value>& Info)
     FScriptMapEx::Empty(Self, KeyProperty, ValueProperty);
 }
 
+void FScriptMapWrapper::NextBatch(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS_LEN(3);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptMap>(Info.Holder(), 0);
+    auto KeyPropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    auto KeyProperty = KeyPropertyTranslator->Property;
+    auto ValuePropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 2);
+    auto ValueProperty = ValuePropertyTranslator->Property;
+    if (!KeyPropertyTranslator->IsPropertyValid() || !ValuePropertyTranslator->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "key/value info is invalid!");
+        return;
+    }
+    if (!Info[2]->IsArray())
+    {
+        FV8Utils::ThrowException(Isolate, "the third argument must be an array");
+        return;
+    }
+
+    int32 Index = FMath::Max(Info[0]->Int32Value(Context).ToChecked(), 0);
+    const int32 MaxCount = Info[1]->Int32Value(Context).ToChecked();
+    if (MaxCount < 1)
+    {
+        // 否则返回的索引不变，调用方的循环永远不会结束
+        FV8Utils::ThrowException(Isolate, "the batch size must be greater than 0");
+        return;
+    }
+    auto Out = Info[2].As<v8::Array>();
+
+    auto ScriptLayout = GetScriptLayout(KeyProperty, ValueProperty);
+    const int32 MaxIndex = Self->GetMaxIndex();
+    int32 Count = 0;
+    for (; Index < MaxIndex && Count < MaxCount; ++Index)
+    {
+        if (Self->IsValidIndex(Index))
+        {
+            uint8* Data = reinterpret_cast<uint8*>(Self->GetData(Index, ScriptLayout));
+            v8::Local<v8::Value> Pair[2] = {
+                KeyPropertyTranslator->UEToJs(Isolate, Context, Data + GetKeyOffset(ScriptLayout), false),
+                ValuePropertyTranslator->UEToJs(Isolate, Context, Data + ScriptLayout.ValueOffset, false)};
+            Out->Set(Context, Count++, v8::Array::New(Isolate, Pair, 2)).Check();
+        }
+    }
+    Out->Set(Context, FV8Utils::InternalString(Isolate, "length"), v8::Integer::New(Isolate, Count)).Check();
+    Info.GetReturnValue().Set(Index < MaxIndex ? Index : INDEX_NONE);
+}
+
+void FScriptMapWrapper::Keys(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    InternalToArray(Info, true, false);
+}
+
+void FScriptMapWrapper::Values(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    InternalToArray(Info, false, true);
+}
+
+void FScriptMapWrapper::Entries(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    InternalToArray(Info, true, true);
+}
+
+void FScriptMapWrapper::InternalToArray(const v8::FunctionCallbackInfo<v8::Value>& Info, bool WithKey, bool WithValue)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    auto Self = FV8Utils::GetPointerFast<FScriptMap>(Info.Holder(), 0);
+    auto KeyPropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    auto KeyProperty = KeyPropertyTranslator->Property;
+    auto ValuePropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 2);
+    auto ValueProperty = ValuePropertyTranslator->Property;
+    if (!KeyPropertyTranslator->IsPropertyValid() || !ValuePropertyTranslator->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "key/value info is invalid!");
+        return;
+    }
+
+    auto ScriptLayout = GetScriptLayout(KeyProperty, ValueProperty);
+    auto Result = v8::Array::New(Isolate, Self->Num());
+    const int32 MaxIndex = Self->GetMaxIndex();
+    uint32 Count = 0;
+    for (int32 i = 0; i < MaxIndex; ++i)
+    {
+        if (!Self->IsValidIndex(i))
+        {
+            continue;
+        }
+        uint8* Data = reinterpret_cast<uint8*>(Self->GetData(i, ScriptLayout));
+        v8::Local<v8::Value> Item;
+        if (WithKey && WithValue)
+        {
+            v8::Local<v8::Value> Pair[2] = {
+                KeyPropertyTranslator->UEToJs(Isolate, Context, Data + GetKeyOffset(ScriptLayout), false),
+                ValuePropertyTranslator->UEToJs(Isolate, Context, Data + ScriptLayout.ValueOffset, false)};
+            Item = v8::Array::New(Isolate, Pair, 2);
+        }
+        else if (WithKey)
+        {
+            Item = KeyPropertyTranslator->UEToJs(Isolate, Context, Data + GetKeyOffset(ScriptLayout), false);
+        }
+        else
+        {
+            Item = ValuePropertyTranslator->UEToJs(Isolate, Context, Data + ScriptLayout.ValueOffset, false);
+        }
+        Result->Set(Context, Count++, Item).Check();
+    }
+    Info.GetReturnValue().Set(Result);
+}
+
+void FScriptMapWrapper::AddMany(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS(EArgObject);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptMap>(Info.Holder(), 0);
+    auto KeyPropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    auto KeyProperty = KeyPropertyTranslator->Property;
+    auto ValuePropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 2);
+    auto ValueProperty = ValuePropertyTranslator->Property;
+    if (!KeyPropertyTranslator->IsPropertyValid() || !ValuePropertyTranslator->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "key/value info is invalid!");
+        return;
+    }
+    if (!Info[0]->IsArray())
+    {
+        FV8Utils::ThrowException(Isolate, "the argument must be an array of [key, value]");
+        return;
+    }
+    auto Entries = Info[0].As<v8::Array>();
+
+    auto ScriptLayout = GetScriptLayout(KeyProperty, ValueProperty);
+    auto GetKeyHash = [KeyProperty](const void* ElementKey) { return KeyProperty->GetValueTypeHash(ElementKey); };
+    auto KeyEquals = [KeyProperty](const void* A, const void* B) { return KeyProperty->Identical(A, B); };
+
+    // 新加入的元素在rehash前不在hash表里，批内去重只能靠这里记录
+    TMultiMap<uint32, int32> Pending;
+    // 空容器的hash表可能还没分配，不能用FindPairIndex
+    const bool bHashed = Self->Num() > 0;
+
+    void* KeyPtr = FMemory_Alloca(GetSizeWithAlignment(KeyProperty));
+    KeyProperty->InitializeValue(KeyPtr);
+
+    void* ValuePtr = FMemory_Alloca(GetSizeWithAlignment(ValueProperty));
+    ValueProperty->InitializeValue(ValuePtr);
+
+    const uint32 Length = Entries->Length();
+    for (uint32 i = 0; i < Length; ++i)
+    {
+        v8::Local<v8::Value> Entry = Entries->Get(Context, i).ToLocalChecked();
+        if (!Entry->IsArray())
+        {
+            FV8Utils::ThrowException(Isolate, "the argument must be an array of [key, value]");
+            break;
+        }
+        auto Pair = Entry.As<v8::Array>();
+        KeyPropertyTranslator->JsToUE(Isolate, Context, Pair->Get(Context, 0).ToLocalChecked(), KeyPtr, false);
+        ValuePropertyTranslator->JsToUE(Isolate, Context, Pair->Get(Context, 1).ToLocalChecked(), ValuePtr, false);
+
+        int32 Index = bHashed ? Self->FindPairIndex(KeyPtr, ScriptLayout, GetKeyHash, KeyEquals) : INDEX_NONE;
+        uint32 Hash = 0;
+        if (Index == INDEX_NONE)
+        {
+            Hash = GetKeyHash(KeyPtr);
+            for (auto It = Pending.CreateConstKeyIterator(Hash); It; ++It)
+            {
+                uint8* Data = reinterpret_cast<uint8*>(Self->GetData(It.Value(), ScriptLayout));
+                if (KeyEquals(Data + GetKeyOffset(ScriptLayout), KeyPtr))
+                {
+                    Index = It.Value();
+                    break;
+                }
+            }
+        }
+
+        if (Index != INDEX_NONE)
+        {
+            uint8* Data = reinterpret_cast<uint8*>(Self->GetData(Index, ScriptLayout));
+            ValueProperty->CopySingleValue(Data + ScriptLayout.ValueOffset, ValuePtr);
+        }
+        else
+        {
+            Index = Self->AddUninitialized(ScriptLayout);
+            uint8* Data = reinterpret_cast<uint8*>(Self->GetData(Index, ScriptLayout));
+            void* NewKey = Data + GetKeyOffset(ScriptLayout);
+            void* NewValue = Data + ScriptLayout.ValueOffset;
+            KeyProperty->InitializeValue(NewKey);
+            KeyProperty->CopySingleValue(NewKey, KeyPtr);
+            ValueProperty->InitializeValue(NewValue);
+            ValueProperty->CopySingleValue(NewValue, ValuePtr);
+            Pending.Add(Hash, Index);
+        }
+    }
+    KeyProperty->DestroyValue(KeyPtr);
+    ValueProperty->DestroyValue(ValuePtr);
+
+    if (Pending.Num() > 0)
+    {
+        Self->Rehash(ScriptLayout, GetKeyHash);
+    }
+}
+
+void FScriptMapWrapper::RemoveMany(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS(EArgObject);
+
+    auto Self = FV8Utils::GetPointerFast<FScriptMap>(Info.Holder(), 0);
+    auto KeyPropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 1);
+    auto KeyProperty = KeyPropertyTranslator->Property;
+    auto ValuePropertyTranslator = FV8Utils::GetPointerFast<FPropertyTranslator>(Info.Holder(), 2);
+    auto ValueProperty = ValuePropertyTranslator->Property;
+    if (!KeyPropertyTranslator->IsPropertyValid() || !ValuePropertyTranslator->IsPropertyValid())
+    {
+        FV8Utils::ThrowException(Isolate, "key/value info is invalid!");
+        return;
+    }
+    if (!Info[0]->IsArray())
+    {
+        FV8Utils::ThrowException(Isolate, "the argument must be an array");
+        return;
+    }
+    auto Keys = Info[0].As<v8::Array>();
+
+    int32 Removed = 0;
+    if (Self->Num() > 0)
+    {
+        auto ScriptLayout = GetScriptLayout(KeyProperty, ValueProperty);
+
+        void* KeyPtr = FMemory_Alloca(GetSizeWithAlignment(KeyProperty));
+        KeyProperty->InitializeValue(KeyPtr);
+
+        const uint32 Length = Keys->Length();
+        for (uint32 i = 0; i < Length && Self->Num() > 0; ++i)
+        {
+            KeyPropertyTranslator->JsToUE(Isolate, Context, Keys->Get(Context, i).ToLocalChecked(), KeyPtr, false);
+            int32 Index = Self->FindPairIndex(
+                KeyPtr, ScriptLayout, [KeyProperty](const void* Key) { return KeyProperty->GetValueTypeHash(Key); },
+                [KeyProperty](const void* A, const void* B) { return KeyProperty->Identical(A, B); });
+            if (Index != INDEX_NONE)
+            {
+                FScriptMapEx::Destruct(Self, KeyProperty, ValueProperty, Index, 1);
+                Self->RemoveAt(Index, ScriptLayout);
+                ++Removed;
+            }
+        }
+        KeyProperty->DestroyValue(KeyPtr);
+    }
+    Info.GetReturnValue().Set(Removed);
+}
+
 FScriptMapLayout FScriptMapWrapper::GetScriptLayout(const PropertyMacro* KeyProperty, const PropertyMacro* ValueProperty)
 {
     return FScriptMap::GetScriptLayout(
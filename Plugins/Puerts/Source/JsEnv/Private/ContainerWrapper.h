@@ -360,6 +360,24 @@ private:
 
     static void Empty(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    // 参数1：起始索引；参数2：本批最大元素数；参数3：输出数组
+    // 返回：下一批的起始索引，遍历结束返回INDEX_NONE（-1）
+    // 作用：跳过空槽，一次调用批量取出多个元素，供迭代器使用
+    static void NextBatch(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：包含全部元素的js数组
+    static void Values(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：元素数组
+    // 返回：无
+    // 作用：批量添加，所有元素写入后只rehash一次
+    static void AddMany(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：元素数组
+    // 返回：实际移除的元素个数
+    static void RemoveMany(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
     FORCEINLINE static int32 FindIndexInner(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
     FORCEINLINE static void InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer);
@@ -389,6 +407,34 @@ private:
 
     static void Empty(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+    // 参数1：起始索引；参数2：本批最大元素数；参数3：输出数组，填充为[key, value]数组
+    // 返回：下一批的起始索引，遍历结束返回INDEX_NONE（-1）
+    // 作用：跳过空槽，一次调用批量取出多个键值对，供迭代器使用
+    static void NextBatch(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：包含全部key的js数组
+    static void Keys(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：包含全部value的js数组（值类型，有内存拷贝）
+    static void Values(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：无
+    // 返回：包含全部[key, value]的js数组
+    static void Entries(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：[key, value]数组
+    // 返回：无
+    // 作用：批量添加，已存在的key覆盖value，所有元素写入后只rehash一次
+    static void AddMany(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    // 参数：key数组
+    // 返回：实际移除的元素个数，不存在的key会被忽略
+    static void RemoveMany(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    static void InternalToArray(const v8::FunctionCallbackInfo<v8::Value>& Info, bool WithKey, bool WithValue);
+
     FORCEINLINE static FScriptMapLayout GetScriptLayout(const PropertyMacro* KeyProperty, const PropertyMacro* ValueProperty);
 
     FORCEINLINE static void InternalGet(const v8::FunctionCallbackInfo<v8::Value>& Info, bool PassByPointer);
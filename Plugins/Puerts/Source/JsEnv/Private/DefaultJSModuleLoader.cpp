@@ -9,7 +9,10 @@
 #include "JSModuleLoader.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/FileManager.h"
 #include "Algo/Reverse.h"
+#include <atomic>
 #if (ENGINE_MAJOR_VERSION >= 5)
 #include "HAL/PlatformFileManager.h"
 #else
@@ -50,11 +53,84 @@ static FString PathNormalize(const FString& PathIn)
     }
 }
 
+const TCHAR* DefaultJSModuleLoader::ManifestFileName = TEXT("puerts_module_manifest.txt");
+
+static std::atomic<uint32> GSearchCacheEpoch(0);
+
+void DefaultJSModuleLoader::InvalidateAllSearchCaches()
+{
+    ++GSearchCacheEpoch;
+}
+
+bool DefaultJSModuleLoader::GenerateManifest(const FString& InScriptRoot, const FString& OutputDir)
+{
+    const FString RootDir = FPaths::ProjectContentDir() / InScriptRoot;
+    TArray<FString> Files;
+    IFileManager::Get().FindFilesRecursive(Files, *RootDir, TEXT("*"), true, false);
+
+    FString Manifest;
+    const FString RootPrefix = PathNormalize(RootDir) + TEXT("/");
+    for (const FString& File : Files)
+    {
+        FString RelativePath = PathNormalize(File);
+        if (RelativePath.StartsWith(RootPrefix))
+        {
+            RelativePath = RelativePath.RightChop(RootPrefix.Len());
+            if (RelativePath != ManifestFileName)
+            {
+                Manifest += RelativePath;
+                Manifest += TEXT("\n");
+            }
+        }
+    }
+    return FFileHelper::SaveStringToFile(Manifest, *(OutputDir / ManifestFileName), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+
+void DefaultJSModuleLoader::LoadManifest()
+{
+    ManifestLoaded = true;
+#if !WITH_EDITOR
+    const FString RootDir = FPaths::ProjectContentDir() / ScriptRoot;
+    TArray<FString> Lines;
+    if (FFileHelper::LoadFileToStringArray(Lines, *(RootDir / ManifestFileName)))
+    {
+        ManifestRoot = PathNormalize(RootDir) + TEXT("/");
+        ManifestFullRoot = PathNormalize(FPaths::ConvertRelativePathToFull(RootDir)) + TEXT("/");
+        ManifestFiles.Reserve(Lines.Num());
+        for (const FString& Line : Lines)
+        {
+            if (!Line.IsEmpty())
+            {
+                ManifestFiles.Add(Line);
+            }
+        }
+    }
+#endif
+}
+
+void DefaultJSModuleLoader::ClearSearchCache()
+{
+    FScopeLock ScopeLock(&CacheLock);
+    SearchCache.Empty();
+}
+
 bool DefaultJSModuleLoader::CheckExists(const FString& PathIn, FString& Path, FString& AbsolutePath)
 {
-    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
     FString NormalizedPath = PathNormalize(PathIn);
-    if (PlatformFile.FileExists(*NormalizedPath))
+    bool Exists;
+    if (!ManifestRoot.IsEmpty() && NormalizedPath.StartsWith(ManifestRoot))
+    {
+        Exists = ManifestFiles.Contains(NormalizedPath.RightChop(ManifestRoot.Len()));
+    }
+    else if (!ManifestFullRoot.IsEmpty() && NormalizedPath.StartsWith(ManifestFullRoot))
+    {
+        Exists = ManifestFiles.Contains(NormalizedPath.RightChop(ManifestFullRoot.Len()));
+    }
+    else
+    {
+        Exists = FPlatformFileManager::Get().GetPlatformFile().FileExists(*NormalizedPath);
+    }
+    if (Exists)
     {
         AbsolutePath = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*NormalizedPath);
         Path = NormalizedPath;
@@ -90,6 +166,38 @@ bool DefaultJSModuleLoader::SearchModuleWithExtInDir(
 }
 
 bool DefaultJSModuleLoader::Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath)
+{
+    FScopeLock ScopeLock(&CacheLock);
+    if (!ManifestLoaded)
+    {
+        LoadManifest();
+    }
+
+    const uint32 Epoch = GSearchCacheEpoch.load();
+    if (SearchCacheEpoch != Epoch)
+    {
+        SearchCache.Empty();
+        SearchCacheEpoch = Epoch;
+    }
+
+    // 只缓存找到的结果，找不到的模块下次仍会重新查找
+    const FString Key = RequiredDir + TEXT("|") + RequiredModule;
+    if (const TPair<FString, FString>* Cached = SearchCache.Find(Key))
+    {
+        Path = Cached->Key;
+        AbsolutePath = Cached->Value;
+        return true;
+    }
+    if (SearchUncached(RequiredDir, RequiredModule, Path, AbsolutePath))
+    {
+        SearchCache.Add(Key, TPair<FString, FString>(Path, AbsolutePath));
+        return true;
+    }
+    return false;
+}
+
+bool DefaultJSModuleLoader::SearchUncached(
+    const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath)
 {
     if (SearchModuleInDir(RequiredDir, RequiredModule, Path, AbsolutePath))
     {
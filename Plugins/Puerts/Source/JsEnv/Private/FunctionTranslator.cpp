@@ -8,6 +8,7 @@
 
 #include "FunctionTranslator.h"
 #include "V8Utils.h"
+#include "JsTrace.h"
 #include "Misc/DefaultValueHelper.h"
 #include <mutex>
 
@@ -228,6 +229,7 @@ void FFunctionTranslator::Call(const v8::FunctionCallbackInfo<v8::Value>& Info)
 void FFunctionTranslator::Call(
     v8::Isolate* Isolate, v8::Local<v8::Context>& Context, const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
+    PUERTS_TRACE_SCOPE(PuertsCallChannel, GetTraceName(Function.Get()));
     UObject* CallObject = IsStatic ? BindObject.Get() : FV8Utils::GetUObject(Info.Holder());
     if (!CallObject)
     {
@@ -421,6 +423,7 @@ void FFunctionTranslator::FastCall(v8::Isolate* Isolate, v8::Local<v8::Context>&
 void FFunctionTranslator::Call(v8::Isolate* Isolate, v8::Local<v8::Context>& Context,
     const v8::FunctionCallbackInfo<v8::Value>& Info, std::function<void(void*)> OnCall)
 {
+    PUERTS_TRACE_SCOPE(PuertsCallChannel, GetTraceName(Function.Get()));
 #if defined(USE_GLOBAL_PARAMS_BUFFER)
     void* Params = Buffer;
 #else
@@ -0,0 +1,162 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsCodeCache.h"
+
+#ifndef WITH_QUICKJS
+#include "JSLogger.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+static TAutoConsoleVariable<int32> CVarPuertsCodeCache(TEXT("Puerts.CodeCache"), 1,
+    TEXT("Cache compiled js code under Saved/PuertsCodeCache. 0: disabled, 1: enabled"), ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarPuertsCodeCacheIncludeUserModules(TEXT("Puerts.CodeCache.IncludeUserModules"), 0,
+    TEXT("Also regenerate warm code cache for modules loaded by the start module, after it has run. 0: only puerts bootstrap "
+         "scripts, 1: bootstrap and user modules"),
+    ECVF_Default);
+
+namespace PUERTS_NAMESPACE
+{
+FJsCodeCache::FJsCodeCache()
+    : CacheDir(FPaths::ProjectSavedDir() / TEXT("PuertsCodeCache") /
+               FString::Printf(TEXT("%08x"), v8::ScriptCompiler::CachedDataVersionTag()))
+    , CacheDirCreated(false)
+    , TrackCompiled(false)
+{
+}
+
+bool FJsCodeCache::IsEnabled()
+{
+    return CVarPuertsCodeCache.GetValueOnAnyThread() != 0;
+}
+
+bool FJsCodeCache::IncludeUserModules()
+{
+    return CVarPuertsCodeCacheIncludeUserModules.GetValueOnAnyThread() != 0;
+}
+
+bool FJsCodeCache::Lookup(v8::Isolate* Isolate, v8::Local<v8::String> Source, FString& OutKey, TArray<uint8>& OutData)
+{
+    if (!IsEnabled())
+    {
+        return false;
+    }
+
+    v8::String::Value SourceChars(Isolate, Source);
+    FSHAHash Hash;
+    FSHA1::HashBuffer(*SourceChars, SourceChars.length() * sizeof(uint16_t), Hash.Hash);
+    OutKey = Hash.ToString();
+
+    if (!FFileHelper::LoadFileToArray(OutData, *GetCacheFilePath(OutKey), FILEREAD_Silent))
+    {
+        ++Statistics.Misses;
+        return false;
+    }
+    Statistics.BytesRead += OutData.Num();
+    return true;
+}
+
+bool FJsCodeCache::CheckConsumed(const FString& Key, const v8::ScriptCompiler::CachedData* Consumed)
+{
+    if (!Consumed)
+    {
+        return true;
+    }
+    if (Consumed->rejected)
+    {
+        ++Statistics.Rejects;
+        UE_LOG(Puerts, Warning, TEXT("code cache rejected: %s"), *GetCacheFilePath(Key));
+        return true;
+    }
+    ++Statistics.Hits;
+    return false;
+}
+
+void FJsCodeCache::OnCompiled(const FString& Key, const v8::ScriptCompiler::CachedData* Consumed, v8::Local<v8::UnboundScript> Script)
+{
+    if (!Key.IsEmpty() && CheckConsumed(Key, Consumed))
+    {
+        Save(Key, v8::ScriptCompiler::CreateCodeCache(Script));
+        if (TrackCompiled)
+        {
+            TrackedScripts.Emplace(Key, v8::Global<v8::UnboundScript>(v8::Isolate::GetCurrent(), Script));
+        }
+    }
+}
+
+void FJsCodeCache::OnCompiled(
+    const FString& Key, const v8::ScriptCompiler::CachedData* Consumed, v8::Local<v8::UnboundModuleScript> Script)
+{
+    if (!Key.IsEmpty() && CheckConsumed(Key, Consumed))
+    {
+        Save(Key, v8::ScriptCompiler::CreateCodeCache(Script));
+        if (TrackCompiled)
+        {
+            TrackedModules.Emplace(Key, v8::Global<v8::UnboundModuleScript>(v8::Isolate::GetCurrent(), Script));
+        }
+    }
+}
+
+void FJsCodeCache::FlushTracked(v8::Isolate* Isolate, bool bSave)
+{
+    if (bSave)
+    {
+        v8::HandleScope HandleScope(Isolate);
+        for (auto& Pair : TrackedScripts)
+        {
+            Save(Pair.Key, v8::ScriptCompiler::CreateCodeCache(Pair.Value.Get(Isolate)));
+        }
+        for (auto& Pair : TrackedModules)
+        {
+            Save(Pair.Key, v8::ScriptCompiler::CreateCodeCache(Pair.Value.Get(Isolate)));
+        }
+        Statistics.WarmFlushed += TrackedScripts.Num() + TrackedModules.Num();
+    }
+    TrackedScripts.Empty();
+    TrackedModules.Empty();
+}
+
+void FJsCodeCache::Save(const FString& Key, v8::ScriptCompiler::CachedData* CachedData)
+{
+    if (!CachedData)
+    {
+        return;
+    }
+
+    if (!CacheDirCreated)
+    {
+        CacheDirCreated = IFileManager::Get().MakeDirectory(*CacheDir, true);
+    }
+    // 先写临时文件再改名，避免进程中途退出留下不完整的缓存
+    const FString FilePath = GetCacheFilePath(Key);
+    const FString TempFilePath = FilePath + TEXT(".tmp");
+    if (FFileHelper::SaveArrayToFile(TArrayView<const uint8>(CachedData->data, CachedData->length), *TempFilePath) &&
+        IFileManager::Get().Move(*FilePath, *TempFilePath, true, true, false, true))
+    {
+        Statistics.BytesWritten += CachedData->length;
+    }
+    else
+    {
+        UE_LOG(Puerts, Warning, TEXT("can not write code cache: %s"), *FilePath);
+    }
+
+#if !WITH_EDITOR
+    delete CachedData;    //编辑器下是v8.dll分配的，ue里的delete被重载了，这delete会有问题
+#endif
+}
+
+FString FJsCodeCache::GetCacheFilePath(const FString& Key) const
+{
+    return CacheDir / Key + TEXT(".jscache");
+}
+}    // namespace PUERTS_NAMESPACE
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NamespaceDef.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#ifndef WITH_QUICKJS
+namespace PUERTS_NAMESPACE
+{
+/**
+ * 源码编译结果的磁盘缓存，用于require/import加载的普通js（非.cbc/.mbc字节码文件）。
+ * 缓存放在Saved/PuertsCodeCache下，按v8 CachedDataVersionTag（v8版本+flags）分目录，按源码的SHA1命名，源码或v8参数变化后自然失效。
+ * 用法：编译前Lookup，命中则以kConsumeCodeCache编译；编译后调用OnCompiled，未命中或被v8拒绝时生成并写入新的缓存。
+ * 编译后立即生成的缓存只包含顶层代码，懒编译的函数不在其中；启动阶段可以SetTrackCompiled(true)记下新编译的脚本，
+ * 启动代码执行完后调用FlushTracked重新生成一次，这时已执行过的函数也会被写入，相当于启动阶段的代码快照。
+ */
+class FJsCodeCache
+{
+public:
+    struct FStatistics
+    {
+        int32 Hits = 0;
+
+        int32 Misses = 0;
+
+        int32 Rejects = 0;
+
+        int64 BytesRead = 0;
+
+        int64 BytesWritten = 0;
+
+        int32 WarmFlushed = 0;
+    };
+
+    FJsCodeCache();
+
+    // 总开关，对应控制台变量Puerts.CodeCache
+    static bool IsEnabled();
+
+    // 对应控制台变量Puerts.CodeCache.IncludeUserModules，Start执行的模块及其依赖是否也生成预热后的缓存
+    static bool IncludeUserModules();
+
+    // 无论是否命中，启用时OutKey都会被设置，供OnCompiled使用；命中时OutData为缓存内容
+    bool Lookup(v8::Isolate* Isolate, v8::Local<v8::String> Source, FString& OutKey, TArray<uint8>& OutData);
+
+    // Consumed为编译时传入的CachedData（未命中时为nullptr）
+    void OnCompiled(const FString& Key, const v8::ScriptCompiler::CachedData* Consumed, v8::Local<v8::UnboundScript> Script);
+
+    void OnCompiled(const FString& Key, const v8::ScriptCompiler::CachedData* Consumed, v8::Local<v8::UnboundModuleScript> Script);
+
+    void SetTrackCompiled(bool InTrackCompiled)
+    {
+        TrackCompiled = InTrackCompiled;
+    }
+
+    // bSave为false时只丢弃记录的脚本
+    void FlushTracked(v8::Isolate* Isolate, bool bSave);
+
+    FORCEINLINE const FStatistics& GetStatistics() const
+    {
+        return Statistics;
+    }
+
+private:
+    // 返回true表示需要重新生成缓存
+    bool CheckConsumed(const FString& Key, const v8::ScriptCompiler::CachedData* Consumed);
+
+    void Save(const FString& Key, v8::ScriptCompiler::CachedData* CachedData);
+
+    FString GetCacheFilePath(const FString& Key) const;
+
+    FString CacheDir;
+
+    bool CacheDirCreated;
+
+    bool TrackCompiled;
+
+    TArray<TPair<FString, v8::Global<v8::UnboundScript>>> TrackedScripts;
+
+    TArray<TPair<FString, v8::Global<v8::UnboundModuleScript>>> TrackedModules;
+
+    FStatistics Statistics;
+};
+}    // namespace PUERTS_NAMESPACE
+#endif
@@ -34,11 +34,31 @@ bool FJsEnv::IdleNotificationDeadline(double DeadlineInSeconds)
     return GameScript->IdleNotificationDeadline(DeadlineInSeconds);
 }
 
+bool FJsEnv::IdleNotification(double IdleTimeInSeconds)
+{
+    return GameScript->IdleNotification(IdleTimeInSeconds);
+}
+
 void FJsEnv::LowMemoryNotification()
 {
     GameScript->LowMemoryNotification();
 }
 
+bool FJsEnv::StartCpuProfile(int32 SamplingIntervalUs)
+{
+    return GameScript->StartCpuProfile(SamplingIntervalUs);
+}
+
+FString FJsEnv::StopCpuProfile(const FString& FilePath)
+{
+    return GameScript->StopCpuProfile(FilePath);
+}
+
+FString FJsEnv::TakeHeapSnapshot(const FString& FilePath)
+{
+    return GameScript->TakeHeapSnapshot(FilePath);
+}
+
 void FJsEnv::RequestMinorGarbageCollectionForTesting()
 {
     GameScript->RequestMinorGarbageCollectionForTesting();
@@ -182,5 +182,19 @@ void FJsEnvGroup::SetJsEnvSelector(std::function<int(UObject*, int)> InSelector)
     }
 }
 
+int FJsEnvGroup::CreateWorker(int EnvIndex, const FString& ModuleName)
+{
+#ifndef WITH_QUICKJS
+    if (EnvIndex < 0 || EnvIndex >= static_cast<int>(JsEnvList.size()))
+    {
+        UE_LOG(Puerts, Error, TEXT("CreateWorker: invalid env index %d, group size %d"), EnvIndex, static_cast<int>(JsEnvList.size()));
+        return 0;
+    }
+    return static_cast<FJsEnvImpl*>(JsEnvList[EnvIndex].get())->CreateWorker(ModuleName);
+#else
+    return 0;
+#endif
+}
+
 }    // namespace PUERTS_NAMESPACE
 #endif
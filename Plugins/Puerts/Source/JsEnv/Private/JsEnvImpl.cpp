@@ -25,6 +25,9 @@
 #endif
 #include "JSClassRegister.h"
 #include "PromiseRejectCallback.hpp"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "JsTrace.h"
 #if !defined(ENGINE_INDEPENDENT_JSENV)
 #include "TypeScriptGeneratedClass.h"
 #include "Engine/UserDefinedEnum.h"
@@ -89,6 +92,29 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 void InitWebsocketPPWrap(v8::Local<v8::Context> Context);
 #endif
 
+DECLARE_CYCLE_STAT(TEXT("TickTimers"), STAT_Puerts_TickTimers, STATGROUP_Puerts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Timers"), STAT_Puerts_LiveTimers, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timer Callbacks"), STAT_Puerts_TimerCallbacks, STATGROUP_Puerts);
+DECLARE_CYCLE_STAT(TEXT("TickWorkers"), STAT_Puerts_TickWorkers, STATGROUP_Puerts);
+DECLARE_CYCLE_STAT(TEXT("IdleNotification"), STAT_Puerts_IdleNotification, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Objects Deleted"), STAT_Puerts_ObjectsDeleted, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deleted Objects Processed"), STAT_Puerts_DeletedObjectsProcessed, STATGROUP_Puerts);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("GC Pause (ms)"), STAT_Puerts_GCPause, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("GC Count"), STAT_Puerts_GCCount, STATGROUP_Puerts);
+DECLARE_MEMORY_STAT(TEXT("Heap Used"), STAT_Puerts_HeapUsed, STATGROUP_Puerts);
+DECLARE_MEMORY_STAT(TEXT("Heap Total"), STAT_Puerts_HeapTotal, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Worker Messages Sent"), STAT_Puerts_WorkerMessagesSent, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Worker Messages Received"), STAT_Puerts_WorkerMessagesReceived, STATGROUP_Puerts);
+DECLARE_CYCLE_STAT(TEXT("CheckDelegateProxies"), STAT_Puerts_CheckDelegateProxies, STATGROUP_Puerts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Delegates"), STAT_Puerts_LiveDelegates, STATGROUP_Puerts);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending Delegate Removals"), STAT_Puerts_PendingDelegateRemovals, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Delegates Reclaimed"), STAT_Puerts_DelegatesReclaimed, STATGROUP_Puerts);
+
+static TAutoConsoleVariable<float> CVarPuertsDelegateCleanupBudgetMs(TEXT("Puerts.DelegateCleanupBudgetMs"), 0.5f,
+    TEXT("Time budget per frame for releasing delegates whose owner has been destroyed. <= 0: release all pending delegates "
+         "in one frame"),
+    ECVF_Default);
+
 namespace PUERTS_NAMESPACE
 {
 #if !defined(WITH_QUICKJS)
@@ -348,6 +374,8 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     std::function<void(const FString&)> InOnSourceLoadedCallback, const FString InFlags, void* InExternalRuntime,
     void* InExternalContext)
 {
+    CreateTime = FPlatformTime::Seconds();
+
     GUObjectArray.AddUObjectDeleteListener(static_cast<FUObjectArray::FUObjectDeleteListener*>(this));
 
     if (!InFlags.IsEmpty())
@@ -456,6 +484,11 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 
     DefaultContext.Reset(Isolate, Context);
 
+#ifndef WITH_QUICKJS
+    Isolate->AddGCPrologueCallback(&FJsEnvImpl::OnGCPrologue, this);
+    Isolate->AddGCEpilogueCallback(&FJsEnvImpl::OnGCEpilogue, this);
+#endif
+
     v8::Context::Scope ContextScope(Context);
 
 #if defined(WITH_NODEJS)
@@ -558,6 +591,14 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 
     MethodBindingHelper<&FJsEnvImpl::DumpStatisticsLog>::Bind(Isolate, Context, Global, "dumpStatisticsLog", This);
 
+#ifndef WITH_QUICKJS
+    MethodBindingHelper<&FJsEnvImpl::CreateWorker>::Bind(Isolate, Context, Global, "__tgjsCreateWorker", This);
+    MethodBindingHelper<&FJsEnvImpl::PostMessageToWorker>::Bind(Isolate, Context, Global, "__tgjsPostMessageToWorker", This);
+    MethodBindingHelper<&FJsEnvImpl::TerminateWorker>::Bind(Isolate, Context, Global, "__tgjsTerminateWorker", This);
+    MethodBindingHelper<&FJsEnvImpl::SetWorkerMessageHandler>::Bind(
+        Isolate, Context, Global, "__tgjsSetWorkerMessageHandler", This);
+#endif
+
     Global
         ->Set(Context, FV8Utils::ToV8String(Isolate, "__tgjsFNameToArrayBuffer"),
             v8::FunctionTemplate::New(Isolate, FNameToArrayBuffer)->GetFunction(Context).ToLocalChecked())
@@ -618,6 +659,10 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 
     Inspector = CreateV8Inspector(InDebugPort, &Context);
 
+    const double BootstrapStartTime = FPlatformTime::Seconds();
+#ifndef WITH_QUICKJS
+    CodeCache.SetTrackCompiled(true);
+#endif
     ExecuteModule("puerts/first_run.js");
 #if !defined(WITH_NODEJS)
     ExecuteModule("puerts/polyfill.js");
@@ -627,6 +672,7 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     ExecuteModule("puerts/uelazyload.js");
     ExecuteModule("puerts/events.js");
     ExecuteModule("puerts/promises.js");
+    ExecuteModule("puerts/worker.js");
     ExecuteModule("puerts/argv.js");
     ExecuteModule("puerts/jit_stub.js");
     ExecuteModule("puerts/hot_reload.js");
@@ -654,7 +700,13 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
 #endif
 
     DelegateProxiesCheckerHandler =
-        FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::CheckDelegateProxies), 1);
+        FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::CheckDelegateProxies), 0);
+
+    TimerTickerHandle = FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::TickTimers), 0);
+
+#ifndef WITH_QUICKJS
+    WorkerTickerHandle = FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJsEnvImpl::TickWorkers), 0);
+#endif
 
     ManualReleaseCallbackMap.Reset(Isolate, v8::Map::New(Isolate));
 
@@ -692,6 +744,15 @@ FJsEnvImpl::FJsEnvImpl(std::shared_ptr<IJSModuleLoader> InModuleLoader, std::sha
     auto rt = Isolate->runtime_;
     JS_SetMaxStackSize(rt, 1024 * 1024);
 #endif
+
+    BootstrapTimeMs = (FPlatformTime::Seconds() - BootstrapStartTime) * 1000.0;
+#ifndef WITH_QUICKJS
+    // 启动脚本都已执行过，重新生成一次缓存，把执行中编译的函数也带上
+    CodeCache.FlushTracked(Isolate, true);
+    CodeCache.SetTrackCompiled(FJsCodeCache::IncludeUserModules());
+#endif
+    ConstructTimeMs = (FPlatformTime::Seconds() - CreateTime) * 1000.0;
+    UE_LOG(Puerts, Log, TEXT("JsEnv created in %.2f ms (bootstrap scripts %.2f ms)"), ConstructTimeMs, BootstrapTimeMs);
 }
 
 // #lizard forgives
@@ -715,6 +776,8 @@ FJsEnvImpl::~FJsEnvImpl()
     StopPolling();
 #endif
 
+    FCoreDelegates::OnEndFrame.Remove(FirstFrameHandle);
+
 #ifndef WITH_QUICKJS
     for (auto& KV : HashToModuleInfo)
     {
@@ -739,6 +802,12 @@ FJsEnvImpl::~FJsEnvImpl()
     JsPromiseRejectCallback.Reset();
 
     FUETicker::GetCoreTicker().RemoveTicker(DelegateProxiesCheckerHandler);
+    FUETicker::GetCoreTicker().RemoveTicker(TimerTickerHandle);
+#ifndef WITH_QUICKJS
+    FUETicker::GetCoreTicker().RemoveTicker(WorkerTickerHandle);
+    // 先停掉worker线程，它们引用着ModuleLoader和Logger
+    Workers.Empty();
+#endif
 
     {
         auto Isolate = MainIsolate;
@@ -754,15 +823,7 @@ FJsEnvImpl::~FJsEnvImpl()
 
         ObjectMap.Empty();
 
-        for (auto& KV : StructCache)
-        {
-            FObjectCacheNode* PNode = &KV.Value;
-            while (PNode)
-            {
-                PNode->Value.Reset();
-                PNode = PNode->Next;
-            }
-        }
+        StructCache.ForEach([](const FStructCacheKey& Key, FStructCacheValue& CacheValue) { CacheValue.Value.Reset(); });
 
         for (auto& KV : ContainerCache)
         {
@@ -798,6 +859,8 @@ FJsEnvImpl::~FJsEnvImpl()
             }
             Iter->second.JsCallbacks.Reset();
         }
+        DEC_DWORD_STAT_BY(STAT_Puerts_LiveDelegates, DelegateMap.size());
+        DEC_DWORD_STAT_BY(STAT_Puerts_PendingDelegateRemovals, PendingDelegateRemovals.Num());
 
         for (auto& KV : AutoReleaseCallbacksMap)
         {
@@ -821,9 +884,13 @@ FJsEnvImpl::~FJsEnvImpl()
         for (auto Iter = TimerInfos.CreateIterator(); Iter; ++Iter)
         {
             Iter->Value.Callback.Reset();
-            FUETicker::GetCoreTicker().RemoveTicker(Iter->Value.TickerHandle);
         }
+        DEC_DWORD_STAT_BY(STAT_Puerts_LiveTimers, TimerInfos.Num());
         TimerInfos.Empty();
+        TimerWheel.Reset();
+#ifndef WITH_QUICKJS
+        WorkerMessageHandler.Reset();
+#endif
 
 #if !defined(ENGINE_INDEPENDENT_JSENV)
         for (auto& GeneratedClass : GeneratedClasses)
@@ -905,6 +972,15 @@ FJsEnvImpl::~FJsEnvImpl()
 #endif
 
     DefaultContext.Reset();
+#ifndef WITH_QUICKJS
+    Profiler.reset();
+    MainIsolate->RemoveGCPrologueCallback(&FJsEnvImpl::OnGCPrologue, this);
+    MainIsolate->RemoveGCEpilogueCallback(&FJsEnvImpl::OnGCEpilogue, this);
+    DEC_MEMORY_STAT_BY(STAT_Puerts_HeapUsed, ReportedHeapUsed);
+    DEC_MEMORY_STAT_BY(STAT_Puerts_HeapTotal, ReportedHeapTotal);
+    // 没有Start过的env还在跟踪编译，脚本句柄必须在isolate销毁前释放
+    StopTrackingCompiled(false);
+#endif
     MainIsolate->Dispose();
     MainIsolate = nullptr;
     delete CreateParams.array_buffer_allocator;
@@ -912,19 +988,15 @@ FJsEnvImpl::~FJsEnvImpl()
     GUObjectArray.RemoveUObjectDeleteListener(static_cast<FUObjectArray::FUObjectDeleteListener*>(this));
 
     // quickjs will call UnBind in vm dispose, so cleanup move to here
-    for (auto& KV : StructCache)
-    {
-        FObjectCacheNode* PNode = &KV.Value;
-        while (PNode)
+    StructCache.ForEach(
+        [](const FStructCacheKey& Key, FStructCacheValue& CacheValue)
         {
-            if (PNode->UserData)
+            if (CacheValue.UserData)
             {
-                FScriptStructWrapper* ScriptStructWrapper = (FScriptStructWrapper*) (PNode->UserData);
-                ScriptStructWrapper->Free(KV.Key);
+                FScriptStructWrapper* ScriptStructWrapper = (FScriptStructWrapper*) (CacheValue.UserData);
+                ScriptStructWrapper->Free(Key.Ptr);
             }
-            PNode = PNode->Next;
-        }
-    }
+        });
     StructCache.Empty();
 }
 
@@ -1156,6 +1228,99 @@ bool FJsEnvImpl::IdleNotificationDeadline(double DeadlineInSeconds)
 #endif
 }
 
+bool FJsEnvImpl::IdleNotification(double IdleTimeInSeconds)
+{
+#ifndef WITH_QUICKJS
+    SCOPE_CYCLE_COUNTER(STAT_Puerts_IdleNotification);
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    // IdleNotificationDeadline的deadline要用v8平台的时钟，和FPlatformTime::Seconds的基准不一样
+#if defined(WITH_NODEJS)
+    auto Platform = static_cast<node::MultiIsolatePlatform*>(IJsEnvModule::Get().GetV8Platform());
+#else
+    auto Platform = static_cast<v8::Platform*>(IJsEnvModule::Get().GetV8Platform());
+#endif
+    ++IdleNotificationCount;
+    IdleNotificationTotalMs += IdleTimeInSeconds * 1000.0;
+    bool Finished = IdleNotificationDeadline(Platform->MonotonicallyIncreasingTime() + IdleTimeInSeconds);
+    UpdateHeapStatistics();
+    return Finished;
+#else
+    return true;
+#endif
+}
+
+#ifndef WITH_QUICKJS
+#if PUERTS_TRACE_ENABLED
+static const TCHAR* GetGCTraceName(v8::GCType Type)
+{
+    switch (Type)
+    {
+        case v8::kGCTypeScavenge:
+            return TEXT("JsGC Scavenge");
+        case v8::kGCTypeMinorMarkCompact:
+            return TEXT("JsGC MinorMarkCompact");
+        case v8::kGCTypeMarkSweepCompact:
+            return TEXT("JsGC MarkSweepCompact");
+        case v8::kGCTypeIncrementalMarking:
+            return TEXT("JsGC IncrementalMarking");
+        case v8::kGCTypeProcessWeakCallbacks:
+            return TEXT("JsGC ProcessWeakCallbacks");
+        default:
+            return TEXT("JsGC");
+    }
+}
+#endif
+
+void FJsEnvImpl::OnGCPrologue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data)
+{
+    FJsEnvImpl* Self = static_cast<FJsEnvImpl*>(Data);
+    Self->GCStartTime = FPlatformTime::Seconds();
+#if PUERTS_TRACE_ENABLED
+    // 记下是否已经开始了事件，避免gc过程中通道被打开导致epilogue多出一个End
+    Self->TracingGC = UE_TRACE_CHANNELEXPR_IS_ENABLED(PuertsGCChannel | CpuChannel);
+    if (Self->TracingGC)
+    {
+        FCpuProfilerTrace::OutputBeginDynamicEvent(GetGCTraceName(Type));
+    }
+#endif
+}
+
+void FJsEnvImpl::OnGCEpilogue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data)
+{
+    FJsEnvImpl* Self = static_cast<FJsEnvImpl*>(Data);
+#if PUERTS_TRACE_ENABLED
+    if (Self->TracingGC)
+    {
+        FCpuProfilerTrace::OutputEndEvent();
+        Self->TracingGC = false;
+    }
+#endif
+    const double PauseMs = (FPlatformTime::Seconds() - Self->GCStartTime) * 1000.0;
+    ++Self->GCCount;
+    Self->GCTotalPauseMs += PauseMs;
+    Self->GCMaxPauseMs = FMath::Max(Self->GCMaxPauseMs, PauseMs);
+    INC_FLOAT_STAT_BY(STAT_Puerts_GCPause, PauseMs);
+    INC_DWORD_STAT(STAT_Puerts_GCCount);
+    Self->UpdateHeapStatistics();
+}
+
+void FJsEnvImpl::UpdateHeapStatistics()
+{
+#if STATS
+    v8::HeapStatistics Statistics;
+    MainIsolate->GetHeapStatistics(&Statistics);
+    const int64 HeapUsed = static_cast<int64>(Statistics.used_heap_size());
+    const int64 HeapTotal = static_cast<int64>(Statistics.total_heap_size());
+    INC_MEMORY_STAT_BY(STAT_Puerts_HeapUsed, HeapUsed - ReportedHeapUsed);
+    INC_MEMORY_STAT_BY(STAT_Puerts_HeapTotal, HeapTotal - ReportedHeapTotal);
+    ReportedHeapUsed = HeapUsed;
+    ReportedHeapTotal = HeapTotal;
+#endif
+}
+#endif
+
 void FJsEnvImpl::LowMemoryNotification()
 {
 #ifdef SINGLE_THREAD_VERIFY
@@ -1167,6 +1332,90 @@ void FJsEnvImpl::LowMemoryNotification()
     MainIsolate->LowMemoryNotification();
 }
 
+bool FJsEnvImpl::StartCpuProfile(int32 SamplingIntervalUs)
+{
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+#ifndef WITH_QUICKJS
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    if (!Profiler)
+    {
+        Profiler = std::make_unique<FJsProfiler>(MainIsolate);
+    }
+    if (!Profiler->StartCpuProfile(SamplingIntervalUs))
+    {
+        Logger->Warn(TEXT("start cpu profile fail, is it already started?"));
+        return false;
+    }
+    Logger->Info(TEXT("cpu profile started"));
+    return true;
+#else
+    Logger->Warn(TEXT("cpu profile is not supported by quickjs backend"));
+    return false;
+#endif
+}
+
+FString FJsEnvImpl::StopCpuProfile(const FString& FilePath)
+{
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+#ifndef WITH_QUICKJS
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    if (!Profiler || !Profiler->IsCpuProfiling())
+    {
+        Logger->Warn(TEXT("stop cpu profile fail, cpu profile not started"));
+        return FString();
+    }
+    const FString OutputPath = Profiler->StopCpuProfile(FilePath);
+    if (OutputPath.IsEmpty())
+    {
+        Logger->Error(TEXT("write cpu profile fail"));
+    }
+    else
+    {
+        Logger->Info(FString::Printf(TEXT("cpu profile saved to %s"), *OutputPath));
+    }
+    return OutputPath;
+#else
+    return FString();
+#endif
+}
+
+FString FJsEnvImpl::TakeHeapSnapshot(const FString& FilePath)
+{
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+#ifndef WITH_QUICKJS
+#ifdef THREAD_SAFE
+    v8::Locker Locker(MainIsolate);
+#endif
+    if (!Profiler)
+    {
+        Profiler = std::make_unique<FJsProfiler>(MainIsolate);
+    }
+    const FString OutputPath = Profiler->TakeHeapSnapshot(FilePath);
+    if (OutputPath.IsEmpty())
+    {
+        Logger->Error(TEXT("write heap snapshot fail"));
+    }
+    else
+    {
+        Logger->Info(FString::Printf(TEXT("heap snapshot saved to %s"), *OutputPath));
+    }
+    return OutputPath;
+#else
+    Logger->Warn(TEXT("heap snapshot is not supported by quickjs backend"));
+    return FString();
+#endif
+}
+
 void FJsEnvImpl::RequestMinorGarbageCollectionForTesting()
 {
 #ifdef THREAD_SAFE
@@ -1264,6 +1513,7 @@ void FJsEnvImpl::MakeSureInject(UTypeScriptGeneratedClass* TypeScriptGeneratedCl
                 BindInfo.Prototype.Reset(Isolate, v8::Object::New(Isolate));
                 BindInfo.InjectNotFinished = true;
                 BindInfoMap.Emplace(TypeScriptGeneratedClass, std::move(BindInfo));
+                MarkKnownObject(TypeScriptGeneratedClass);
             }
 
             v8::TryCatch TryCatch(Isolate);
@@ -1368,6 +1618,7 @@ void FJsEnvImpl::MakeSureInject(UTypeScriptGeneratedClass* TypeScriptGeneratedCl
                                             Function, {v8::UniquePersistent<v8::Function>(
                                                            Isolate, v8::Local<v8::Function>::Cast(MaybeValue.ToLocalChecked())),
                                                           std::make_unique<FFunctionTranslator>(Function, false)});
+                                        MarkKnownObject(Function);
                                     }
                                     else
                                     {
@@ -1747,6 +1998,7 @@ void FJsEnvImpl::Bind(FClassWrapper* ClassWrapper, UObject* UEObject,
     DataTransfer::SetPointer(MainIsolate, JSObject, UEObject, 0);
     DataTransfer::SetPointer(MainIsolate, JSObject, nullptr, 1);
     ObjectMap.Emplace(UEObject, v8::UniquePersistent<v8::Value>(MainIsolate, JSObject));
+    MarkKnownObject(UEObject);
 
     if (!IsNativeTakeJsRef)
     {
@@ -1757,7 +2009,7 @@ void FJsEnvImpl::Bind(FClassWrapper* ClassWrapper, UObject* UEObject,
 void FJsEnvImpl::SetJsTakeRef(UObject* UEObject, FClassWrapper* ClassWrapper)
 {
     UserObjectRetainer.Retain(UEObject);
-    ObjectMap[UEObject].SetWeak<UClass>(
+    ObjectMap.FindChecked(UEObject).SetWeak<UClass>(
         Cast<UClass>(ClassWrapper->Struct.Get()), FClassWrapper::OnGarbageCollected, v8::WeakCallbackType::kInternalFields);
 }
 
@@ -1830,14 +2082,10 @@ v8::Local<v8::Value> FJsEnvImpl::FindOrAddStruct(
         return v8::Null(Isolate);
     }
 
-    auto HeaderPtr = StructCache.Find(Ptr);
-    if (HeaderPtr)
+    auto CacheValuePtr = StructCache.Find({Ptr, ScriptStruct});
+    if (CacheValuePtr)
     {
-        auto CacheNodePtr = HeaderPtr->Find(ScriptStruct);
-        if (CacheNodePtr)
-        {
-            return CacheNodePtr->Value.Get(Isolate);
-        }
+        return CacheValuePtr->Value.Get(Isolate);
     }
 
     // create and link
@@ -1870,7 +2118,7 @@ v8::Local<v8::Value> FJsEnvImpl::FindOrAddDelegate(v8::Isolate* Isolate, v8::Loc
             }
             else
             {
-                ClearDelegate(Isolate, Context, DelegatePtr);
+                RemoveDelegate(Isolate, Context, Iter);
             }
         }
     }
@@ -1908,9 +2156,12 @@ v8::Local<v8::Value> FJsEnvImpl::FindOrAddDelegate(v8::Isolate* Isolate, v8::Loc
         {
             Function = MulticastDelegateProperty->SignatureFunction;
         }
-        DelegateMap[DelegatePtr] = {v8::UniquePersistent<v8::Object>(Isolate, JSObject), TWeakObjectPtr<UObject>(Owner),
-            DelegateProperty, MulticastDelegateProperty, Function, PassByPointer, nullptr,
-            v8::UniquePersistent<v8::Array>(Isolate, v8::Array::New(Isolate))};
+        DelegateObjectInfo& DelegateInfo = DelegateMap[DelegatePtr];
+        DelegateInfo = {v8::UniquePersistent<v8::Object>(Isolate, JSObject), TWeakObjectPtr<UObject>(Owner), DelegateProperty,
+            MulticastDelegateProperty, Function, PassByPointer, nullptr, v8::UniquePersistent<v8::Array>(Isolate, v8::Array::New(Isolate)),
+            Owner, ++DelegateGeneration};
+        INC_DWORD_STAT(STAT_Puerts_LiveDelegates);
+        TrackDelegate(DelegatePtr, DelegateInfo);
         return JSObject;
     }
 }
@@ -1929,6 +2180,7 @@ void FJsEnvImpl::InvokeDelegateCallback(UDynamicDelegateProxy* Proxy, void* Para
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
 #endif
+    PUERTS_TRACE_SCOPE(PuertsCallChannel, TEXT("JsDelegate ") + GetTraceName(Proxy->SignatureFunction.Get()));
     auto SignatureFunction = Proxy->SignatureFunction;
     auto Iter = JsCallbackPrototypeMap.find(SignatureFunction.Get());
     if (Iter == JsCallbackPrototypeMap.end())
@@ -1938,6 +2190,7 @@ void FJsEnvImpl::InvokeDelegateCallback(UDynamicDelegateProxy* Proxy, void* Para
             Logger->Warn(TEXT("invalid SignatureFunction!"));
             return;
         }
+        MarkKnownObject(SignatureFunction.Get());
         JsCallbackPrototypeMap[SignatureFunction.Get()] = std::make_unique<FFunctionTranslator>(SignatureFunction.Get(), true);
         Iter = JsCallbackPrototypeMap.find(SignatureFunction.Get());
     }
@@ -1953,6 +2206,7 @@ void FJsEnvImpl::InvokeDelegateCallback(UDynamicDelegateProxy* Proxy, void* Para
         // 非 Editor 模式，函数签名地址可能会变且内存可能复用，不检查可能会访问到旧的非法地址。
         if (!Iter->second->IsValid())
         {
+            MarkKnownObject(SignatureFunction.Get());
             JsCallbackPrototypeMap[SignatureFunction.Get()] = std::make_unique<FFunctionTranslator>(SignatureFunction.Get(), true);
             Iter = JsCallbackPrototypeMap.find(SignatureFunction.Get());
         }
@@ -1993,6 +2247,7 @@ void FJsEnvImpl::JsConstruct(UClass* Class, UObject* Object, const v8::UniquePer
     // 过时功能(makeUClass)用不影响现有功能的方式修改
     UnBind(Class, Object);
     ObjectMap.Emplace(Object, v8::UniquePersistent<v8::Value>(MainIsolate, JSObject));
+    MarkKnownObject(Object);
 
     if (!Prototype.IsEmpty())
     {
@@ -2106,6 +2361,16 @@ void FJsEnvImpl::NotifyUObjectDeleted(const class UObjectBase* ObjectBase, int32
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
 #endif
+    INC_DWORD_STAT(STAT_Puerts_ObjectsDeleted);
+    ++DeletedObjectCount;
+    // 绝大多数被删除的对象js从没接触过，下面的查表都会落空，先用位图过滤
+    if (!KnownObjects.TestAndClear(Index))
+    {
+        return;
+    }
+    INC_DWORD_STAT(STAT_Puerts_DeletedObjectsProcessed);
+    ++ProcessedDeletedObjectCount;
+
 #ifdef THREAD_SAFE
     v8::Locker Locker(MainIsolate);
 #endif
@@ -2120,6 +2385,16 @@ void FJsEnvImpl::NotifyUObjectDeleted(const class UObjectBase* ObjectBase, int32
 
     GeneratedClasses.Remove((UClass*) ObjectBase);
 
+    // 挂在这个对象上的delegate交给CheckDelegateProxies分帧回收
+    TArray<FDelegateRef> OwnedDelegates;
+    if (DelegatesByOwner.RemoveAndCopyValue(ObjectBase, OwnedDelegates))
+    {
+        INC_DWORD_STAT_BY(STAT_Puerts_PendingDelegateRemovals, OwnedDelegates.Num());
+        PendingDelegateRemovals.Append(MoveTemp(OwnedDelegates));
+    }
+
+    JsCallbackPrototypeMap.erase((UFunction*) ObjectBase);
+
     TsFunctionMap.Remove((UFunction*) ObjectBase);
     MixinFunctionMap.Remove((UFunction*) ObjectBase);
     ContainerMeta.NotifyElementTypeDeleted((UField*) ObjectBase);
@@ -2186,6 +2461,7 @@ void FJsEnvImpl::InvokeJsMethod(UObject* ContextObject, UJSGeneratedFunction* Fu
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
 #endif
+    PUERTS_TRACE_SCOPE(PuertsCallChannel, TEXT("JsMethod ") + GetTraceName(Function));
     auto Isolate = MainIsolate;
 #ifdef THREAD_SAFE
     v8::Locker Locker(Isolate);
@@ -2227,6 +2503,7 @@ void FJsEnvImpl::InvokeMixinMethod(UObject* ContextObject, UJSGeneratedFunction*
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
 #endif
+    PUERTS_TRACE_SCOPE(PuertsCallChannel, TEXT("JsMixin ") + GetTraceName(Function));
     auto Isolate = MainIsolate;
 #ifdef THREAD_SAFE
     v8::Locker Locker(Isolate);
@@ -2276,6 +2553,7 @@ void FJsEnvImpl::InvokeTsMethod(UObject* ContextObject, UFunction* Function, FFr
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
 #endif
+    PUERTS_TRACE_SCOPE(PuertsCallChannel, TEXT("JsTsMethod ") + GetTraceName(Function));
 #ifdef THREAD_SAFE
     v8::Locker Locker(MainIsolate);
 #endif
@@ -2380,6 +2658,10 @@ void FJsEnvImpl::ExecuteDelegate(
     auto SignatureFunction = Iter->second.SignatureFunction;
     if (JsCallbackPrototypeMap.find(SignatureFunction) == JsCallbackPrototypeMap.end())
     {
+        if (SignatureFunction)
+        {
+            MarkKnownObject(SignatureFunction);
+        }
         JsCallbackPrototypeMap[SignatureFunction] = std::make_unique<FFunctionTranslator>(SignatureFunction, true);
     }
 
@@ -2411,12 +2693,7 @@ bool FJsEnvImpl::AddToDelegate(
     if (!Iter->second.Owner.IsValid())
     {
         Logger->Warn("try to bind a delegate with invalid owner!");
-        ClearDelegate(Isolate, Context, DelegatePtr);
-        if (!Iter->second.PassByPointer)
-        {
-            delete ((FScriptDelegate*) Iter->first);
-        }
-        DelegateMap.erase(Iter);
+        RemoveDelegate(Isolate, Context, Iter);
         return false;
     }
 
@@ -2549,6 +2826,7 @@ FScriptDelegate FJsEnvImpl::NewDelegate(v8::Isolate* Isolate, v8::Local<v8::Cont
     if (Owner)
     {
         TArray<TWeakObjectPtr<UDynamicDelegateProxy>>& Callbacks = AutoReleaseCallbacksMap.FindOrAdd(Owner);
+        MarkKnownObject(Owner);
 
         DelegateProxy = NewObject<UDynamicDelegateProxy>();
 #ifdef THREAD_SAFE
@@ -2651,12 +2929,7 @@ bool FJsEnvImpl::RemoveFromDelegate(
     if (!Iter->second.Owner.IsValid())
     {
         Logger->Warn("try to unbind a delegate with invalid owner!");
-        ClearDelegate(Isolate, Context, DelegatePtr);
-        if (!Iter->second.PassByPointer)
-        {
-            delete ((FScriptDelegate*) Iter->first);
-        }
-        DelegateMap.erase(Iter);
+        RemoveDelegate(Isolate, Context, Iter);
         return false;
     }
 
@@ -2747,59 +3020,88 @@ bool FJsEnvImpl::ClearDelegate(v8::Isolate* Isolate, v8::Local<v8::Context>& Con
     return true;
 }
 
-bool FJsEnvImpl::CheckDelegateProxies(float Tick)
+void FJsEnvImpl::TrackDelegate(void* DelegatePtr, const DelegateObjectInfo& DelegateInfo)
 {
-#ifdef SINGLE_THREAD_VERIFY
-    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
-#endif
-    auto Isolate = MainIsolate;
-#ifdef THREAD_SAFE
-    v8::Locker Locker(Isolate);
-#endif
-
-    std::vector<void*> PendingToRemove;
-    for (auto& KV : DelegateMap)
+    const FDelegateRef DelegateRef(DelegatePtr, DelegateInfo.Generation);
+    if (DelegateInfo.Owner.IsValid())
     {
-        if (!KV.second.Owner.IsValid())
-        {
-            PendingToRemove.push_back(KV.first);
-        }
+        MarkKnownObject(DelegateInfo.OwnerKey);
+        DelegatesByOwner.FindOrAdd(DelegateInfo.OwnerKey).Add(DelegateRef);
+    }
+    else
+    {
+        // 没有owner（或owner已经失效）的delegate不会收到删除通知，直接排队
+        INC_DWORD_STAT(STAT_Puerts_PendingDelegateRemovals);
+        PendingDelegateRemovals.Add(DelegateRef);
     }
+}
 
-    if (PendingToRemove.size() > 0)
+void FJsEnvImpl::RemoveDelegate(
+    v8::Isolate* Isolate, v8::Local<v8::Context>& Context, std::map<void*, DelegateObjectInfo>::iterator Iter)
+{
+    ClearDelegate(Isolate, Context, Iter->first);
+    if (TArray<FDelegateRef>* OwnedDelegates = DelegatesByOwner.Find(Iter->second.OwnerKey))
     {
-        v8::Isolate::Scope IsolateScope(Isolate);
-        v8::HandleScope HandleScope(Isolate);
-        v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
-        v8::Context::Scope ContextScope(Context);
-        for (int i = 0; i < PendingToRemove.size(); ++i)
+        OwnedDelegates->RemoveSingleSwap(FDelegateRef(Iter->first, Iter->second.Generation));
+        if (OwnedDelegates->Num() == 0)
         {
-            ClearDelegate(Isolate, Context, PendingToRemove[i]);
-            if (!DelegateMap[PendingToRemove[i]].PassByPointer)
-            {
-                delete ((FScriptDelegate*) PendingToRemove[i]);
-            }
-            DelegateMap.erase(PendingToRemove[i]);
+            DelegatesByOwner.Remove(Iter->second.OwnerKey);
         }
     }
+    if (!Iter->second.PassByPointer)
+    {
+        delete ((FScriptDelegate*) Iter->first);
+    }
+    DelegateMap.erase(Iter);
+    DEC_DWORD_STAT(STAT_Puerts_LiveDelegates);
+}
 
-    // Collecting invalid function translators to remove.
-    std::vector<UFunction*> PendingToRemoveJsCallbacks;
-    for (auto& KV : JsCallbackPrototypeMap)
+bool FJsEnvImpl::CheckDelegateProxies(float Tick)
+{
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+    // 失效的delegate由NotifyUObjectDeleted入队，这里不再扫描整个DelegateMap
+    if (PendingDelegateRemovals.Num() == 0)
     {
-        if ((nullptr == KV.first) || (!KV.second->IsValid()))
-        {
-            PendingToRemoveJsCallbacks.push_back(KV.first);
-        }
+        return true;
     }
 
-    if (PendingToRemoveJsCallbacks.size() > 0)
+    SCOPE_CYCLE_COUNTER(STAT_Puerts_CheckDelegateProxies);
+
+    auto Isolate = MainIsolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+
+    const double BudgetSeconds = CVarPuertsDelegateCleanupBudgetMs.GetValueOnGameThread() / 1000.0;
+    const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
+    int32 Processed = 0;
+    int32 Reclaimed = 0;
+    while (Processed < PendingDelegateRemovals.Num())
     {
-        for (int32 i = 0; i < PendingToRemoveJsCallbacks.size(); i++)
+        const FDelegateRef DelegateRef = PendingDelegateRemovals[Processed++];
+        auto Iter = DelegateMap.find(DelegateRef.Key);
+        // 已经被AddToDelegate/RemoveFromDelegate等路径删掉，或者地址被新的delegate复用
+        if (Iter != DelegateMap.end() && Iter->second.Generation == DelegateRef.Value)
+        {
+            RemoveDelegate(Isolate, Context, Iter);
+            ++Reclaimed;
+        }
+        // 每16个检查一次时间，剩下的留到下一帧
+        if (BudgetSeconds > 0 && (Processed & 15) == 0 && FPlatformTime::Seconds() >= Deadline)
         {
-            JsCallbackPrototypeMap.erase(PendingToRemoveJsCallbacks[i]);
+            break;
         }
     }
+    PendingDelegateRemovals.RemoveAt(0, Processed);
+    ReclaimedDelegateCount += Reclaimed;
+    DEC_DWORD_STAT_BY(STAT_Puerts_PendingDelegateRemovals, Processed);
+    INC_DWORD_STAT_BY(STAT_Puerts_DelegatesReclaimed, Reclaimed);
 
     return true;
 }
@@ -2931,34 +3233,18 @@ void FJsEnvImpl::BindStruct(
 #endif
         }
 #endif
-        auto CacheNodePtr = StructCache.Find(Ptr);
-        if (CacheNodePtr)
-        {
-            auto Temp = CacheNodePtr->Find(ScriptStructWrapper->Struct.Get());
-            CacheNodePtr = Temp ? Temp : CacheNodePtr->Add(ScriptStructWrapper->Struct.Get());
-        }
-        else
-        {
-            CacheNodePtr = &StructCache.Emplace(Ptr, FObjectCacheNode(ScriptStructWrapper->Struct.Get()));
-        }
-        CacheNodePtr->Value.Reset(MainIsolate, JSObject);
-        CacheNodePtr->UserData = ScriptStructWrapper;
-        CacheNodePtr->Value.SetWeak<FScriptStructWrapper>(
+        FStructCacheValue& CacheValue = StructCache.FindOrAdd({Ptr, ScriptStructWrapper->Struct.Get()});
+        CacheValue.Value.Reset(MainIsolate, JSObject);
+        CacheValue.UserData = ScriptStructWrapper;
+        CacheValue.Value.SetWeak<FScriptStructWrapper>(
             ScriptStructWrapper, FScriptStructWrapper::OnGarbageCollectedWithFree, v8::WeakCallbackType::kInternalFields);
     }
     else
     {
-        auto CacheNodePtr = StructCache.Find(Ptr);
-        if (CacheNodePtr)
-        {
-            CacheNodePtr = CacheNodePtr->Add(ScriptStructWrapper->Struct.Get());
-        }
-        else
-        {
-            CacheNodePtr = &StructCache.Emplace(Ptr, FObjectCacheNode(ScriptStructWrapper->Struct.Get()));
-        }
-        CacheNodePtr->Value.Reset(MainIsolate, JSObject);
-        CacheNodePtr->Value.SetWeak<FScriptStructWrapper>(
+        FStructCacheValue& CacheValue = StructCache.FindOrAdd({Ptr, ScriptStructWrapper->Struct.Get()});
+        CacheValue.Value.Reset(MainIsolate, JSObject);
+        CacheValue.UserData = nullptr;
+        CacheValue.Value.SetWeak<FScriptStructWrapper>(
             ScriptStructWrapper, FScriptStructWrapper::OnGarbageCollected, v8::WeakCallbackType::kInternalFields);
     }
 }
@@ -2986,15 +3272,7 @@ v8::MaybeLocal<v8::Function> FJsEnvImpl::LoadTypeById(v8::Local<v8::Context> Con
 
 void FJsEnvImpl::UnBindStruct(FScriptStructWrapper* ScriptStructWrapper, void* Ptr)
 {
-    auto CacheNodePtr = StructCache.Find(Ptr);
-    if (CacheNodePtr)
-    {
-        (void) (CacheNodePtr->Remove(ScriptStructWrapper->Struct.Get(), true));
-        if (!CacheNodePtr->TypeId)    // last one
-        {
-            StructCache.Remove(Ptr);
-        }
-    }
+    StructCache.Remove({Ptr, ScriptStructWrapper->Struct.Get()});
 }
 
 void FJsEnvImpl::UnBindCppObject(v8::Isolate* Isolate, JSClassDefinition* ClassDefinition, void* Ptr)
@@ -3129,6 +3407,7 @@ FJsEnvImpl::FTemplateInfo* FJsEnvImpl::GetTemplateInfoOfType(UStruct* InStruct,
         }
 
         Existed = false;
+        MarkKnownObject(InStruct);
         return &TypeToTemplateInfoMap.Add(InStruct, {v8::UniquePersistent<v8::FunctionTemplate>(Isolate, Template), StructWrapper});
     }
     else
@@ -3416,6 +3695,7 @@ bool FJsEnvImpl::GetContainerTypeProperty(v8::Local<v8::Context> Context, v8::Lo
     else if (auto Field = Cast<UField>(FV8Utils::GetUObject(Context, Value)))
     {
         *PropertyPtr = ContainerMeta.GetObjectProperty(Field);
+        MarkKnownObject(Field);
         return *PropertyPtr != nullptr;
     }
     else
@@ -3502,6 +3782,9 @@ void FJsEnvImpl::Start(const FString& ModuleNameOrScript, const TArray<TPair<FSt
     if (MaybeTGameTGJS.IsEmpty() || !MaybeTGameTGJS.ToLocalChecked()->IsObject())
     {
         Logger->Error("global.puerts not found!");
+#ifndef WITH_QUICKJS
+        StopTrackingCompiled(false);
+#endif
         return;
     }
 
@@ -3512,6 +3795,9 @@ void FJsEnvImpl::Start(const FString& ModuleNameOrScript, const TArray<TPair<FSt
     if (MaybeArgv.IsEmpty() || !MaybeArgv.ToLocalChecked()->IsObject())
     {
         Logger->Error("global.puerts.argv not found!");
+#ifndef WITH_QUICKJS
+        StopTrackingCompiled(false);
+#endif
         return;
     }
 
@@ -3522,6 +3808,9 @@ void FJsEnvImpl::Start(const FString& ModuleNameOrScript, const TArray<TPair<FSt
     if (MaybeArgvAdd.IsEmpty() || !MaybeArgvAdd.ToLocalChecked()->IsFunction())
     {
         Logger->Error("global.puerts.argv.add not found!");
+#ifndef WITH_QUICKJS
+        StopTrackingCompiled(false);
+#endif
         return;
     }
 
@@ -3535,6 +3824,7 @@ void FJsEnvImpl::Start(const FString& ModuleNameOrScript, const TArray<TPair<FSt
         (void) (ArgvAdd->Call(Context, Argv, 2, Args));
     }
 
+    const double StartModuleTime = FPlatformTime::Seconds();
     v8::TryCatch TryCatch(Isolate);
     v8::Local<v8::Value> Args[] = {FV8Utils::ToV8String(Isolate, ModuleNameOrScript)};
     __USE(Require.Get(Isolate)->Call(Context, v8::Undefined(Isolate), 1, Args));
@@ -3542,10 +3832,37 @@ void FJsEnvImpl::Start(const FString& ModuleNameOrScript, const TArray<TPair<FSt
     {
         Logger->Error(FV8Utils::TryCatchToString(Isolate, &TryCatch));
     }
+    StartModuleTimeMs = (FPlatformTime::Seconds() - StartModuleTime) * 1000.0;
+    UE_LOG(Puerts, Log, TEXT("start module [%s] executed in %.2f ms"), *ModuleNameOrScript, StartModuleTimeMs);
+
+#ifndef WITH_QUICKJS
+    StopTrackingCompiled(FJsCodeCache::IncludeUserModules());
+#endif
+
+    if (!FirstFrameHandle.IsValid())
+    {
+        FirstFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FJsEnvImpl::OnFirstFrameEnd);
+    }
 
     Started = true;
 }
 
+void FJsEnvImpl::OnFirstFrameEnd()
+{
+    FCoreDelegates::OnEndFrame.Remove(FirstFrameHandle);
+    FirstFrameTimeMs = (FPlatformTime::Seconds() - CreateTime) * 1000.0;
+    UE_LOG(Puerts, Log, TEXT("first frame after JsEnv creation finished in %.2f ms (construct %.2f ms, start module %.2f ms)"),
+        FirstFrameTimeMs, ConstructTimeMs, StartModuleTimeMs);
+}
+
+#ifndef WITH_QUICKJS
+void FJsEnvImpl::StopTrackingCompiled(bool bSave)
+{
+    CodeCache.FlushTracked(MainIsolate, bSave);
+    CodeCache.SetTrackCompiled(false);
+}
+#endif
+
 bool FJsEnvImpl::LoadFile(const FString& RequiringDir, const FString& ModuleName, FString& OutPath, FString& OutDebugPath,
     TArray<uint8>& Data, FString& ErrInfo)
 {
@@ -3748,13 +4065,26 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
         v8::Local<v8::Boolean>(), v8::Local<v8::Integer>(), v8::Local<v8::Value>(), v8::Local<v8::Boolean>(),
         v8::Local<v8::Boolean>(), v8::True(Isolate));
 #endif
+    FString CodeCacheKey;
+    TArray<uint8> CodeCacheData;
+    if (!CachedCode && CodeCache.Lookup(Isolate, Source, CodeCacheKey, CodeCacheData))
+    {
+        CachedCode = new v8::ScriptCompiler::CachedData(CodeCacheData.GetData(), CodeCacheData.Num());    // will delete by ~Source
+        Options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
+    }
     v8::ScriptCompiler::Source ScriptSource(Source, Origin, CachedCode);
 
     v8::Local<v8::Module> Module;
-    if (!v8::ScriptCompiler::CompileModule(Isolate, &ScriptSource, Options).ToLocal(&Module))
+    bool Compiled;
+    {
+        PUERTS_TRACE_SCOPE(PuertsModuleChannel, TEXT("JsCompile ") + FileName);
+        Compiled = v8::ScriptCompiler::CompileModule(Isolate, &ScriptSource, Options).ToLocal(&Module);
+    }
+    if (!Compiled)
     {
         return v8::MaybeLocal<v8::Module>();
     }
+    CodeCache.OnCompiled(CodeCacheKey, ScriptSource.GetCachedData(), Module->GetUnboundModuleScript());
 
     PathToModule.Add(FileName, v8::Global<v8::Module>(Isolate, Module));
     FModuleInfo* Info = new FModuleInfo;
@@ -3832,6 +4162,7 @@ v8::MaybeLocal<v8::Module> FJsEnvImpl::FetchESModuleTree(v8::Local<v8::Context>
 
 void FJsEnvImpl::ExecuteModule(const FString& ModuleName)
 {
+    PUERTS_TRACE_SCOPE(PuertsModuleChannel, TEXT("JsExecuteModule ") + ModuleName);
     FString OutPath;
     FString DebugPath;
     TArray<uint8> Data;
@@ -3896,12 +4227,35 @@ void FJsEnvImpl::ExecuteModule(const FString& ModuleName)
 #endif
         v8::TryCatch TryCatch(Isolate);
 
-        auto CompiledScript = v8::Script::Compile(Context, Source, &Origin);
+#ifndef WITH_QUICKJS
+        FString CodeCacheKey;
+        TArray<uint8> CodeCacheData;
+        v8::ScriptCompiler::CachedData* CachedCode = nullptr;
+        v8::ScriptCompiler::CompileOptions Options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
+        if (CodeCache.Lookup(Isolate, Source, CodeCacheKey, CodeCacheData))
+        {
+            CachedCode = new v8::ScriptCompiler::CachedData(CodeCacheData.GetData(), CodeCacheData.Num());    // will delete by ~Source
+            Options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
+        }
+        v8::ScriptCompiler::Source ScriptSource(Source, Origin, CachedCode);
+#endif
+        v8::MaybeLocal<v8::Script> CompiledScript;
+        {
+            PUERTS_TRACE_SCOPE(PuertsModuleChannel, TEXT("JsCompile ") + ModuleName);
+#ifndef WITH_QUICKJS
+            CompiledScript = v8::ScriptCompiler::Compile(Context, &ScriptSource, Options);
+#else
+            CompiledScript = v8::Script::Compile(Context, Source, &Origin);
+#endif
+        }
         if (CompiledScript.IsEmpty())
         {
             Logger->Error(FV8Utils::TryCatchToString(Isolate, &TryCatch));
             return;
         }
+#ifndef WITH_QUICKJS
+        CodeCache.OnCompiled(CodeCacheKey, ScriptSource.GetCachedData(), CompiledScript.ToLocalChecked()->GetUnboundScript());
+#endif
         (void) (CompiledScript.ToLocalChecked()->Run(Context));
         if (TryCatch.HasCaught())
         {
@@ -3914,6 +4268,7 @@ void FJsEnvImpl::ExecuteModule(const FString& ModuleName)
 void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
+    PUERTS_TRACE_SCOPE(PuertsModuleChannel, TEXT("JsEvalScript ") + FV8Utils::ToFString(Isolate, Info[1]));
     v8::Isolate::Scope IsolateScope(Isolate);
     v8::HandleScope HandleScope(Isolate);
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -3977,10 +4332,12 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
 #endif
     v8::Local<v8::String> Source = Info[0]->ToString(Context).ToLocalChecked();
 
-#if defined(WITH_V8_BYTECODE)
+#ifndef WITH_QUICKJS
     v8::ScriptCompiler::CachedData* CachedCode = nullptr;
-    uint8_t* Cache = nullptr;
     v8::ScriptCompiler::CompileOptions Options = v8::ScriptCompiler::CompileOptions::kNoCompileOptions;
+#endif
+#if defined(WITH_V8_BYTECODE)
+    uint8_t* Cache = nullptr;
     if (Info.Length() > 4)
     {
         if (Info[4]->IsArrayBuffer())
@@ -4000,10 +4357,26 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
             }
         }
     }
+#endif
+
+#ifndef WITH_QUICKJS
+    // 显式传入的字节码优先，否则使用磁盘上的编译缓存
+    FString CodeCacheKey;
+    TArray<uint8> CodeCacheData;
+    if (!CachedCode && CodeCache.Lookup(Isolate, Source, CodeCacheKey, CodeCacheData))
+    {
+        CachedCode = new v8::ScriptCompiler::CachedData(CodeCacheData.GetData(), CodeCacheData.Num());    // will delete by ~Source
+        Options = v8::ScriptCompiler::CompileOptions::kConsumeCodeCache;
+    }
 
     v8::ScriptCompiler::Source ScriptSource(Source, Origin, CachedCode);
-    auto Script = v8::ScriptCompiler::Compile(Context, &ScriptSource, Options);
-    if (CachedCode)
+    v8::MaybeLocal<v8::Script> Script;
+    {
+        PUERTS_TRACE_SCOPE(PuertsModuleChannel, TEXT("JsCompile ") + ScriptUrl);
+        Script = v8::ScriptCompiler::Compile(Context, &ScriptSource, Options);
+    }
+#if defined(WITH_V8_BYTECODE)
+    if (Cache)
     {
         delete Cache;
         if (CachedCode->rejected)
@@ -4012,6 +4385,7 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
             return;
         }
     }
+#endif
 #else
     auto Script = v8::Script::Compile(Context, Source, &Origin);
 #endif
@@ -4020,6 +4394,9 @@ void FJsEnvImpl::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
     {
         return;
     }
+#ifndef WITH_QUICKJS
+    CodeCache.OnCompiled(CodeCacheKey, ScriptSource.GetCachedData(), Script.ToLocalChecked()->GetUnboundScript());
+#endif
     auto Result = Script.ToLocalChecked()->Run(Context);
     if (Result.IsEmpty())
     {
@@ -4116,14 +4493,165 @@ void FJsEnvImpl::LoadModule(const v8::FunctionCallbackInfo<v8::Value>& Info)
     }
 }
 
+#ifndef WITH_QUICKJS
+int32 FJsEnvImpl::CreateWorker(const FString& ModuleName)
+{
+#if defined(USING_SINGLE_THREAD_PLATFORM)
+    Logger->Error(TEXT("worker is not supported with single threaded platform"));
+    return 0;
+#else
+    while (!(++WorkerID))    // WorkerID > 0
+    {
+    }
+    Workers.Add(WorkerID, MakeUnique<FJsWorkerEnv>(WorkerID, ModuleLoader, Logger, ModuleName));
+    return WorkerID;
+#endif
+}
+
+void FJsEnvImpl::CreateWorker(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+
+    CHECK_V8_ARGS(EArgString);
+
+    int32 Id = CreateWorker(FV8Utils::ToFString(Isolate, Info[0]));
+    if (Id == 0)
+    {
+        FV8Utils::ThrowException(Isolate, "create worker fail");
+        return;
+    }
+    Info.GetReturnValue().Set(Id);
+}
+
+void FJsEnvImpl::PostMessageToWorker(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS(EArgInt32);
+
+    int32 Id = Info[0]->Int32Value(Context).ToChecked();
+    TUniquePtr<FJsWorkerEnv>* Worker = Workers.Find(Id);
+    if (!Worker)
+    {
+        FV8Utils::ThrowException(Isolate, FString::Printf(TEXT("worker %d not found"), Id));
+        return;
+    }
+
+    FJsWorkerMessage Message;
+    if (FJsWorkerMessage::Serialize(Isolate, Context, Info[1], Info[2], Message))
+    {
+        (*Worker)->PostToWorker(MoveTemp(Message));
+        ++WorkerMessagesSent;
+        INC_DWORD_STAT(STAT_Puerts_WorkerMessagesSent);
+    }
+}
+
+void FJsEnvImpl::TerminateWorker(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS(EArgInt32);
+
+    // 析构时等待线程退出
+    Workers.Remove(Info[0]->Int32Value(Context).ToChecked());
+}
+
+void FJsEnvImpl::SetWorkerMessageHandler(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+
+    CHECK_V8_ARGS(EArgFunction);
+
+    WorkerMessageHandler.Reset(Isolate, Info[0].As<v8::Function>());
+}
+
+bool FJsEnvImpl::TickWorkers(float DeltaTime)
+{
+    if (Workers.Num() == 0)
+    {
+        return true;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_Puerts_TickWorkers);
+#ifdef SINGLE_THREAD_VERIFY
+    ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
+#endif
+    v8::Isolate* Isolate = MainIsolate;
+#ifdef THREAD_SAFE
+    v8::Locker Locker(Isolate);
+#endif
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
+    v8::Context::Scope ContextScope(Context);
+
+    // handler里可能创建或结束worker，先取出id
+    TArray<int32> WorkerIds;
+    Workers.GetKeys(WorkerIds);
+    for (int32 Id : WorkerIds)
+    {
+        FJsWorkerMessage Message;
+        while (true)
+        {
+            TUniquePtr<FJsWorkerEnv>* Worker = Workers.Find(Id);
+            if (!Worker || !(*Worker)->Receive(Message))
+            {
+                break;
+            }
+
+            // 异常报告没有经过序列化，不计入
+            if (Message.Error.IsEmpty())
+            {
+                const double LatencyMs = (FPlatformTime::Seconds() - Message.SendTime) * 1000.0;
+                ++WorkerMessagesReceived;
+                WorkerMessageLatencySumMs += LatencyMs;
+                WorkerMessageLatencyMaxMs = FMath::Max(WorkerMessageLatencyMaxMs, LatencyMs);
+                INC_DWORD_STAT(STAT_Puerts_WorkerMessagesReceived);
+            }
+
+            v8::TryCatch TryCatch(Isolate);
+            v8::Local<v8::Value> Args[] = {v8::Integer::New(Isolate, Id), v8::Undefined(Isolate), v8::Undefined(Isolate)};
+            if (!Message.Error.IsEmpty())
+            {
+                Args[2] = FV8Utils::ToV8String(Isolate, Message.Error);
+            }
+            else if (!Message.Deserialize(Isolate, Context).ToLocal(&Args[1]))
+            {
+                Logger->Error(
+                    FString::Printf(TEXT("Exception in Worker Message: %s"), *FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+                continue;
+            }
+
+            if (WorkerMessageHandler.IsEmpty())
+            {
+                if (!Message.Error.IsEmpty())
+                {
+                    Logger->Error(FString::Printf(TEXT("Exception in Worker %d: %s"), Id, *Message.Error));
+                }
+                continue;
+            }
+            (void) (WorkerMessageHandler.Get(Isolate)->Call(Context, Context->Global(), 3, Args));
+            if (TryCatch.HasCaught())
+            {
+                Logger->Error(
+                    FString::Printf(TEXT("Exception in Worker Message Handler: %s"), *FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+            }
+        }
+    }
+    return true;
+}
+#endif
+
 void FJsEnvImpl::SetTimeout(const v8::FunctionCallbackInfo<v8::Value>& Info)
 {
     CHECK_V8_ARGS(EArgFunction, EArgNumber);
 
-    SetFTickerDelegate(Info, false);
+    AddTimer(Info, false);
 }
 
-void FJsEnvImpl::SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue)
+void FJsEnvImpl::AddTimer(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue)
 {
     v8::Isolate* Isolate = Info.GetIsolate();
     v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
@@ -4131,23 +4659,38 @@ void FJsEnvImpl::SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& I
     while (!(++TimerID))    // TimerID > 0
     {
     }
-    uint32_t DelegateHandleId = TimerID;
-    FTimerInfo& TimerInfo = TimerInfos.Emplace(DelegateHandleId, FTimerInfo());
+    uint32_t TimerHandleId = TimerID;
+    FTimerInfo& TimerInfo = TimerInfos.Emplace(TimerHandleId, FTimerInfo());
     TimerInfo.Callback.Reset(Isolate, v8::Local<v8::Function>::Cast(Info[0]));
 
-    float Millisecond = Info[1]->NumberValue(Context).ToChecked();
-    float Delay = Millisecond / 1000.f;
+    double Millisecond = Info[1]->NumberValue(Context).ToChecked();
+    // NaN和负数按0处理，与浏览器一致
+    TimerInfo.IntervalMs = Millisecond > 0 ? static_cast<uint64>(FMath::CeilToDouble(FMath::Min(Millisecond, 1e12))) : 0;
+    TimerInfo.Continue = Continue;
+    INC_DWORD_STAT(STAT_Puerts_LiveTimers);
 
-    TimerInfo.TickerHandle =
-        FUETicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, DelegateHandleId, Continue](float)
-                                                 { return this->TimerCallback(DelegateHandleId, Continue); }),
-            Delay);
+    // 过期时间早于时间轮当前刻度的会被推到下一次Tick，所以0延时的timer在下一帧执行，与原来的FTSTicker行为一致
+    TimerWheel.Add(TimerHandleId, static_cast<uint64>(TimerElapsedMs) + TimerInfo.IntervalMs);
 
-    Info.GetReturnValue().Set(DelegateHandleId);
+    Info.GetReturnValue().Set(TimerHandleId);
 }
 
-bool FJsEnvImpl::TimerCallback(int DelegateHandleId, bool Continue)
+bool FJsEnvImpl::TickTimers(float DeltaTime)
 {
+    TimerElapsedMs += DeltaTime * 1000.0;
+    LastTickTimerCallbacks = 0;
+
+    // 没有timer时也要推进，时间轮为空时Advance直接跳到当前刻度，否则下一个timer加入后要逐刻度追赶空闲期间的时间
+    const uint64 NowTick = static_cast<uint64>(TimerElapsedMs);
+    ExpiredTimers.Reset();
+    TimerWheel.Advance(NowTick, ExpiredTimers);
+    if (ExpiredTimers.Num() == 0)
+    {
+        return true;
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_Puerts_TickTimers);
+
     v8::Isolate* Isolate = MainIsolate;
 #ifdef SINGLE_THREAD_VERIFY
     ensureMsgf(BoundThreadId == FPlatformTLS::GetCurrentThreadId(), TEXT("Access by illegal thread!"));
@@ -4161,44 +4704,55 @@ bool FJsEnvImpl::TimerCallback(int DelegateHandleId, bool Continue)
     v8::Local<v8::Context> Context = DefaultContext.Get(Isolate);
     v8::Context::Scope ContextScope(Context);
 
-    FTimerInfo* PTimeInfo = TimerInfos.Find(DelegateHandleId);
-    if (!PTimeInfo)
+    for (uint32 TimerHandleId : ExpiredTimers)
     {
-        Logger->Warn(FString::Printf(TEXT("Try to callback a invalid timer: %d"), DelegateHandleId));
-        return false;
-    }
-
-    auto OriginHandle = PTimeInfo->TickerHandle;
-    v8::Local<v8::Function> Function = TimerInfos[DelegateHandleId].Callback.Get(Isolate);
-
-    v8::TryCatch TryCatch(Isolate);
-    (void) (Function->Call(Context, Context->Global(), 0, nullptr));
+        FTimerInfo* PTimerInfo = TimerInfos.Find(TimerHandleId);
+        if (!PTimerInfo)    // cleared before expired
+        {
+            continue;
+        }
 
-    if (TryCatch.HasCaught())
-    {
-        FString Message =
-            FString::Printf(TEXT("Exception in Timer Callback: %s"), *(FV8Utils::TryCatchToString(Isolate, &TryCatch)));
-        Logger->Error(Message);
-    }
+        v8::Local<v8::Function> Function = PTimerInfo->Callback.Get(Isolate);
+        {
+            v8::TryCatch TryCatch(Isolate);
+            (void) (Function->Call(Context, Context->Global(), 0, nullptr));
 
-    auto ClearInCallback = !TimerInfos.Contains(DelegateHandleId) || (OriginHandle != TimerInfos[DelegateHandleId].TickerHandle);
+            if (TryCatch.HasCaught())
+            {
+                FString Message =
+                    FString::Printf(TEXT("Exception in Timer Callback: %s"), *(FV8Utils::TryCatchToString(Isolate, &TryCatch)));
+                Logger->Error(Message);
+            }
+        }
+        ++LastTickTimerCallbacks;
 
-    if (!Continue && !ClearInCallback)
-    {
-        RemoveFTickerDelegateHandle(DelegateHandleId);
+        // callback may add or clear timers, cause a rehash
+        PTimerInfo = TimerInfos.Find(TimerHandleId);
+        if (!PTimerInfo)    // cleared in callback
+        {
+            continue;
+        }
+        if (PTimerInfo->Continue)
+        {
+            TimerWheel.Add(TimerHandleId, NowTick + PTimerInfo->IntervalMs);
+        }
+        else
+        {
+            RemoveTimer(TimerHandleId);
+        }
     }
+    INC_DWORD_STAT_BY(STAT_Puerts_TimerCallbacks, LastTickTimerCallbacks);
 
-    return Continue && !ClearInCallback;
+    return true;
 }
 
-void FJsEnvImpl::RemoveFTickerDelegateHandle(int DelegateHandleId)
+void FJsEnvImpl::RemoveTimer(uint32 TimerId)
 {
-    if (!TimerInfos.Contains(DelegateHandleId))
+    // 时间轮中的条目不用删除，到期时发现已不在TimerInfos里会被跳过
+    if (TimerInfos.Remove(TimerId) > 0)
     {
-        return;
+        DEC_DWORD_STAT(STAT_Puerts_LiveTimers);
     }
-    FUETicker::GetCoreTicker().RemoveTicker(TimerInfos[DelegateHandleId].TickerHandle);
-    TimerInfos.Remove(DelegateHandleId);
 }
 
 void FJsEnvImpl::ClearInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
@@ -4220,7 +4774,7 @@ void FJsEnvImpl::ClearInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
     {
         CHECK_V8_ARGS(EArgInt32);
         int HandleId = Info[0]->Int32Value(Context).ToChecked();
-        RemoveFTickerDelegateHandle(HandleId);
+        RemoveTimer(HandleId);
     }
 }
 
@@ -4234,7 +4788,7 @@ void FJsEnvImpl::SetInterval(const v8::FunctionCallbackInfo<v8::Value>& Info)
 
     CHECK_V8_ARGS(EArgFunction, EArgNumber);
 
-    SetFTickerDelegate(Info, true);
+    AddTimer(Info, true);
 }
 
 #if !defined(ENGINE_INDEPENDENT_JSENV)
@@ -4319,6 +4873,7 @@ void FJsEnvImpl::MakeUClass(const v8::FunctionCallbackInfo<v8::Value>& Info)
     if (!GeneratedClasses.Contains(Class))
     {
         GeneratedClasses.Add(Class);
+        MarkKnownObject(Class);
     }
     SysObjectRetainer.Retain(Class);
 
@@ -4415,6 +4970,7 @@ void FJsEnvImpl::Mixin(const v8::FunctionCallbackInfo<v8::Value>& Info)
             auto MixinedFunc = UJSGeneratedClass::Mixin(Isolate, New, Function, MixinInvoker, TakeJsObjectRef, !NoWarning);
             MixinFunctionMap.Emplace(
                 MixinedFunc, v8::UniquePersistent<v8::Function>(Isolate, v8::Local<v8::Function>::Cast(JsFunc)));
+            MarkKnownObject(MixinedFunc);
             ReplaceMethodNames.Add(MethodName);
         }
     }
@@ -4594,6 +5150,34 @@ void FJsEnvImpl::DumpStatisticsLog(const v8::FunctionCallbackInfo<v8::Value>& In
         Statistics.external_memory(), Statistics.peak_malloced_memory(), Statistics.number_of_native_contexts(),
         Statistics.number_of_detached_contexts(), Statistics.does_zap_garbage());
 
+    auto AppendCacheStatistics = [&StatisticsLog](const TCHAR* Name, const FObjectCacheTableStats& Stats)
+    {
+        StatisticsLog += FString::Printf(TEXT("%s: num=%d capacity=%d load_factor=%.3f avg_probe_length=%.3f max_probe_length=%d\n"),
+            Name, Stats.Num, Stats.Capacity, Stats.LoadFactor, Stats.AverageProbeLength, Stats.MaxProbeLength);
+    };
+    AppendCacheStatistics(TEXT("object_cache"), ObjectMap.GetStats());
+    AppendCacheStatistics(TEXT("struct_cache"), StructCache.GetStats());
+    StatisticsLog += FString::Printf(TEXT("startup: construct=%.2fms bootstrap=%.2fms start_module=%.2fms first_frame=%.2fms\n"),
+        ConstructTimeMs, BootstrapTimeMs, StartModuleTimeMs, FirstFrameTimeMs);
+    StatisticsLog += FString::Printf(TEXT("deleted_objects: notified=%lld processed=%lld known=%d\n"), DeletedObjectCount,
+        ProcessedDeletedObjectCount, KnownObjects.NumSet());
+    StatisticsLog += FString::Printf(TEXT("delegates: live=%d pending=%d reclaimed=%lld\n"), (int32) DelegateMap.size(),
+        PendingDelegateRemovals.Num(), ReclaimedDelegateCount);
+#ifndef WITH_QUICKJS
+    const FJsCodeCache::FStatistics& CodeCacheStatistics = CodeCache.GetStatistics();
+    StatisticsLog += FString::Printf(TEXT("code_cache: hits=%d misses=%d rejects=%d read=%lld written=%lld warm_flushed=%d\n"),
+        CodeCacheStatistics.Hits, CodeCacheStatistics.Misses, CodeCacheStatistics.Rejects, CodeCacheStatistics.BytesRead,
+        CodeCacheStatistics.BytesWritten, CodeCacheStatistics.WarmFlushed);
+    StatisticsLog += FString::Printf(TEXT("gc: count=%d total_pause=%.2fms max_pause=%.2fms idle_notifications=%d idle_time=%.2fms\n"),
+        GCCount, GCTotalPauseMs, GCMaxPauseMs, IdleNotificationCount, IdleNotificationTotalMs);
+    StatisticsLog += FString::Printf(TEXT("workers: %d sent=%lld received=%lld avg_latency=%.3fms max_latency=%.3fms\n"),
+        Workers.Num(), WorkerMessagesSent, WorkerMessagesReceived,
+        WorkerMessagesReceived > 0 ? WorkerMessageLatencySumMs / WorkerMessagesReceived : 0.0, WorkerMessageLatencyMaxMs);
+#endif
+    StatisticsLog += FString::Printf(TEXT("live_timers: %d\ntimer_wheel_entries: %d\ntimer_callbacks_last_tick: %d\n"),
+        TimerInfos.Num(), TimerWheel.NumEntries(), LastTickTimerCallbacks);
+    StatisticsLog += TEXT("------------------------\n");
+
     Logger->Info(StatisticsLog);
 #endif    // !WITH_QUICKJS
 }
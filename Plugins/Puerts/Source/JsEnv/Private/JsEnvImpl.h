@@ -21,7 +21,12 @@
 #endif
 #include "UECompatible.h"
 #include "ContainerMeta.h"
+#include "ObjectIndexBitSet.h"
 #include "ObjectCacheNode.h"
+#include "ObjectCacheTable.h"
+#include "JsTimerWheel.h"
+#include "JsCodeCache.h"
+#include "JsWorkerEnv.h"
 #include <unordered_map>
 
 #if ENGINE_MINOR_VERSION >= 25 || ENGINE_MAJOR_VERSION > 4
@@ -38,6 +43,7 @@ PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
 #include "NamespaceDef.h"
 
 #include "V8InspectorImpl.h"
+#include "JsProfiler.h"
 
 #if defined(WITH_NODEJS)
 PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
@@ -90,8 +96,16 @@ public:
 
     virtual bool IdleNotificationDeadline(double DeadlineInSeconds) override;
 
+    virtual bool IdleNotification(double IdleTimeInSeconds) override;
+
     virtual void LowMemoryNotification() override;
 
+    virtual bool StartCpuProfile(int32 SamplingIntervalUs) override;
+
+    virtual FString StopCpuProfile(const FString& FilePath) override;
+
+    virtual FString TakeHeapSnapshot(const FString& FilePath) override;
+
     virtual void RequestMinorGarbageCollectionForTesting() override;
 
     virtual void RequestFullGarbageCollectionForTesting() override;
@@ -230,6 +244,10 @@ public:
 
     bool CheckDelegateProxies(float Tick);
 
+    void TrackDelegate(void* DelegatePtr, const DelegateObjectInfo& DelegateInfo);
+
+    void RemoveDelegate(v8::Isolate* Isolate, v8::Local<v8::Context>& Context, std::map<void*, DelegateObjectInfo>::iterator Iter);
+
     virtual v8::Local<v8::Value> CreateArray(
         v8::Isolate* Isolate, v8::Local<v8::Context>& Context, FPropertyTranslator* Property, void* ArrayPtr) override;
 
@@ -270,6 +288,11 @@ public:
 
     void TryReleaseType(UStruct* Struct);
 
+#ifndef WITH_QUICKJS
+    // 创建在独立线程运行的worker isolate，返回worker id，失败返回0；worker发来的消息在游戏线程交给js设置的handler
+    int32 CreateWorker(const FString& ModuleName);
+#endif
+
 private:
     bool LoadFile(const FString& RequiringDir, const FString& ModuleName, FString& OutPath, FString& OutDebugPath,
         TArray<uint8>& Data, FString& ErrInfo);
@@ -314,11 +337,22 @@ private:
 
     void SetTimeout(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
-    void SetFTickerDelegate(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue);
+    void AddTimer(const v8::FunctionCallbackInfo<v8::Value>& Info, bool Continue);
 
-    bool TimerCallback(int DelegateHandleId, bool Continue);
+    bool TickTimers(float DeltaTime);
 
-    void RemoveFTickerDelegateHandle(int HandleId);
+    void RemoveTimer(uint32 TimerId);
+
+#ifndef WITH_QUICKJS
+    static void OnGCPrologue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data);
+
+    static void OnGCEpilogue(v8::Isolate* Isolate, v8::GCType Type, v8::GCCallbackFlags Flags, void* Data);
+
+    void UpdateHeapStatistics();
+
+    // 结束启动阶段的编译跟踪，bSave为false时丢弃已跟踪的脚本；析构和Start提前返回时也要调用，否则TrackedScripts一直持有脚本
+    void StopTrackingCompiled(bool bSave);
+#endif
 
     void SetInterval(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
@@ -341,6 +375,18 @@ private:
 
     void DumpStatisticsLog(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
+#ifndef WITH_QUICKJS
+    void CreateWorker(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void PostMessageToWorker(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void TerminateWorker(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    void SetWorkerMessageHandler(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    bool TickWorkers(float DeltaTime);
+#endif
+
     void SetInspectorCallback(const v8::FunctionCallbackInfo<v8::Value>& Info);
 
     void DispatchProtocolMessage(const v8::FunctionCallbackInfo<v8::Value>& Info);
@@ -571,9 +617,9 @@ private:
 
     TMap<FString, std::shared_ptr<FStructWrapper>> TypeReflectionMap;
 
-    TMap<UObject*, v8::UniquePersistent<v8::Value>> ObjectMap;
+    TObjectCacheTable<UObject*, v8::UniquePersistent<v8::Value>> ObjectMap;
 
-    TMap<void*, FObjectCacheNode> StructCache;
+    TObjectCacheTable<FStructCacheKey, FStructCacheValue> StructCache;
 
     struct ContainerCacheItem
     {
@@ -620,8 +666,13 @@ private:
         bool PassByPointer;
         TWeakObjectPtr<UDynamicDelegateProxy> Proxy;
         v8::UniquePersistent<v8::Array> JsCallbacks;
+        const UObjectBase* OwnerKey;    // Owner失效后仍可用来从DelegatesByOwner里摘除
+        uint32 Generation;              // DelegatePtr地址可能被复用，排队清理时用它区分新旧记录
     };
 
+    // DelegateMap里的一条记录，(DelegatePtr, Generation)
+    typedef TPair<void*, uint32> FDelegateRef;
+
     struct TsFunctionInfo
     {
         v8::UniquePersistent<v8::Function> JsFunction;
@@ -703,13 +754,35 @@ private:
     struct FTimerInfo
     {
         v8::Global<v8::Function> Callback;
-        FUETickDelegateHandle TickerHandle;
+        uint64 IntervalMs;
+        bool Continue;
     };
     uint32_t TimerID = 0;
     TMap<uint32_t, FTimerInfo> TimerInfos;
 
+    // 所有timer共用一个ticker驱动，到期的回调每帧批量执行
+    FJsTimerWheel TimerWheel;
+
+    FUETickDelegateHandle TimerTickerHandle;
+
+    double TimerElapsedMs = 0;
+
+    TArray<uint32> ExpiredTimers;
+
+    int32 LastTickTimerCallbacks = 0;
+
     FUETickDelegateHandle DelegateProxiesCheckerHandler;
 
+    // owner -> 挂在它上面的delegate，owner删除时由NotifyUObjectDeleted整体转入PendingDelegateRemovals
+    TMap<const UObjectBase*, TArray<FDelegateRef>> DelegatesByOwner;
+
+    // 待清理的delegate，CheckDelegateProxies每帧在时间预算内处理一部分，Generation对不上的说明已经被替换，直接跳过
+    TArray<FDelegateRef> PendingDelegateRemovals;
+
+    uint32 DelegateGeneration = 0;
+
+    int64 ReclaimedDelegateCount = 0;
+
     V8Inspector* Inspector;
 
     V8InspectorChannel* InspectorChannel;
@@ -718,6 +791,19 @@ private:
 
     FContainerMeta ContainerMeta;
 
+    // 出现在下面任何一个以UObject为key的表里的对象（ObjectMap、TypeToTemplateInfoMap、BindInfoMap、GeneratedClasses、
+    // TsFunctionMap、MixinFunctionMap、ContainerMeta、AutoReleaseCallbacksMap）都要在这里标记，NotifyUObjectDeleted只处理标记过的
+    FObjectIndexBitSet KnownObjects;
+
+    FORCEINLINE void MarkKnownObject(const UObjectBase* Object)
+    {
+        KnownObjects.Set(GUObjectArray.ObjectToIndex(Object));
+    }
+
+    int64 DeletedObjectCount = 0;
+
+    int64 ProcessedDeletedObjectCount = 0;
+
     v8::Global<v8::Map> ManualReleaseCallbackMap;
 
     std::vector<TWeakObjectPtr<UDynamicDelegateProxy>> ManualReleaseCallbackList;
@@ -756,6 +842,66 @@ private:
                 .Check();
         }
     };
+#ifndef WITH_QUICKJS
+    FJsCodeCache CodeCache;
+
+    TMap<int32, TUniquePtr<FJsWorkerEnv>> Workers;
+
+    int32 WorkerID = 0;
+
+    // handler(workerId, data, error)
+    v8::Global<v8::Function> WorkerMessageHandler;
+
+    FUETickDelegateHandle WorkerTickerHandle;
+
+    int64 WorkerMessagesSent = 0;
+
+    int64 WorkerMessagesReceived = 0;
+
+    // worker调用postMessage到游戏线程分发之间的耗时，包含等待下一帧tick的时间
+    double WorkerMessageLatencySumMs = 0;
+
+    double WorkerMessageLatencyMaxMs = 0;
+#endif
+
+    double ConstructTimeMs = 0;
+
+    double BootstrapTimeMs = 0;
+
+    double StartModuleTimeMs = 0;
+
+    // 从创建JsEnv到启动模块执行后第一帧结束的耗时
+    double FirstFrameTimeMs = 0;
+
+    double CreateTime = 0;
+
+    FDelegateHandle FirstFrameHandle;
+
+    void OnFirstFrameEnd();
+
+#ifndef WITH_QUICKJS
+    std::unique_ptr<FJsProfiler> Profiler;
+
+    double GCStartTime = 0;
+
+    bool TracingGC = false;
+
+    int32 GCCount = 0;
+
+    double GCTotalPauseMs = 0;
+
+    double GCMaxPauseMs = 0;
+
+    int32 IdleNotificationCount = 0;
+
+    double IdleNotificationTotalMs = 0;
+
+    // 已经计入STAT_Puerts_HeapUsed/HeapTotal的值，多个虚拟机时各自增减自己的部分
+    int64 ReportedHeapUsed = 0;
+
+    int64 ReportedHeapTotal = 0;
+#endif
+
 #if defined(WITH_V8_BYTECODE)
     uint32_t Expect_FlagHash = 0;
 #if V8_MAJOR_VERSION >= 11
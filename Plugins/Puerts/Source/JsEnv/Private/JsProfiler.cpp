@@ -0,0 +1,245 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsProfiler.h"
+
+#ifndef WITH_QUICKJS
+
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace PUERTS_NAMESPACE
+{
+static const char* CpuProfileTitle = "puerts";
+
+// 把json字符串字面量追加到Out，按JSON规范转义
+static void AppendJsonString(FString& Out, const char* Str)
+{
+    Out += TEXT('"');
+    for (const TCHAR Ch : FString(UTF8_TO_TCHAR(Str)))
+    {
+        switch (Ch)
+        {
+            case TEXT('"'):
+                Out += TEXT("\\\"");
+                break;
+            case TEXT('\\'):
+                Out += TEXT("\\\\");
+                break;
+            case TEXT('\n'):
+                Out += TEXT("\\n");
+                break;
+            case TEXT('\r'):
+                Out += TEXT("\\r");
+                break;
+            case TEXT('\t'):
+                Out += TEXT("\\t");
+                break;
+            default:
+                if (Ch < 0x20)
+                {
+                    Out += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Ch));
+                }
+                else
+                {
+                    Out += Ch;
+                }
+        }
+    }
+    Out += TEXT('"');
+}
+
+// DevTools的Profile.ProfileNode格式，行列号从0开始
+static void AppendProfileNodes(FString& Out, const v8::CpuProfileNode* Node, bool& First)
+{
+    if (!First)
+    {
+        Out += TEXT(',');
+    }
+    First = false;
+
+    Out += FString::Printf(TEXT("{\"id\":%u,\"callFrame\":{\"functionName\":"), Node->GetNodeId());
+    AppendJsonString(Out, Node->GetFunctionNameStr());
+    Out += FString::Printf(TEXT(",\"scriptId\":\"%d\",\"url\":"), Node->GetScriptId());
+    AppendJsonString(Out, Node->GetScriptResourceNameStr());
+    Out += FString::Printf(TEXT(",\"lineNumber\":%d,\"columnNumber\":%d},\"hitCount\":%u"), Node->GetLineNumber() - 1,
+        Node->GetColumnNumber() - 1, Node->GetHitCount());
+
+    const int ChildrenCount = Node->GetChildrenCount();
+    if (ChildrenCount > 0)
+    {
+        Out += TEXT(",\"children\":[");
+        for (int i = 0; i < ChildrenCount; ++i)
+        {
+            Out += FString::Printf(i == 0 ? TEXT("%u") : TEXT(",%u"), Node->GetChild(i)->GetNodeId());
+        }
+        Out += TEXT(']');
+    }
+    Out += TEXT('}');
+
+    for (int i = 0; i < ChildrenCount; ++i)
+    {
+        AppendProfileNodes(Out, Node->GetChild(i), First);
+    }
+}
+
+static FString SerializeCpuProfile(const v8::CpuProfile* Profile)
+{
+    FString Out = TEXT("{\"nodes\":[");
+    bool First = true;
+    AppendProfileNodes(Out, Profile->GetTopDownRoot(), First);
+
+    Out += FString::Printf(TEXT("],\"startTime\":%lld,\"endTime\":%lld,\"samples\":["), static_cast<int64>(Profile->GetStartTime()),
+        static_cast<int64>(Profile->GetEndTime()));
+    const int SamplesCount = Profile->GetSamplesCount();
+    for (int i = 0; i < SamplesCount; ++i)
+    {
+        Out += FString::Printf(i == 0 ? TEXT("%u") : TEXT(",%u"), Profile->GetSample(i)->GetNodeId());
+    }
+
+    Out += TEXT("],\"timeDeltas\":[");
+    int64 LastTimestamp = static_cast<int64>(Profile->GetStartTime());
+    for (int i = 0; i < SamplesCount; ++i)
+    {
+        const int64 Timestamp = static_cast<int64>(Profile->GetSampleTimestamp(i));
+        Out += FString::Printf(i == 0 ? TEXT("%lld") : TEXT(",%lld"), Timestamp - LastTimestamp);
+        LastTimestamp = Timestamp;
+    }
+    Out += TEXT("]}");
+    return Out;
+}
+
+// 堆快照可能有几百MB，直接流式写文件
+class FHeapSnapshotFileStream : public v8::OutputStream
+{
+public:
+    explicit FHeapSnapshotFileStream(FArchive* InWriter) : Writer(InWriter)
+    {
+    }
+
+    virtual void EndOfStream() override
+    {
+    }
+
+    virtual WriteResult WriteAsciiChunk(char* Data, int Size) override
+    {
+        Writer->Serialize(Data, Size);
+        return Writer->IsError() ? kAbort : kContinue;
+    }
+
+private:
+    FArchive* Writer;
+};
+
+FJsProfiler::FJsProfiler(v8::Isolate* InIsolate) : Isolate(InIsolate)
+{
+}
+
+FJsProfiler::~FJsProfiler()
+{
+    if (CpuProfiler)
+    {
+        // 未Stop的profile随Dispose一起释放
+        CpuProfiler->Dispose();
+        CpuProfiler = nullptr;
+    }
+}
+
+bool FJsProfiler::StartCpuProfile(int32 SamplingIntervalUs)
+{
+    if (CpuProfiling)
+    {
+        return false;
+    }
+
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    if (!CpuProfiler)
+    {
+        CpuProfiler = v8::CpuProfiler::New(Isolate);
+    }
+    if (SamplingIntervalUs > 0)
+    {
+        CpuProfiler->SetSamplingInterval(SamplingIntervalUs);
+    }
+    const v8::CpuProfilingStatus Status =
+        CpuProfiler->StartProfiling(v8::String::NewFromUtf8(Isolate, CpuProfileTitle).ToLocalChecked(), true);
+    CpuProfiling = Status == v8::CpuProfilingStatus::kStarted;
+    return CpuProfiling;
+}
+
+FString FJsProfiler::StopCpuProfile(const FString& FilePath)
+{
+    if (!CpuProfiling)
+    {
+        return FString();
+    }
+    CpuProfiling = false;
+
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::CpuProfile* Profile = CpuProfiler->StopProfiling(v8::String::NewFromUtf8(Isolate, CpuProfileTitle).ToLocalChecked());
+    if (!Profile)
+    {
+        return FString();
+    }
+    const FString Json = SerializeCpuProfile(Profile);
+    Profile->Delete();
+
+    const FString OutputPath = ResolveOutputPath(FilePath, TEXT(".cpuprofile"));
+    if (!FFileHelper::SaveStringToFile(Json, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        return FString();
+    }
+    return OutputPath;
+}
+
+FString FJsProfiler::TakeHeapSnapshot(const FString& FilePath)
+{
+    const FString OutputPath = ResolveOutputPath(FilePath, TEXT(".heapsnapshot"));
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*OutputPath));
+    if (!Writer)
+    {
+        return FString();
+    }
+
+    v8::Isolate::Scope IsolateScope(Isolate);
+    v8::HandleScope HandleScope(Isolate);
+    v8::HeapProfiler* HeapProfiler = Isolate->GetHeapProfiler();
+    const v8::HeapSnapshot* Snapshot = HeapProfiler->TakeHeapSnapshot();
+    if (!Snapshot)
+    {
+        return FString();
+    }
+    FHeapSnapshotFileStream Stream(Writer.Get());
+    Snapshot->Serialize(&Stream, v8::HeapSnapshot::kJSON);
+    const_cast<v8::HeapSnapshot*>(Snapshot)->Delete();
+
+    const bool Succeeded = Writer->Close() && !Writer->IsError();
+    return Succeeded ? OutputPath : FString();
+}
+
+FString FJsProfiler::ResolveOutputPath(const FString& FilePath, const TCHAR* Extension)
+{
+    FString OutputPath = FilePath;
+    if (OutputPath.IsEmpty())
+    {
+        OutputPath = FString::Printf(TEXT("Puerts-%s%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S-%s")), Extension);
+    }
+    if (FPaths::IsRelative(OutputPath))
+    {
+        OutputPath = FPaths::Combine(FPaths::ProfilingDir(), OutputPath);
+    }
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+    return OutputPath;
+}
+}    // namespace PUERTS_NAMESPACE
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#ifndef WITH_QUICKJS
+
+#include "CoreMinimal.h"
+
+#include "NamespaceDef.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#include "v8-profiler.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+namespace PUERTS_NAMESPACE
+{
+/**
+ * 不依赖inspector的cpu采样和堆快照，结果写成DevTools可直接加载的.cpuprofile/.heapsnapshot文件。
+ * 调用方负责Locker，其它scope在内部建立。
+ */
+class FJsProfiler
+{
+public:
+    explicit FJsProfiler(v8::Isolate* InIsolate);
+
+    ~FJsProfiler();
+
+    bool StartCpuProfile(int32 SamplingIntervalUs);
+
+    bool IsCpuProfiling() const
+    {
+        return CpuProfiling;
+    }
+
+    // 返回写入的文件路径，失败返回空串
+    FString StopCpuProfile(const FString& FilePath);
+
+    FString TakeHeapSnapshot(const FString& FilePath);
+
+    // 空路径按时间生成文件名，相对路径放在Saved/Profiling下
+    static FString ResolveOutputPath(const FString& FilePath, const TCHAR* Extension);
+
+private:
+    v8::Isolate* Isolate;
+
+    v8::CpuProfiler* CpuProfiler = nullptr;
+
+    bool CpuProfiling = false;
+};
+}    // namespace PUERTS_NAMESPACE
+
+#endif
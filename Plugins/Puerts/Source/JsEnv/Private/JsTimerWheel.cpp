@@ -0,0 +1,114 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsTimerWheel.h"
+
+namespace PUERTS_NAMESPACE
+{
+FJsTimerWheel::FJsTimerWheel() : CurrentTick(0), EntryCount(0)
+{
+}
+
+void FJsTimerWheel::Add(uint32 Id, uint64 ExpireTick)
+{
+    Place({Id, FMath::Max(ExpireTick, CurrentTick)});
+    ++EntryCount;
+}
+
+void FJsTimerWheel::Place(const FEntry& Entry)
+{
+    SlotOf(Entry.ExpireTick).Add(Entry);
+}
+
+TArray<FJsTimerWheel::FEntry>& FJsTimerWheel::SlotOf(uint64 ExpireTick)
+{
+    const uint64 Delta = ExpireTick - CurrentTick;
+    if (Delta < RootSize)
+    {
+        return Root[ExpireTick & (RootSize - 1)];
+    }
+    for (int32 Level = 0; Level < NumLevels - 1; ++Level)
+    {
+        const int32 Shift = RootBits + LevelBits * Level;
+        if (Delta < (1ull << (Shift + LevelBits)) || Level == NumLevels - 2)
+        {
+            // 超出最大跨度的timer先放在最高层最远的槽，下沉时会按真实到期时间重新放置
+            const uint64 Tick = Delta < MaxSpan ? ExpireTick : CurrentTick + MaxSpan - 1;
+            return Levels[Level][(Tick >> Shift) & (LevelSize - 1)];
+        }
+    }
+    checkNoEntry();
+    return Root[0];
+}
+
+int32 FJsTimerWheel::Cascade(int32 Level, int32 Index)
+{
+    TArray<FEntry> Entries = MoveTemp(Levels[Level][Index]);
+    for (const FEntry& Entry : Entries)
+    {
+        Place(Entry);
+    }
+    return Index;
+}
+
+void FJsTimerWheel::Advance(uint64 NowTick, TArray<uint32>& OutExpired)
+{
+    if (EntryCount == 0)
+    {
+        // 所有槽都是空的，不需要逐刻度进位
+        CurrentTick = FMath::Max(CurrentTick, NowTick + 1);
+        return;
+    }
+
+    while (CurrentTick <= NowTick)
+    {
+        const int32 RootIndex = static_cast<int32>(CurrentTick & (RootSize - 1));
+        if (RootIndex == 0)
+        {
+            // 第0层转完一圈，从上层取下一段时间的timer下沉，逐层进位
+            for (int32 Level = 0; Level < NumLevels - 1; ++Level)
+            {
+                const int32 Shift = RootBits + LevelBits * Level;
+                if (Cascade(Level, static_cast<int32>((CurrentTick >> Shift) & (LevelSize - 1))) != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        TArray<FEntry>& Slot = Root[RootIndex];
+        if (Slot.Num() > 0)
+        {
+            for (const FEntry& Entry : Slot)
+            {
+                OutExpired.Add(Entry.Id);
+            }
+            EntryCount -= Slot.Num();
+            Slot.Reset();
+        }
+
+        ++CurrentTick;
+    }
+}
+
+void FJsTimerWheel::Reset()
+{
+    for (auto& Slot : Root)
+    {
+        Slot.Empty();
+    }
+    for (auto& Level : Levels)
+    {
+        for (auto& Slot : Level)
+        {
+            Slot.Empty();
+        }
+    }
+    EntryCount = 0;
+}
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,76 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NamespaceDef.h"
+
+namespace PUERTS_NAMESPACE
+{
+/**
+ * 分层时间轮，刻度为1毫秒，用于setTimeout/setInterval。
+ * 第0层256个槽，覆盖256ms；之后每层64个槽，分别覆盖约16秒、17分钟、18小时，更远的timer先放最高层，逐层下沉。
+ * 插入O(1)；取消由调用方做惰性删除（到期时发现id已不存在就跳过），时间轮本身不需要查找。
+ */
+class FJsTimerWheel
+{
+public:
+    FJsTimerWheel();
+
+    // ExpireTick早于当前刻度时按当前刻度处理，即下一次Advance必定到期
+    void Add(uint32 Id, uint64 ExpireTick);
+
+    // 推进到NowTick（含），把到期的id按到期先后追加到OutExpired
+    void Advance(uint64 NowTick, TArray<uint32>& OutExpired);
+
+    void Reset();
+
+    // 下一个待处理的刻度，新加入的timer最早在这个刻度到期
+    FORCEINLINE uint64 GetCurrentTick() const
+    {
+        return CurrentTick;
+    }
+
+    // 包括已被取消但还没轮到的条目
+    FORCEINLINE int32 NumEntries() const
+    {
+        return EntryCount;
+    }
+
+private:
+    struct FEntry
+    {
+        uint32 Id;
+        uint64 ExpireTick;
+    };
+
+    static constexpr int32 RootBits = 8;
+    static constexpr int32 LevelBits = 6;
+    static constexpr int32 NumLevels = 4;
+    static constexpr int32 RootSize = 1 << RootBits;
+    static constexpr int32 LevelSize = 1 << LevelBits;
+    static constexpr uint64 MaxSpan = 1ull << (RootBits + LevelBits * (NumLevels - 1));
+
+    TArray<FEntry>& SlotOf(uint64 ExpireTick);
+
+    void Place(const FEntry& Entry);
+
+    // 把Level层Index槽的条目重新放置到更低的层，返回Index
+    int32 Cascade(int32 Level, int32 Index);
+
+    TArray<FEntry> Root[RootSize];
+
+    TArray<FEntry> Levels[NumLevels - 1][LevelSize];
+
+    uint64 CurrentTick;
+
+    int32 EntryCount;
+};
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,72 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#include "NamespaceDef.h"
+
+#if (ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 26)
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#endif
+
+#if defined(CPUPROFILERTRACE_ENABLED) && CPUPROFILERTRACE_ENABLED && (ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 26)
+#define PUERTS_TRACE_ENABLED 1
+#else
+#define PUERTS_TRACE_ENABLED 0
+#endif
+
+#if PUERTS_TRACE_ENABLED
+// Unreal Insights里的三个通道，和cpu通道一起打开才会记录，运行时可用 Trace.Enable PuertsCall,PuertsModule,PuertsGC 开关
+// PuertsCall: js调用UFunction（FFunctionTranslator）以及c++调用js（InvokeJsMethod、InvokeTsMethod、InvokeMixinMethod、delegate回调）
+UE_TRACE_CHANNEL_EXTERN(PuertsCallChannel)
+// PuertsModule: 模块加载执行及其中的编译
+UE_TRACE_CHANNEL_EXTERN(PuertsModuleChannel)
+// PuertsGC: v8的每次gc，从prologue到epilogue
+UE_TRACE_CHANNEL_EXTERN(PuertsGCChannel)
+
+namespace PUERTS_NAMESPACE
+{
+class FJsTraceScope
+{
+public:
+    FORCEINLINE explicit FJsTraceScope(bool InEnabled) : Enabled(InEnabled)
+    {
+    }
+
+    FORCEINLINE ~FJsTraceScope()
+    {
+        if (Enabled)
+        {
+            FCpuProfilerTrace::OutputEndEvent();
+        }
+    }
+
+    const bool Enabled;
+};
+
+// 事件名按函数区分，Insights的Timers面板里即是每个函数的调用次数和耗时
+FORCEINLINE FString GetTraceName(const UFunction* Function)
+{
+    return Function ? FString::Printf(TEXT("%s.%s"), *Function->GetOuter()->GetName(), *Function->GetName()) : FString(TEXT("None"));
+}
+}    // namespace PUERTS_NAMESPACE
+
+// 通道关闭时只有一次通道检查，NameExpr不会被求值
+#define PUERTS_TRACE_SCOPE(Channel, NameExpr)                                                                              \
+    PUERTS_NAMESPACE::FJsTraceScope PREPROCESSOR_JOIN(PuertsTraceScope, __LINE__)(                                         \
+        UE_TRACE_CHANNELEXPR_IS_ENABLED(Channel | CpuChannel));                                                            \
+    if (PREPROCESSOR_JOIN(PuertsTraceScope, __LINE__).Enabled)                                                             \
+    {                                                                                                                      \
+        FCpuProfilerTrace::OutputBeginDynamicEvent(*(NameExpr));                                                           \
+    }
+#else
+#define PUERTS_TRACE_SCOPE(Channel, NameExpr)
+#endif
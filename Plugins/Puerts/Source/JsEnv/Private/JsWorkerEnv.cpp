@@ -0,0 +1,486 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsWorkerEnv.h"
+
+#ifndef WITH_QUICKJS
+#include "JsEnvModule.h"
+#include "JSLogger.h"
+#include "V8Utils.h"
+#include "DataTransfer.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "libplatform/libplatform.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+namespace PUERTS_NAMESPACE
+{
+namespace
+{
+class FWorkerSerializerDelegate : public v8::ValueSerializer::Delegate
+{
+public:
+    explicit FWorkerSerializerDelegate(v8::Isolate* InIsolate) : Isolate(InIsolate)
+    {
+    }
+
+    virtual void ThrowDataCloneError(v8::Local<v8::String> Message) override
+    {
+        Isolate->ThrowException(v8::Exception::Error(Message));
+    }
+
+    // 带internal field的对象（UObject、结构体、容器等的js包装）都会走到这里，跨isolate传递没有意义，直接拒绝
+    virtual v8::Maybe<bool> WriteHostObject(v8::Isolate* InIsolate, v8::Local<v8::Object> Object) override
+    {
+        FV8Utils::ThrowException(InIsolate, "native object (UObject, struct, container...) can not be posted to other isolate");
+        return v8::Nothing<bool>();
+    }
+
+private:
+    v8::Isolate* Isolate;
+};
+
+static constexpr uint32 WorkerThreadStackSize = 2 * 1024 * 1024;
+}    // namespace
+
+bool FJsWorkerMessage::Serialize(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Value> Value,
+    v8::Local<v8::Value> TransferList, FJsWorkerMessage& OutMessage)
+{
+    FWorkerSerializerDelegate Delegate(Isolate);
+    v8::ValueSerializer Serializer(Isolate, &Delegate);
+
+    TArray<v8::Local<v8::ArrayBuffer>> Transferred;
+    if (!TransferList.IsEmpty() && TransferList->IsArray())
+    {
+        v8::Local<v8::Array> Array = TransferList.As<v8::Array>();
+        for (uint32 i = 0; i < Array->Length(); ++i)
+        {
+            v8::Local<v8::Value> Item;
+            if (!Array->Get(Context, i).ToLocal(&Item) || !Item->IsArrayBuffer() || !Item.As<v8::ArrayBuffer>()->IsDetachable())
+            {
+                FV8Utils::ThrowException(Isolate, "only detachable ArrayBuffer can be transferred");
+                return false;
+            }
+            Serializer.TransferArrayBuffer(Transferred.Num(), Item.As<v8::ArrayBuffer>());
+            Transferred.Add(Item.As<v8::ArrayBuffer>());
+        }
+    }
+
+    Serializer.WriteHeader();
+    if (!Serializer.WriteValue(Context, Value).FromMaybe(false))
+    {
+        return false;
+    }
+    std::pair<uint8_t*, size_t> Buffer = Serializer.Release();
+    OutMessage.Data.Append(Buffer.first, Buffer.second);
+    Delegate.FreeBufferMemory(Buffer.first);
+
+    // 编辑器下v8是dll，不跨isolate共享BackingStore，内容拷贝一次，原ArrayBuffer照样detach，语义与transfer一致
+    OutMessage.ArrayBuffers.Reserve(Transferred.Num());
+    for (v8::Local<v8::ArrayBuffer> ArrayBuffer : Transferred)
+    {
+        size_t Length = 0;
+        const uint8* Contents = static_cast<const uint8*>(DataTransfer::GetArrayBufferData(ArrayBuffer, Length));
+        OutMessage.ArrayBuffers.Emplace(Contents, static_cast<int32>(Length));
+        ArrayBuffer->Detach();
+    }
+    OutMessage.SendTime = FPlatformTime::Seconds();
+    return true;
+}
+
+v8::MaybeLocal<v8::Value> FJsWorkerMessage::Deserialize(v8::Isolate* Isolate, v8::Local<v8::Context> Context)
+{
+    v8::ValueDeserializer Deserializer(Isolate, Data.GetData(), Data.Num());
+    for (int32 i = 0; i < ArrayBuffers.Num(); ++i)
+    {
+        v8::Local<v8::ArrayBuffer> ArrayBuffer = v8::ArrayBuffer::New(Isolate, ArrayBuffers[i].Num());
+        FMemory::Memcpy(DataTransfer::GetArrayBufferData(ArrayBuffer), ArrayBuffers[i].GetData(), ArrayBuffers[i].Num());
+        Deserializer.TransferArrayBuffer(i, ArrayBuffer);
+    }
+    if (!Deserializer.ReadHeader(Context).FromMaybe(false))
+    {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    return Deserializer.ReadValue(Context);
+}
+
+FJsWorkerEnv::FJsWorkerEnv(
+    int32 InId, std::shared_ptr<IJSModuleLoader> InModuleLoader, std::shared_ptr<ILogger> InLogger, const FString& InModuleName)
+    : Id(InId)
+    , ModuleLoader(InModuleLoader)
+    , Logger(InLogger)
+    , ModuleName(InModuleName)
+    , Platform(IJsEnvModule::Get().GetV8Platform())
+    , Isolate(nullptr)
+{
+    WakeUpEvent = FPlatformProcess::GetSynchEventFromPool();
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("PuertsWorker_%d"), Id), WorkerThreadStackSize, TPri_Normal);
+}
+
+FJsWorkerEnv::~FJsWorkerEnv()
+{
+    Terminate();
+    FPlatformProcess::ReturnSynchEventToPool(WakeUpEvent);
+}
+
+void FJsWorkerEnv::PostToWorker(FJsWorkerMessage&& Message)
+{
+    Inbox.Enqueue(MoveTemp(Message));
+    WakeUpEvent->Trigger();
+}
+
+void FJsWorkerEnv::Stop()
+{
+    Stopping = true;
+    {
+        FScopeLock ScopeLock(&IsolateLock);
+        if (Isolate)
+        {
+            Isolate->TerminateExecution();
+        }
+    }
+    WakeUpEvent->Trigger();
+}
+
+void FJsWorkerEnv::Terminate()
+{
+    if (Thread)
+    {
+        Stop();
+        Thread->WaitForCompletion();
+        delete Thread;
+        Thread = nullptr;
+    }
+}
+
+bool FJsWorkerEnv::CreateIsolate()
+{
+    v8::Isolate* NewIsolate = nullptr;
+#if defined(WITH_NODEJS)
+    if (uv_loop_init(&WorkerUVLoop) != 0)
+    {
+        return false;
+    }
+    NodeArrayBufferAllocator = node::ArrayBufferAllocator::Create();
+    // 只借用node的isolate设置和平台注册，不创建node环境，worker里没有node api
+    NewIsolate = node::NewIsolate(NodeArrayBufferAllocator.get(), &WorkerUVLoop, static_cast<node::MultiIsolatePlatform*>(Platform));
+#else
+    CreateParams.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    NewIsolate = v8::Isolate::New(CreateParams);
+    NewIsolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+#endif
+
+    FScopeLock ScopeLock(&IsolateLock);
+    Isolate = NewIsolate;
+    return Isolate != nullptr;
+}
+
+void FJsWorkerEnv::DisposeIsolate()
+{
+    v8::Isolate* OldIsolate;
+    {
+        FScopeLock ScopeLock(&IsolateLock);
+        OldIsolate = Isolate;
+        Isolate = nullptr;
+    }
+    if (!OldIsolate)
+    {
+        return;
+    }
+#if defined(WITH_NODEJS)
+    static_cast<node::MultiIsolatePlatform*>(Platform)->UnregisterIsolate(OldIsolate);
+#endif
+    OldIsolate->Dispose();
+#if defined(WITH_NODEJS)
+    // 平台注册的定时器等句柄要先关闭并跑完回调，否则uv_loop_close会因为还有活动句柄而失败
+    uv_walk(
+        &WorkerUVLoop,
+        [](uv_handle_t* Handle, void*)
+        {
+            if (!uv_is_closing(Handle))
+            {
+                uv_close(Handle, nullptr);
+            }
+        },
+        nullptr);
+    uv_run(&WorkerUVLoop, UV_RUN_DEFAULT);
+    const int Ret = uv_loop_close(&WorkerUVLoop);
+    if (Ret != 0)
+    {
+        UE_LOG(Puerts, Warning, TEXT("Failed to close worker %d loop: %s"), Id, UTF8_TO_TCHAR(uv_err_name(Ret)));
+    }
+    NodeArrayBufferAllocator.reset();
+#else
+    delete CreateParams.array_buffer_allocator;
+    CreateParams.array_buffer_allocator = nullptr;
+#endif
+}
+
+void FJsWorkerEnv::PumpPlatformTasks()
+{
+#if defined(WITH_NODEJS)
+    static_cast<node::MultiIsolatePlatform*>(Platform)->FlushForegroundTasks(Isolate);
+    // 延迟任务通过worker自己的uv loop上的定时器投递，需要在这里驱动
+    uv_run(&WorkerUVLoop, UV_RUN_NOWAIT);
+#else
+    while (v8::platform::PumpMessageLoop(static_cast<v8::Platform*>(Platform), Isolate))
+    {
+    }
+#endif
+}
+
+uint32 FJsWorkerEnv::Run()
+{
+    if (!CreateIsolate())
+    {
+        FJsWorkerMessage Message;
+        Message.Error = TEXT("create worker isolate fail");
+        Outbox.Enqueue(MoveTemp(Message));
+        return 1;
+    }
+
+    {
+        v8::Isolate::Scope IsolateScope(Isolate);
+        v8::HandleScope HandleScope(Isolate);
+        v8::Local<v8::Context> Context = v8::Context::New(Isolate);
+        v8::Context::Scope ContextScope(Context);
+
+        SetupGlobals(Context);
+
+        if (!Stopping && ExecuteModule(Context, TEXT("puerts/worker_bootstrap.js")))
+        {
+            v8::TryCatch TryCatch(Isolate);
+            v8::Local<v8::Value> Require;
+            if (Context->Global()->Get(Context, FV8Utils::ToV8String(Isolate, "require")).ToLocal(&Require) &&
+                Require->IsFunction())
+            {
+                v8::Local<v8::Value> Args[] = {FV8Utils::ToV8String(Isolate, ModuleName)};
+                __USE(Require.As<v8::Function>()->Call(Context, v8::Undefined(Isolate), 1, Args));
+            }
+            Isolate->PerformMicrotaskCheckpoint();
+            if (TryCatch.HasCaught())
+            {
+                ReportException(TryCatch);
+            }
+        }
+
+        FJsWorkerMessage Message;
+        while (!Stopping)
+        {
+            bool Dispatched = false;
+            while (!Stopping && Inbox.Dequeue(Message))
+            {
+                v8::HandleScope MessageHandleScope(Isolate);
+                HandleMessage(Context, Message);
+                Dispatched = true;
+            }
+            PumpPlatformTasks();
+            Isolate->PerformMicrotaskCheckpoint();
+            if (!Dispatched)
+            {
+                // 带超时等待，平台的延迟任务（比如GC相关）也需要有机会执行
+                WakeUpEvent->Wait(10);
+            }
+        }
+        MessageDispatcher.Reset();
+    }
+
+    DisposeIsolate();
+    return 0;
+}
+
+void FJsWorkerEnv::SetupGlobals(v8::Local<v8::Context> Context)
+{
+    v8::Local<v8::Object> Global = Context->Global();
+    v8::Local<v8::External> This = v8::External::New(Isolate, this);
+
+    Global->Set(Context, FV8Utils::ToV8String(Isolate, "global"), Global).Check();
+
+    auto BindFunction = [&](const char* Name, v8::FunctionCallback Callback)
+    {
+        Global
+            ->Set(Context, FV8Utils::ToV8String(Isolate, Name),
+                v8::FunctionTemplate::New(Isolate, Callback, This)->GetFunction(Context).ToLocalChecked())
+            .Check();
+    };
+    BindFunction("__tgjsWorkerPostMessage", &FJsWorkerEnv::PostMessageToHost);
+    BindFunction("__tgjsWorkerLoadModule", &FJsWorkerEnv::LoadModule);
+    BindFunction("__tgjsWorkerEvalScript", &FJsWorkerEnv::EvalScript);
+    BindFunction("__tgjsWorkerLog", &FJsWorkerEnv::Log);
+    BindFunction("__tgjsWorkerSetMessageDispatcher", &FJsWorkerEnv::SetMessageDispatcher);
+    Global->Set(Context, FV8Utils::ToV8String(Isolate, "__tgjsWorkerId"), v8::Integer::New(Isolate, Id)).Check();
+}
+
+bool FJsWorkerEnv::ExecuteModule(v8::Local<v8::Context> Context, const FString& InModuleName)
+{
+    FString OutPath;
+    FString DebugPath;
+    TArray<uint8> Data;
+    if (!ModuleLoader->Search(TEXT(""), InModuleName, OutPath, DebugPath) || !ModuleLoader->Load(OutPath, Data))
+    {
+        FJsWorkerMessage Message;
+        Message.Error = FString::Printf(TEXT("can not load [%s]"), *InModuleName);
+        Outbox.Enqueue(MoveTemp(Message));
+        return false;
+    }
+
+    v8::TryCatch TryCatch(Isolate);
+    v8::Local<v8::String> Source = FV8Utils::ToV8StringFromFileContent(Isolate, Data);
+#if V8_MAJOR_VERSION > 8
+    v8::ScriptOrigin Origin(Isolate, FV8Utils::ToV8String(Isolate, DebugPath));
+#else
+    v8::ScriptOrigin Origin(FV8Utils::ToV8String(Isolate, DebugPath));
+#endif
+    v8::Local<v8::Script> Script;
+    if (!v8::Script::Compile(Context, Source, &Origin).ToLocal(&Script) || Script->Run(Context).IsEmpty())
+    {
+        ReportException(TryCatch);
+        return false;
+    }
+    return true;
+}
+
+void FJsWorkerEnv::HandleMessage(v8::Local<v8::Context> Context, FJsWorkerMessage& Message)
+{
+    v8::TryCatch TryCatch(Isolate);
+    v8::Local<v8::Value> Data;
+    if (!Message.Deserialize(Isolate, Context).ToLocal(&Data))
+    {
+        ReportException(TryCatch);
+        return;
+    }
+
+    if (MessageDispatcher.IsEmpty())
+    {
+        return;
+    }
+    v8::Local<v8::Value> Args[] = {Data};
+    __USE(MessageDispatcher.Get(Isolate)->Call(Context, Context->Global(), 1, Args));
+    if (TryCatch.HasCaught())
+    {
+        ReportException(TryCatch);
+    }
+}
+
+void FJsWorkerEnv::ReportException(v8::TryCatch& TryCatch)
+{
+    if (TryCatch.HasTerminated())
+    {
+        return;
+    }
+    FJsWorkerMessage Message;
+    Message.Error = FV8Utils::TryCatchToString(Isolate, &TryCatch);
+    Outbox.Enqueue(MoveTemp(Message));
+}
+
+void FJsWorkerEnv::PostMessageToHost(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+    FJsWorkerEnv* Self = static_cast<FJsWorkerEnv*>(v8::Local<v8::External>::Cast(Info.Data())->Value());
+
+    FJsWorkerMessage Message;
+    if (FJsWorkerMessage::Serialize(Isolate, Context, Info[0], Info[1], Message))
+    {
+        Self->Outbox.Enqueue(MoveTemp(Message));
+    }
+}
+
+void FJsWorkerEnv::LoadModule(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+    FJsWorkerEnv* Self = static_cast<FJsWorkerEnv*>(v8::Local<v8::External>::Cast(Info.Data())->Value());
+
+    CHECK_V8_ARGS(EArgString, EArgString);
+
+    FString RequiredModule = FV8Utils::ToFString(Isolate, Info[0]);
+    FString RequiringDir = FV8Utils::ToFString(Isolate, Info[1]);
+    FString OutPath;
+    FString OutDebugPath;
+    if (!Self->ModuleLoader->Search(RequiringDir, RequiredModule, OutPath, OutDebugPath))
+    {
+        return;
+    }
+    TArray<uint8> Data;
+    if (!Self->ModuleLoader->Load(OutPath, Data))
+    {
+        FV8Utils::ThrowException(Isolate, FString::Printf(TEXT("can not load [%s]"), *OutPath));
+        return;
+    }
+
+    v8::Local<v8::Array> Result = v8::Array::New(Isolate, 3);
+    Result->Set(Context, 0, FV8Utils::ToV8String(Isolate, OutPath)).Check();
+    Result->Set(Context, 1, FV8Utils::ToV8String(Isolate, OutDebugPath)).Check();
+    Result->Set(Context, 2, FV8Utils::ToV8StringFromFileContent(Isolate, Data)).Check();
+    Info.GetReturnValue().Set(Result);
+}
+
+void FJsWorkerEnv::EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+
+    CHECK_V8_ARGS(EArgString, EArgString);
+
+#if V8_MAJOR_VERSION > 8
+    v8::ScriptOrigin Origin(Isolate, Info[1].As<v8::String>());
+#else
+    v8::ScriptOrigin Origin(Info[1].As<v8::String>());
+#endif
+    v8::Local<v8::Script> Script;
+    v8::Local<v8::Value> Result;
+    if (v8::Script::Compile(Context, Info[0].As<v8::String>(), &Origin).ToLocal(&Script) && Script->Run(Context).ToLocal(&Result))
+    {
+        Info.GetReturnValue().Set(Result);
+    }
+}
+
+void FJsWorkerEnv::Log(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    v8::Local<v8::Context> Context = Isolate->GetCurrentContext();
+    FJsWorkerEnv* Self = static_cast<FJsWorkerEnv*>(v8::Local<v8::External>::Cast(Info.Data())->Value());
+
+    CHECK_V8_ARGS(EArgInt32, EArgString);
+
+    int32 Level = Info[0]->Int32Value(Context).ToChecked();
+    FString Message = FString::Printf(TEXT("[worker %d] %s"), Self->Id, *FV8Utils::ToFString(Isolate, Info[1]));
+    switch (Level)
+    {
+        case 1:
+            Self->Logger->Info(Message);
+            break;
+        case 2:
+            Self->Logger->Warn(Message);
+            break;
+        case 3:
+            Self->Logger->Error(Message);
+            break;
+        default:
+            Self->Logger->Log(Message);
+            break;
+    }
+}
+
+void FJsWorkerEnv::SetMessageDispatcher(const v8::FunctionCallbackInfo<v8::Value>& Info)
+{
+    v8::Isolate* Isolate = Info.GetIsolate();
+    FJsWorkerEnv* Self = static_cast<FJsWorkerEnv*>(v8::Local<v8::External>::Cast(Info.Data())->Value());
+
+    CHECK_V8_ARGS(EArgFunction);
+
+    Self->MessageDispatcher.Reset(Isolate, Info[0].As<v8::Function>());
+}
+}    // namespace PUERTS_NAMESPACE
+#endif
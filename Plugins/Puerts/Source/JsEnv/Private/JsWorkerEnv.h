@@ -0,0 +1,161 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+#include "Containers/Queue.h"
+#include "JSLogger.h"
+#include "JSModuleLoader.h"
+
+#include "NamespaceDef.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+#if defined(WITH_NODEJS)
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "node.h"
+#include "uv.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#endif
+
+#ifndef WITH_QUICKJS
+namespace PUERTS_NAMESPACE
+{
+// 在isolate之间传递的消息，Data是v8::ValueSerializer的输出（结构化克隆）
+struct FJsWorkerMessage
+{
+    TArray<uint8> Data;
+
+    // transfer列表中的ArrayBuffer内容，原ArrayBuffer在发送时被detach
+    TArray<TArray<uint8>> ArrayBuffers;
+
+    // 非空表示这是worker中未捕获异常的报告，Data为空
+    FString Error;
+
+    // 发送方设置，接收方可以据此统计延迟
+    double SendTime = 0;
+
+    // 序列化失败时已经往Isolate抛了异常，返回false
+    static bool Serialize(v8::Isolate* Isolate, v8::Local<v8::Context> Context, v8::Local<v8::Value> Value,
+        v8::Local<v8::Value> TransferList, FJsWorkerMessage& OutMessage);
+
+    v8::MaybeLocal<v8::Value> Deserialize(v8::Isolate* Isolate, v8::Local<v8::Context> Context);
+};
+
+/**
+ * 在独立线程上运行的轻量isolate：只有纯js运行时，没有UE绑定，因而在worker里拿不到UObject；
+ * 和游戏线程之间只能通过结构化克隆的消息通信，UObject等宿主对象在序列化时会被拒绝。
+ * 模块通过与主虚拟机相同的IJSModuleLoader加载。
+ * 游戏线程调用PostToWorker投递，worker线程postMessage的结果放在发件箱里，由游戏线程调用Receive取走。
+ */
+class FJsWorkerEnv : public FRunnable
+{
+public:
+    FJsWorkerEnv(int32 InId, std::shared_ptr<IJSModuleLoader> InModuleLoader, std::shared_ptr<ILogger> InLogger,
+        const FString& InModuleName);
+
+    ~FJsWorkerEnv();
+
+    FORCEINLINE int32 GetId() const
+    {
+        return Id;
+    }
+
+    // 任意线程调用
+    void PostToWorker(FJsWorkerMessage&& Message);
+
+    // 游戏线程调用，取出worker发来的消息
+    FORCEINLINE bool Receive(FJsWorkerMessage& OutMessage)
+    {
+        return Outbox.Dequeue(OutMessage);
+    }
+
+    // 停止线程并等待退出，正在执行的js会被TerminateExecution打断
+    void Terminate();
+
+    // FRunnable
+    virtual uint32 Run() override;
+
+    virtual void Stop() override;
+
+private:
+    bool CreateIsolate();
+
+    void DisposeIsolate();
+
+    void SetupGlobals(v8::Local<v8::Context> Context);
+
+    bool ExecuteModule(v8::Local<v8::Context> Context, const FString& ModuleName);
+
+    void HandleMessage(v8::Local<v8::Context> Context, FJsWorkerMessage& Message);
+
+    void PumpPlatformTasks();
+
+    void ReportException(v8::TryCatch& TryCatch);
+
+    static void PostMessageToHost(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    static void LoadModule(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    static void EvalScript(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    static void Log(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    static void SetMessageDispatcher(const v8::FunctionCallbackInfo<v8::Value>& Info);
+
+    int32 Id;
+
+    std::shared_ptr<IJSModuleLoader> ModuleLoader;
+
+    std::shared_ptr<ILogger> Logger;
+
+    FString ModuleName;
+
+    TQueue<FJsWorkerMessage, EQueueMode::Mpsc> Inbox;
+
+    TQueue<FJsWorkerMessage, EQueueMode::Spsc> Outbox;
+
+    FEvent* WakeUpEvent;
+
+    FThreadSafeBool Stopping;
+
+    FRunnableThread* Thread;
+
+    // 构造时在游戏线程取得，worker线程里不访问ModuleManager
+    void* Platform;
+
+    // Stop可能在其它线程调用TerminateExecution，与isolate的销毁互斥
+    FCriticalSection IsolateLock;
+
+    v8::Isolate* Isolate;
+
+    v8::Isolate::CreateParams CreateParams;
+
+    // worker_bootstrap.js设置，收到的消息都交给它分发（onmessage或者请求应答）
+    v8::Global<v8::Function> MessageDispatcher;
+
+#if defined(WITH_NODEJS)
+    uv_loop_t WorkerUVLoop;
+
+    std::unique_ptr<node::ArrayBufferAllocator> NodeArrayBufferAllocator;
+#endif
+};
+}    // namespace PUERTS_NAMESPACE
+#endif
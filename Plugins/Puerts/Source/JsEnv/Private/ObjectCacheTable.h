@@ -0,0 +1,305 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NamespaceDef.h"
+
+PRAGMA_DISABLE_UNDEFINED_IDENTIFIER_WARNINGS
+#pragma warning(push, 0)
+#include "v8.h"
+#pragma warning(pop)
+PRAGMA_ENABLE_UNDEFINED_IDENTIFIER_WARNINGS
+
+namespace PUERTS_NAMESPACE
+{
+// 同一个地址可能同时以多种类型暴露给js（比如结构体的第一个成员和结构体本身），类型id作为key的一部分，
+// 这样每种类型各占一个槽位，不再需要FObjectCacheNode那样按地址挂链表
+struct FStructCacheKey
+{
+    void* Ptr;
+    const void* TypeId;
+
+    FORCEINLINE bool operator==(const FStructCacheKey& Other) const
+    {
+        return Ptr == Other.Ptr && TypeId == Other.TypeId;
+    }
+};
+
+struct FStructCacheValue
+{
+    v8::UniquePersistent<v8::Value> Value;
+
+    void* UserData = nullptr;
+};
+
+template <typename KeyType>
+struct TObjectCacheKeyFuncs;
+
+template <typename T>
+struct TObjectCacheKeyFuncs<T*>
+{
+    FORCEINLINE static uint64 Hash(T* Key)
+    {
+        // 对象地址低位基本是对齐产生的0，乘法散列把高位的熵扩散到槽位索引用到的位上
+        return (static_cast<uint64>(reinterpret_cast<UPTRINT>(Key)) >> 4) * 0x9E3779B97F4A7C15ull;
+    }
+
+    FORCEINLINE static bool IsEmpty(T* Key)
+    {
+        return Key == nullptr;
+    }
+
+    FORCEINLINE static T* EmptyKey()
+    {
+        return nullptr;
+    }
+};
+
+template <>
+struct TObjectCacheKeyFuncs<FStructCacheKey>
+{
+    FORCEINLINE static uint64 Hash(const FStructCacheKey& Key)
+    {
+        uint64 H = static_cast<uint64>(reinterpret_cast<UPTRINT>(Key.Ptr)) >> 3;
+        H ^= (static_cast<uint64>(reinterpret_cast<UPTRINT>(Key.TypeId)) >> 3) * 0xC2B2AE3D27D4EB4Full;
+        return H * 0x9E3779B97F4A7C15ull;
+    }
+
+    FORCEINLINE static bool IsEmpty(const FStructCacheKey& Key)
+    {
+        return Key.Ptr == nullptr;
+    }
+
+    FORCEINLINE static FStructCacheKey EmptyKey()
+    {
+        return {nullptr, nullptr};
+    }
+};
+
+struct FObjectCacheTableStats
+{
+    int32 Num = 0;
+
+    int32 Capacity = 0;
+
+    float LoadFactor = 0.f;
+
+    float AverageProbeLength = 0.f;
+
+    int32 MaxProbeLength = 0;
+};
+
+/**
+ * 线性探测的开放寻址表，用于UObject/结构体指针到js对象的缓存。
+ * key和value分开存放，探测时只扫描紧凑的key数组；删除使用backward shift，不留墓碑，
+ * 大量创建/销毁后探测长度不会退化。
+ * 注意：插入和删除都可能移动其它元素，之前Find返回的指针在修改后失效。
+ */
+template <typename KeyType, typename ValueType>
+class TObjectCacheTable
+{
+    using KeyFuncs = TObjectCacheKeyFuncs<KeyType>;
+
+public:
+    TObjectCacheTable() : Count(0), Mask(0)
+    {
+    }
+
+    TObjectCacheTable(const TObjectCacheTable&) = delete;
+    TObjectCacheTable& operator=(const TObjectCacheTable&) = delete;
+
+    FORCEINLINE int32 Num() const
+    {
+        return Count;
+    }
+
+    FORCEINLINE ValueType* Find(const KeyType& Key)
+    {
+        if (Count == 0)
+        {
+            return nullptr;
+        }
+        for (uint32 Index = IndexOf(Key);; Index = (Index + 1) & Mask)
+        {
+            const KeyType& Slot = Keys[Index];
+            if (Slot == Key)
+            {
+                return &Values[Index];
+            }
+            if (KeyFuncs::IsEmpty(Slot))
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    FORCEINLINE ValueType& FindChecked(const KeyType& Key)
+    {
+        ValueType* Result = Find(Key);
+        check(Result);
+        return *Result;
+    }
+
+    // 已存在则覆盖value
+    ValueType& Emplace(const KeyType& Key, ValueType&& Value)
+    {
+        ValueType& Slot = FindOrAdd(Key);
+        Slot = MoveTemp(Value);
+        return Slot;
+    }
+
+    ValueType& FindOrAdd(const KeyType& Key)
+    {
+        check(!KeyFuncs::IsEmpty(Key));
+        if ((Count + 1) * 4 > Keys.Num() * 3)
+        {
+            Grow();
+        }
+        uint32 Index = IndexOf(Key);
+        for (;; Index = (Index + 1) & Mask)
+        {
+            if (Keys[Index] == Key)
+            {
+                return Values[Index];
+            }
+            if (KeyFuncs::IsEmpty(Keys[Index]))
+            {
+                break;
+            }
+        }
+        Keys[Index] = Key;
+        ++Count;
+        return Values[Index];
+    }
+
+    bool Remove(const KeyType& Key)
+    {
+        if (Count == 0)
+        {
+            return false;
+        }
+        uint32 Hole = IndexOf(Key);
+        for (;; Hole = (Hole + 1) & Mask)
+        {
+            if (Keys[Hole] == Key)
+            {
+                break;
+            }
+            if (KeyFuncs::IsEmpty(Keys[Hole]))
+            {
+                return false;
+            }
+        }
+
+        // backward shift：把后面仍属于这个探测链的元素往前挪，填上空洞
+        for (uint32 Next = (Hole + 1) & Mask; !KeyFuncs::IsEmpty(Keys[Next]); Next = (Next + 1) & Mask)
+        {
+            // 离理想槽位的距离不小于到Hole的距离，说明挪到Hole后仍在它的探测链上
+            if (((Next - IndexOf(Keys[Next])) & Mask) >= ((Next - Hole) & Mask))
+            {
+                Keys[Hole] = Keys[Next];
+                Values[Hole] = MoveTemp(Values[Next]);
+                Hole = Next;
+            }
+        }
+        Keys[Hole] = KeyFuncs::EmptyKey();
+        Values[Hole] = ValueType();
+        --Count;
+        return true;
+    }
+
+    void Empty()
+    {
+        Keys.Empty();
+        Values.Empty();
+        Count = 0;
+        Mask = 0;
+    }
+
+    template <typename FuncType>
+    void ForEach(FuncType&& Func)
+    {
+        for (int32 i = 0; i < Keys.Num(); ++i)
+        {
+            if (!KeyFuncs::IsEmpty(Keys[i]))
+            {
+                Func(Keys[i], Values[i]);
+            }
+        }
+    }
+
+    FObjectCacheTableStats GetStats() const
+    {
+        FObjectCacheTableStats Stats;
+        Stats.Num = Count;
+        Stats.Capacity = Keys.Num();
+        if (Count == 0)
+        {
+            return Stats;
+        }
+        Stats.LoadFactor = static_cast<float>(Count) / Keys.Num();
+        uint64 TotalProbe = 0;
+        for (int32 i = 0; i < Keys.Num(); ++i)
+        {
+            if (!KeyFuncs::IsEmpty(Keys[i]))
+            {
+                // 探测长度 = 离理想槽位的距离 + 1
+                const int32 ProbeLength = static_cast<int32>((static_cast<uint32>(i) - IndexOf(Keys[i])) & Mask) + 1;
+                TotalProbe += ProbeLength;
+                Stats.MaxProbeLength = FMath::Max(Stats.MaxProbeLength, ProbeLength);
+            }
+        }
+        Stats.AverageProbeLength = static_cast<float>(TotalProbe) / Count;
+        return Stats;
+    }
+
+private:
+    FORCEINLINE uint32 IndexOf(const KeyType& Key) const
+    {
+        return static_cast<uint32>(KeyFuncs::Hash(Key) >> 32) & Mask;
+    }
+
+    void Grow()
+    {
+        const int32 NewCapacity = Keys.Num() == 0 ? 64 : Keys.Num() * 2;
+
+        TArray<KeyType> OldKeys = MoveTemp(Keys);
+        TArray<ValueType> OldValues = MoveTemp(Values);
+
+        Keys.Init(KeyFuncs::EmptyKey(), NewCapacity);
+        Values.SetNum(NewCapacity);
+        Mask = static_cast<uint32>(NewCapacity - 1);
+
+        for (int32 i = 0; i < OldKeys.Num(); ++i)
+        {
+            if (!KeyFuncs::IsEmpty(OldKeys[i]))
+            {
+                uint32 Index = IndexOf(OldKeys[i]);
+                while (!KeyFuncs::IsEmpty(Keys[Index]))
+                {
+                    Index = (Index + 1) & Mask;
+                }
+                Keys[Index] = OldKeys[i];
+                Values[Index] = MoveTemp(OldValues[i]);
+            }
+        }
+    }
+
+    TArray<KeyType> Keys;
+
+    TArray<ValueType> Values;
+
+    int32 Count;
+
+    uint32 Mask;
+};
+
+}    // namespace PUERTS_NAMESPACE
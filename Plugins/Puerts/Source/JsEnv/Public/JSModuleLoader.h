@@ -31,10 +31,22 @@ public:
 class JSENV_API DefaultJSModuleLoader : public IJSModuleLoader
 {
 public:
-    explicit DefaultJSModuleLoader(const FString& InScriptRoot) : ScriptRoot(InScriptRoot)
+    explicit DefaultJSModuleLoader(const FString& InScriptRoot) : ScriptRoot(InScriptRoot), ManifestLoaded(false)
     {
     }
 
+    // 模块清单文件名，位于ScriptRoot目录下，每行一个相对ScriptRoot的文件路径
+    static const TCHAR* ManifestFileName;
+
+    // 扫描Content/ScriptRoot下的所有文件，在OutputDir下生成模块清单，一般在cook结束时写到cook输出目录
+    static bool GenerateManifest(const FString& InScriptRoot, const FString& OutputDir);
+
+    // 查找结果按(RequiredDir, RequiredModule)缓存，新增或移动了js文件后需要清空
+    void ClearSearchCache();
+
+    // 让所有loader的查找缓存失效，下次Search时清空，编辑器下js文件变化或开始PIE时调用
+    static void InvalidateAllSearchCaches();
+
     virtual bool Search(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath) override;
 
     virtual bool Load(const FString& Path, TArray<uint8>& Content) override;
@@ -48,6 +60,27 @@ public:
     virtual bool SearchModuleWithExtInDir(const FString& Dir, const FString& RequiredModule, FString& Path, FString& AbsolutePath);
 
     FString ScriptRoot;
+
+protected:
+    bool SearchUncached(const FString& RequiredDir, const FString& RequiredModule, FString& Path, FString& AbsolutePath);
+
+    // 有清单时ScriptRoot下的文件是否存在直接查清单，不访问文件系统；编辑器下文件随时增删，不使用清单
+    void LoadManifest();
+
+    FCriticalSection CacheLock;
+
+    TMap<FString, TPair<FString, FString>> SearchCache;
+
+    uint32 SearchCacheEpoch = 0;
+
+    bool ManifestLoaded;
+
+    FString ManifestRoot;
+
+    // ManifestRoot的绝对路径形式，RequiredDir可能是绝对路径
+    FString ManifestFullRoot;
+
+    TSet<FString> ManifestFiles;
 };
 
 }    // namespace PUERTS_NAMESPACE
@@ -29,8 +29,16 @@ public:
 
     virtual bool IdleNotificationDeadline(double DeadlineInSeconds) = 0;
 
+    virtual bool IdleNotification(double IdleTimeInSeconds) = 0;
+
     virtual void LowMemoryNotification() = 0;
 
+    virtual bool StartCpuProfile(int32 SamplingIntervalUs) = 0;
+
+    virtual FString StopCpuProfile(const FString& FilePath) = 0;
+
+    virtual FString TakeHeapSnapshot(const FString& FilePath) = 0;
+
     virtual void RequestMinorGarbageCollectionForTesting() = 0;
 
     virtual void RequestFullGarbageCollectionForTesting() = 0;
@@ -69,10 +77,24 @@ public:
 
     void Start(const FString& ModuleName, const TArray<TPair<FString, UObject*>>& Arguments = TArray<TPair<FString, UObject*>>());
 
+    // DeadlineInSeconds is measured by the v8 platform clock (MonotonicallyIncreasingTime), not FPlatformTime::Seconds
     bool IdleNotificationDeadline(double DeadlineInSeconds);
 
+    // let v8 perform idle time tasks (mostly gc) for at most IdleTimeInSeconds from now, return true if there is no more work to do
+    bool IdleNotification(double IdleTimeInSeconds);
+
     void LowMemoryNotification();
 
+    // start the v8 sampling cpu profiler without an inspector, SamplingIntervalUs <= 0 uses the v8 default (1ms)
+    bool StartCpuProfile(int32 SamplingIntervalUs = 0);
+
+    // stop profiling and write a .cpuprofile file (loadable by Chrome DevTools), return the file written or empty on failure
+    // an empty FilePath generates a name from the current time, relative paths are under Saved/Profiling
+    FString StopCpuProfile(const FString& FilePath = FString());
+
+    // write a .heapsnapshot file, FilePath is resolved the same way as StopCpuProfile
+    FString TakeHeapSnapshot(const FString& FilePath = FString());
+
     // equivalent to Isolate->RequestGarbageCollectionForTesting(v8::Isolate::kMinorGarbageCollection)
     // It is only valid to call this function if --expose_gc was specified
     void RequestMinorGarbageCollectionForTesting();
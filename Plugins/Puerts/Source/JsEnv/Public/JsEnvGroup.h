@@ -38,6 +38,10 @@ public:
 
     void SetJsEnvSelector(std::function<int(UObject*, int)> InSelector);
 
+    // 在第EnvIndex个虚拟机下创建一个运行在独立线程上的worker，返回worker id，失败返回0
+    // worker里没有UE绑定，只能通过postMessage与创建它的虚拟机通信
+    int CreateWorker(int EnvIndex, const FString& ModuleName);
+
 private:
     std::vector<std::shared_ptr<IJsEnv>> JsEnvList;
 
@@ -15,6 +15,8 @@
 #include "EngineMinimal.h"
 #endif
 
+DECLARE_STATS_GROUP(TEXT("Puerts"), STATGROUP_Puerts, STATCAT_Advanced);
+
 /**
  * The public interface to this module
  */
@@ -0,0 +1,106 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "NamespaceDef.h"
+
+namespace PUERTS_NAMESPACE
+{
+// 以GUObjectArray下标为索引的位图，每个UObject一位，按需增长
+// 下标会被新对象复用，所以对象删除时要Clear，否则只会让新对象多走一次慢路径，不会出错
+// 需要跨线程使用时先Reserve到GUObjectArray的容量，之后只用SetAtomic/ClearAtomic修改
+class FObjectIndexBitSet
+{
+public:
+    FORCEINLINE void Set(int32 Index)
+    {
+        check(Index >= 0);
+        const int32 WordIndex = Index >> 5;
+        if (WordIndex >= Words.Num())
+        {
+            Words.AddZeroed(FMath::Max(WordIndex + 1 - Words.Num(), Words.Num()));
+        }
+        Words[WordIndex] |= 1u << (Index & 31);
+    }
+
+    FORCEINLINE bool Test(int32 Index) const
+    {
+        const int32 WordIndex = Index >> 5;
+        return Index >= 0 && WordIndex < Words.Num() && (Words[WordIndex] & (1u << (Index & 31))) != 0;
+    }
+
+    // 返回清除前是否置位
+    FORCEINLINE bool TestAndClear(int32 Index)
+    {
+        if (!Test(Index))
+        {
+            return false;
+        }
+        Words[Index >> 5] &= ~(1u << (Index & 31));
+        return true;
+    }
+
+    // Reserve之后不会再扩容，其它线程上的Test不会读到释放掉的内存
+    void Reserve(int32 MaxIndex)
+    {
+        const int32 NumWords = (MaxIndex >> 5) + 1;
+        if (NumWords > Words.Num())
+        {
+            Words.AddZeroed(NumWords - Words.Num());
+        }
+    }
+
+    FORCEINLINE void SetAtomic(int32 Index)
+    {
+        UpdateAtomic(Index, true);
+    }
+
+    FORCEINLINE void ClearAtomic(int32 Index)
+    {
+        UpdateAtomic(Index, false);
+    }
+
+    void Reset()
+    {
+        Words.Empty();
+    }
+
+    int32 NumSet() const
+    {
+        int32 Count = 0;
+        for (uint32 Word : Words)
+        {
+            Count += FPlatformMath::CountBits(Word);
+        }
+        return Count;
+    }
+
+private:
+    FORCEINLINE void UpdateAtomic(int32 Index, bool Value)
+    {
+        check(Index >= 0 && (Index >> 5) < Words.Num());
+        volatile int32* Word = reinterpret_cast<volatile int32*>(&Words[Index >> 5]);
+        const int32 Mask = static_cast<int32>(1u << (Index & 31));
+        int32 Old = *Word;
+        while (((Old & Mask) != 0) != Value)
+        {
+            const int32 Prev = FPlatformAtomics::InterlockedCompareExchange(Word, Value ? (Old | Mask) : (Old & ~Mask), Old);
+            if (Prev == Old)
+            {
+                break;
+            }
+            Old = Prev;
+        }
+    }
+
+    TArray<uint32> Words;
+};
+}    // namespace PUERTS_NAMESPACE
@@ -0,0 +1,78 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "JsIdleGCScheduler.h"
+#include "JsEnvModule.h"
+#include "PuertsSetting.h"
+#include "Engine/Engine.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Idle GC Budget (ms)"), STAT_Puerts_IdleGCBudget, STATGROUP_Puerts);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Idle GC Skipped Frames"), STAT_Puerts_IdleGCSkippedFrames, STATGROUP_Puerts);
+
+FJsIdleGCScheduler::FJsIdleGCScheduler(
+    const UPuertsSetting& Settings, TFunction<void(double)> InIdleNotification, TFunction<void()> InLowMemoryNotification)
+    : IdleNotification(MoveTemp(InIdleNotification))
+    , LowMemoryNotification(MoveTemp(InLowMemoryNotification))
+    , TargetFrameRate(Settings.IdleGCTargetFrameRate)
+    , MinIdleTime(Settings.IdleGCMinTimeMs / 1000.0)
+    , MaxIdleTime(Settings.IdleGCMaxTimeMs / 1000.0)
+    , SafetyMargin(Settings.IdleGCSafetyMarginMs / 1000.0)
+{
+    if (Settings.IdleGCEnable)
+    {
+        EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FJsIdleGCScheduler::OnEndFrame);
+    }
+    if (Settings.LowMemoryNotificationOnLoadMap)
+    {
+        PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FJsIdleGCScheduler::OnPostLoadMap);
+    }
+}
+
+FJsIdleGCScheduler::~FJsIdleGCScheduler()
+{
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+}
+
+double FJsIdleGCScheduler::GetTargetFrameTime() const
+{
+    float FrameRate = TargetFrameRate;
+    if (FrameRate <= 0 && GEngine)
+    {
+        FrameRate = GEngine->GetMaxTickRate(FApp::GetDeltaTime(), false);
+    }
+    return 1.0 / (FrameRate > 0 ? FrameRate : 60.0f);
+}
+
+void FJsIdleGCScheduler::OnEndFrame()
+{
+    // 固定步长时FApp::GetCurrentTime不是真实时间，算不出空闲
+    if (FApp::UseFixedTimeStep())
+    {
+        return;
+    }
+
+    // FApp::GetCurrentTime在帧率限制的等待之后更新，差值就是本帧游戏线程实际花掉的时间
+    const double FrameTime = FPlatformTime::Seconds() - FApp::GetCurrentTime();
+    const double IdleTime = FMath::Min(GetTargetFrameTime() - FrameTime - SafetyMargin, MaxIdleTime);
+    if (IdleTime < MinIdleTime)
+    {
+        INC_DWORD_STAT(STAT_Puerts_IdleGCSkippedFrames);
+        return;
+    }
+    INC_FLOAT_STAT_BY(STAT_Puerts_IdleGCBudget, IdleTime * 1000.0);
+    IdleNotification(IdleTime);
+}
+
+void FJsIdleGCScheduler::OnPostLoadMap(UWorld* World)
+{
+    LowMemoryNotification();
+}
@@ -0,0 +1,52 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPuertsSetting;
+class UWorld;
+
+/**
+ * 按帧调度v8的GC：每帧结束时算出离目标帧时间还剩多少，把这段空闲交给IdleNotification，
+ * 让增量标记、清理等工作尽量落在帧尾的空闲里，而不是v8自己挑的某个时机；
+ * 地图加载完（还在loading界面时）做一次LowMemoryNotification，把上一关留下的垃圾一次清掉。
+ */
+class FJsIdleGCScheduler
+{
+public:
+    // IdleNotification的参数是允许使用的时间（秒）
+    FJsIdleGCScheduler(const UPuertsSetting& Settings, TFunction<void(double)> InIdleNotification,
+        TFunction<void()> InLowMemoryNotification);
+
+    ~FJsIdleGCScheduler();
+
+private:
+    void OnEndFrame();
+
+    void OnPostLoadMap(UWorld* World);
+
+    double GetTargetFrameTime() const;
+
+    TFunction<void(double)> IdleNotification;
+
+    TFunction<void()> LowMemoryNotification;
+
+    float TargetFrameRate;
+
+    double MinIdleTime;
+
+    double MaxIdleTime;
+
+    double SafetyMargin;
+
+    FDelegateHandle EndFrameHandle;
+
+    FDelegateHandle PostLoadMapHandle;
+};
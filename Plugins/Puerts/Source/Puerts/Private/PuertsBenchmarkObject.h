@@ -0,0 +1,20 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "PuertsBenchmarkObject.generated.h"
+
+// Puerts.BenchmarkObjectCreation创建的对象，UObject本身是抽象类不能直接NewObject
+UCLASS(Transient)
+class UPuertsBenchmarkObject : public UObject
+{
+    GENERATED_BODY()
+};
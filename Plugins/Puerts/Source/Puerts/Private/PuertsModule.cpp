@@ -10,6 +10,12 @@
 #include "JsEnv.h"
 #include "JsEnvGroup.h"
 #include "PuertsSetting.h"
+#include "PuertsBenchmarkObject.h"
+#include "JsIdleGCScheduler.h"
+#include "ObjectIndexBitSet.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+#include "HAL/PlatformProperties.h"
 #if WITH_EDITOR
 #include "Editor.h"
 #include "ISettingsModule.h"
@@ -23,6 +29,7 @@
 #include "TypeScriptGeneratedClass.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Misc/Paths.h"
+#include "Misc/DateTime.h"
 #include "Misc/CommandLine.h"
 #include "Misc/ConfigCacheIni.h"
 
@@ -67,6 +74,16 @@ public:
 
     void Disable();
 
+    void InitBindJsClasses();
+
+    void BenchmarkObjectCreation(const TArray<FString>& Args);
+
+    void StartCpuProfile(const TArray<FString>& Args);
+
+    void StopCpuProfile(const TArray<FString>& Args);
+
+    void TakeHeapSnapshot(const TArray<FString>& Args);
+
     virtual bool IsEnabled() override
     {
         return Enabled;
@@ -186,6 +203,7 @@ public:
     {
         const UPuertsSetting& Settings = *GetDefault<UPuertsSetting>();
 
+        GCScheduler.Reset();
         JsEnv.Reset();
         JsEnvGroup.Reset();
 
@@ -241,6 +259,40 @@ public:
             JsEnv->RebindJs();
             UE_LOG(PuertsModule, Log, TEXT("Normal Mode started!"));
         }
+
+        GCScheduler = MakeUnique<FJsIdleGCScheduler>(
+            Settings, [this](double IdleTime) { IdleNotification(IdleTime); }, [this]() { LowMemoryNotification(); });
+    }
+
+    void IdleNotification(double IdleTime)
+    {
+        if (JsEnv.IsValid())
+        {
+            JsEnv->IdleNotification(IdleTime);
+        }
+        else if (NumberOfJsEnv > 1 && JsEnvGroup.IsValid())
+        {
+            // 空闲时间平分给各个虚拟机
+            for (int i = 0; i < NumberOfJsEnv; i++)
+            {
+                JsEnvGroup->Get(i)->IdleNotification(IdleTime / NumberOfJsEnv);
+            }
+        }
+    }
+
+    virtual void LowMemoryNotification() override
+    {
+        if (JsEnv.IsValid())
+        {
+            JsEnv->LowMemoryNotification();
+        }
+        else if (NumberOfJsEnv > 1 && JsEnvGroup.IsValid())
+        {
+            for (int i = 0; i < NumberOfJsEnv; i++)
+            {
+                JsEnvGroup->Get(i)->LowMemoryNotification();
+            }
+        }
     }
 
     virtual const TArray<FString>& GetIgnoreClassListOnDTS()
@@ -253,6 +305,11 @@ public:
         return GetDefault<UPuertsSetting>()->IgnoreStructListOnDTS;
     }
 
+    virtual const FString& GetRootPath()
+    {
+        return GetDefault<UPuertsSetting>()->RootPath;
+    }
+
 private:
     TSharedPtr<PUERTS_NAMESPACE::FJsEnv> JsEnv;
 
@@ -264,13 +321,32 @@ private:
 
     TSharedPtr<PUERTS_NAMESPACE::FJsEnvGroup> JsEnvGroup;
 
+    TUniquePtr<FJsIdleGCScheduler> GCScheduler;
+
     int32 DebuggerPortFromCommandLine = -1;
+
+    // 只有TS类的实例，以及TS类本身（它的类是UTypeScriptGeneratedClass）需要TryBindJs，以类对象的下标记录这些类，
+    // 其它对象在NotifyUObjectCreated里查一次位图就返回。异步加载线程也会创建对象，所以预分配并原子修改
+    PUERTS_NAMESPACE::FObjectIndexBitSet BindJsClasses;
+
+    TArray<TUniquePtr<FAutoConsoleCommand>> ConsoleCommands;
 };
 
 IMPLEMENT_MODULE(FPuertsModule, Puerts)
 
 void FPuertsModule::NotifyUObjectCreated(const class UObjectBase* InObject, int32 Index)
 {
+    const UClass* Class = InObject->GetClass();
+    if (!BindJsClasses.Test(GUObjectArray.ObjectToIndex(Class)))
+    {
+        return;
+    }
+    if (Class->IsChildOf(UTypeScriptGeneratedClass::StaticClass()))
+    {
+        // 新建的是TS类，之后它的实例也要绑定
+        BindJsClasses.SetAtomic(Index);
+    }
+
     if (Enabled)
     {
         if (JsEnv.IsValid())
@@ -288,6 +364,10 @@ void FPuertsModule::NotifyUObjectCreated(const class UObjectBase* InObject, int3
 
 void FPuertsModule::NotifyUObjectDeleted(const class UObjectBase* InObject, int32 Index)
 {
+    if (BindJsClasses.Test(Index))
+    {
+        BindJsClasses.ClearAtomic(Index);
+    }
     // UE_LOG(PuertsModule, Warning, TEXT("NotifyUObjectDeleted, %p"), InObject);
 }
 
@@ -318,6 +398,7 @@ void FPuertsModule::EndPIE(bool bIsSimulating)
     bIsInPIE = false;
     if (Enabled)
     {
+        GCScheduler.Reset();
         JsEnv.Reset();
         for (TObjectIterator<UClass> It; It; ++It)
         {
@@ -389,6 +470,28 @@ void FPuertsModule::RegisterSettings()
         GConfig->GetBool(SectionName, TEXT("WatchDisable"), Settings.WatchDisable, PuertsConfigIniPath);
     }
 
+    // GC调度的配置允许按平台覆盖，先读DefaultPuerts.ini，再读Config/<Platform>/<Platform>Puerts.ini
+    const FString PlatformName = FPlatformProperties::IniPlatformName();
+#if (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1) || ENGINE_MAJOR_VERSION > 5
+    const FString PlatformConfigIniPath = FConfigCacheIni::NormalizeConfigIniPath(
+        FPaths::SourceConfigDir() / PlatformName / PlatformName + TEXT("Puerts.ini"));
+#else
+    const FString PlatformConfigIniPath = FPaths::SourceConfigDir() / PlatformName / PlatformName + TEXT("Puerts.ini");
+#endif
+    for (const FString& ConfigIniPath : {PuertsConfigIniPath, PlatformConfigIniPath})
+    {
+        if (GConfig->DoesSectionExist(SectionName, ConfigIniPath))
+        {
+            GConfig->GetBool(SectionName, TEXT("IdleGCEnable"), Settings.IdleGCEnable, ConfigIniPath);
+            GConfig->GetFloat(SectionName, TEXT("IdleGCTargetFrameRate"), Settings.IdleGCTargetFrameRate, ConfigIniPath);
+            GConfig->GetFloat(SectionName, TEXT("IdleGCMinTimeMs"), Settings.IdleGCMinTimeMs, ConfigIniPath);
+            GConfig->GetFloat(SectionName, TEXT("IdleGCMaxTimeMs"), Settings.IdleGCMaxTimeMs, ConfigIniPath);
+            GConfig->GetFloat(SectionName, TEXT("IdleGCSafetyMarginMs"), Settings.IdleGCSafetyMarginMs, ConfigIniPath);
+            GConfig->GetBool(
+                SectionName, TEXT("LowMemoryNotificationOnLoadMap"), Settings.LowMemoryNotificationOnLoadMap, ConfigIniPath);
+        }
+    }
+
     DebuggerPortFromCommandLine = GetDebuggerPortFromCommandLine();
 }
 
@@ -445,6 +548,19 @@ void FPuertsModule::StartupModule()
 
     WatchEnabled = !Settings.WatchDisable;
 
+    ConsoleCommands.Add(MakeUnique<FAutoConsoleCommand>(TEXT("Puerts.BenchmarkObjectCreation"),
+        TEXT("Create N (default 100000) transient UObjects and log the per-object cost of the puerts create listener"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FPuertsModule::BenchmarkObjectCreation)));
+    ConsoleCommands.Add(MakeUnique<FAutoConsoleCommand>(TEXT("Puerts.StartCpuProfile"),
+        TEXT("Start sampling the running JsEnv(s) with the v8 cpu profiler. Args: [SamplingIntervalUs]"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FPuertsModule::StartCpuProfile)));
+    ConsoleCommands.Add(MakeUnique<FAutoConsoleCommand>(TEXT("Puerts.StopCpuProfile"),
+        TEXT("Stop the cpu profiler and write a .cpuprofile file, relative paths are under Saved/Profiling. Args: [FilePath]"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FPuertsModule::StopCpuProfile)));
+    ConsoleCommands.Add(MakeUnique<FAutoConsoleCommand>(TEXT("Puerts.HeapSnapshot"),
+        TEXT("Write a .heapsnapshot file of the running JsEnv(s), relative paths are under Saved/Profiling. Args: [FilePath]"),
+        FConsoleCommandWithArgsDelegate::CreateRaw(this, &FPuertsModule::TakeHeapSnapshot)));
+
     // SetJsEnvSelector([this](UObject* Obj, int Size){
     //    return 1;
     //    });
@@ -456,6 +572,7 @@ void FPuertsModule::Enable()
 
     // 在MakeSharedJsEnv->RebindJs->load js 可能会有逻辑触发对象加载, 例如直接LoadClass
     // AddUObjectCreateListener逻辑在rebindjs后则可能导致Inject缺漏导致 部分重写方法报错漏调用
+    InitBindJsClasses();
     GUObjectArray.AddUObjectCreateListener(static_cast<FUObjectArray::FUObjectCreateListener*>(this));
     GUObjectArray.AddUObjectDeleteListener(static_cast<FUObjectArray::FUObjectDeleteListener*>(this));
 #if WITH_EDITOR
@@ -472,12 +589,146 @@ void FPuertsModule::Enable()
 void FPuertsModule::Disable()
 {
     Enabled = false;
+    GCScheduler.Reset();
     JsEnv.Reset();
     JsEnvGroup.Reset();
     GUObjectArray.RemoveUObjectCreateListener(static_cast<FUObjectArray::FUObjectCreateListener*>(this));
     GUObjectArray.RemoveUObjectDeleteListener(static_cast<FUObjectArray::FUObjectDeleteListener*>(this));
 }
 
+void FPuertsModule::InitBindJsClasses()
+{
+    // 容量在启动时就固定了，只有第一次会分配；之前残留的位最多让对应类的实例多走一次TryBindJs
+    BindJsClasses.Reserve(GUObjectArray.GetObjectArrayCapacity());
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        UClass* Class = *It;
+        if (Class->IsA<UTypeScriptGeneratedClass>() || Class->IsChildOf(UTypeScriptGeneratedClass::StaticClass()))
+        {
+            BindJsClasses.SetAtomic(GUObjectArray.ObjectToIndex(Class));
+        }
+    }
+}
+
+void FPuertsModule::BenchmarkObjectCreation(const TArray<FString>& Args)
+{
+    const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+    TArray<UObject*> Objects;
+    Objects.Reserve(Count);
+
+    // 包含所有create listener在内的创建开销
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Count; i++)
+    {
+        Objects.Add(NewObject<UPuertsBenchmarkObject>(GetTransientPackage()));
+    }
+    const double CreateSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // 单独测puerts listener的开销，以及不过滤直接TryBindJs的开销作对比
+    StartTime = FPlatformTime::Seconds();
+    for (UObject* Object : Objects)
+    {
+        NotifyUObjectCreated(Object, GUObjectArray.ObjectToIndex(Object));
+    }
+    const double ListenerSeconds = FPlatformTime::Seconds() - StartTime;
+
+    double TryBindJsSeconds = 0;
+    if (JsEnv.IsValid() || JsEnvGroup.IsValid())
+    {
+        StartTime = FPlatformTime::Seconds();
+        for (UObject* Object : Objects)
+        {
+            if (JsEnv.IsValid())
+            {
+                JsEnv->TryBindJs(Object);
+            }
+            else
+            {
+                JsEnvGroup->TryBindJs(Object);
+            }
+        }
+        TryBindJsSeconds = FPlatformTime::Seconds() - StartTime;
+    }
+
+    // 这些对象没有引用，下次GC回收
+    UE_LOG(PuertsModule, Display,
+        TEXT("object creation benchmark: count=%d create=%.1fns/obj listener=%.1fns/obj unfiltered_try_bind_js=%.1fns/obj"), Count,
+        CreateSeconds * 1e9 / Count, ListenerSeconds * 1e9 / Count, TryBindJsSeconds * 1e9 / Count);
+}
+
+// 虚拟机组里每个虚拟机各写一个文件，文件名后面加上虚拟机下标
+static FString GetJsEnvOutputPath(const FString& FilePath, int32 EnvIndex, const TCHAR* Extension)
+{
+    if (FilePath.IsEmpty())
+    {
+        return FString::Printf(TEXT("Puerts-%s-%d%s"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), EnvIndex, Extension);
+    }
+    const FString FileName =
+        FString::Printf(TEXT("%s-%d%s"), *FPaths::GetBaseFilename(FilePath), EnvIndex, *FPaths::GetExtension(FilePath, true));
+    const FString Dir = FPaths::GetPath(FilePath);
+    return Dir.IsEmpty() ? FileName : Dir / FileName;
+}
+
+void FPuertsModule::StartCpuProfile(const TArray<FString>& Args)
+{
+    const int32 SamplingIntervalUs = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0;
+    if (JsEnv.IsValid())
+    {
+        JsEnv->StartCpuProfile(SamplingIntervalUs);
+    }
+    else if (NumberOfJsEnv > 1 && JsEnvGroup.IsValid())
+    {
+        for (int i = 0; i < NumberOfJsEnv; i++)
+        {
+            JsEnvGroup->Get(i)->StartCpuProfile(SamplingIntervalUs);
+        }
+    }
+    else
+    {
+        UE_LOG(PuertsModule, Warning, TEXT("no running JsEnv to profile"));
+    }
+}
+
+void FPuertsModule::StopCpuProfile(const TArray<FString>& Args)
+{
+    const FString FilePath = Args.Num() > 0 ? Args[0] : FString();
+    if (JsEnv.IsValid())
+    {
+        JsEnv->StopCpuProfile(FilePath);
+    }
+    else if (NumberOfJsEnv > 1 && JsEnvGroup.IsValid())
+    {
+        for (int i = 0; i < NumberOfJsEnv; i++)
+        {
+            JsEnvGroup->Get(i)->StopCpuProfile(GetJsEnvOutputPath(FilePath, i, TEXT(".cpuprofile")));
+        }
+    }
+    else
+    {
+        UE_LOG(PuertsModule, Warning, TEXT("no running JsEnv to profile"));
+    }
+}
+
+void FPuertsModule::TakeHeapSnapshot(const TArray<FString>& Args)
+{
+    const FString FilePath = Args.Num() > 0 ? Args[0] : FString();
+    if (JsEnv.IsValid())
+    {
+        JsEnv->TakeHeapSnapshot(FilePath);
+    }
+    else if (NumberOfJsEnv > 1 && JsEnvGroup.IsValid())
+    {
+        for (int i = 0; i < NumberOfJsEnv; i++)
+        {
+            JsEnvGroup->Get(i)->TakeHeapSnapshot(GetJsEnvOutputPath(FilePath, i, TEXT(".heapsnapshot")));
+        }
+    }
+    else
+    {
+        UE_LOG(PuertsModule, Warning, TEXT("no running JsEnv to take heap snapshot"));
+    }
+}
+
 #if WITH_EDITOR
 bool FPuertsModule::HandleSettingsSaved()
 {
@@ -511,4 +762,5 @@ void FPuertsModule::ShutdownModule()
     {
         Disable();
     }
+    ConsoleCommands.Empty();
 }
@@ -49,6 +49,36 @@ public:
         meta = (DisplayName = "Disable TypeScript Watch", defaultValue = false))
     bool WatchDisable = false;
 
+    // 以下GC相关的配置可以在Config/<Platform>/<Platform>Puerts.ini里按平台覆盖
+
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection",
+        meta = (DisplayName = "Idle Time GC Enable", defaultValue = true,
+            Tooltip = "Give the spare time at the end of each frame to the v8 gc"))
+    bool IdleGCEnable = true;
+
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection",
+        meta = (DisplayName = "Idle Time GC Target Frame Rate", defaultValue = 0,
+            Tooltip = "Frame rate used to compute the spare time, 0: the engine max tick rate, or 60 if it is unlimited"))
+    float IdleGCTargetFrameRate = 0;
+
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection",
+        meta = (DisplayName = "Idle Time GC Min Time (ms)", defaultValue = 1, Tooltip = "Skip the frame if the spare time is less than this"))
+    float IdleGCMinTimeMs = 1;
+
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection",
+        meta = (DisplayName = "Idle Time GC Max Time (ms)", defaultValue = 4, Tooltip = "Upper limit of the time given to v8 per frame"))
+    float IdleGCMaxTimeMs = 4;
+
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection",
+        meta = (DisplayName = "Idle Time GC Safety Margin (ms)", defaultValue = 1,
+            Tooltip = "Spare time kept back for the frame end work not measured here"))
+    float IdleGCSafetyMarginMs = 1;
+
+    UPROPERTY(config, EditAnywhere, Category = "Garbage Collection",
+        meta = (DisplayName = "Full GC After Map Loaded", defaultValue = true,
+            Tooltip = "Call LowMemoryNotification after a map is loaded, while the loading screen is still up"))
+    bool LowMemoryNotificationOnLoadMap = true;
+
     UPROPERTY(config, EditAnywhere, Category = "Declaration Generator", meta = (DisplayName = "D.ts Ignore Class Name List"))
     TArray<FString> IgnoreClassListOnDTS;
 
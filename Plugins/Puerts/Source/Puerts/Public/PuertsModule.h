@@ -50,6 +50,12 @@ public:
 
     virtual const TArray<FString>& GetIgnoreStructListOnDTS() = 0;
 
+    // 默认虚拟机的js根目录（相对Content），即设置里的JavaScript Source Root
+    virtual const FString& GetRootPath() = 0;
+
+    // 对所有虚拟机做一次完整GC并尽量归还内存，适合在loading、切换菜单等看不出卡顿的时机调用
+    virtual void LowMemoryNotification() = 0;
+
 #if WITH_EDITOR
     virtual bool IsInPIE() = 0;
 #endif
@@ -20,6 +20,10 @@
 #include "UEDataBinding.hpp"
 #include "Object.hpp"
 #include "PString.h"
+#include "Commandlets/CookCommandlet.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Interfaces/ITargetPlatformManagerModule.h"
+#include "Misc/App.h"
 
 class FPuertsEditorModule : public IPuertsEditorModule
 {
@@ -46,6 +50,8 @@ private:
 
     void OnPostEngineInit();
 
+    void GenerateCookedManifests();
+
     TSharedPtr<PUERTS_NAMESPACE::FJsEnv> JsEnv;
 
     TSharedPtr<PUERTS_NAMESPACE::FSourceFileWatcher> SourceFileWatcher;
@@ -71,6 +77,31 @@ struct AutoRegisterForPEM
 
 AutoRegisterForPEM _AutoRegisterForPEM__;
 
+static bool IsRunningCookCommandlet()
+{
+    UClass* CommandletClass = GetRunningCommandletClass();
+    return IsRunningCommandlet() && CommandletClass && CommandletClass->IsChildOf(UCookCommandlet::StaticClass());
+}
+
+// 与cook的输出目录规则一致：默认Saved/Cooked/[Platform]，可以用-OutputDir=覆盖
+static FString GetCookedContentDir(const ITargetPlatform* TargetPlatform, bool bMultiplePlatforms)
+{
+    FString OutputDir;
+    if (FParse::Value(FCommandLine::Get(), TEXT("OutputDir="), OutputDir))
+    {
+        if (bMultiplePlatforms && !OutputDir.Contains(TEXT("[Platform]")))
+        {
+            OutputDir = OutputDir / TEXT("[Platform]");
+        }
+    }
+    else
+    {
+        OutputDir = FPaths::ProjectSavedDir() / TEXT("Cooked") / TEXT("[Platform]");
+    }
+    OutputDir.ReplaceInline(TEXT("[Platform]"), *TargetPlatform->PlatformName());
+    return FPaths::ConvertRelativePathToFull(OutputDir) / FApp::GetProjectName() / TEXT("Content");
+}
+
 IMPLEMENT_MODULE(FPuertsEditorModule, PuertsEditor)
 
 void FPuertsEditorModule::StartupModule()
@@ -122,6 +153,8 @@ void FPuertsEditorModule::OnPostEngineInit()
         SourceFileWatcher = MakeShared<PUERTS_NAMESPACE::FSourceFileWatcher>(
             [this](const FString& InPath)
             {
+                // 文件变化可能改变模块解析结果（比如新增了同名的index.js），查找缓存全部作废
+                PUERTS_NAMESPACE::DefaultJSModuleLoader::InvalidateAllSearchCaches();
                 if (JsEnv.IsValid())
                 {
                     TArray<uint8> Source;
@@ -151,8 +184,29 @@ void FPuertsEditorModule::OnPostEngineInit()
     }
 }
 
+void FPuertsEditorModule::GenerateCookedManifests()
+{
+    // 模块清单写到各平台的cook输出目录，随cook结果一起打包，打包后按清单查找模块，不再逐个探测文件是否存在
+    const TArray<ITargetPlatform*>& Platforms = GetTargetPlatformManagerRef().GetActiveTargetPlatforms();
+    const FString ScriptRoot = IPuertsModule::Get().GetRootPath();
+    for (const ITargetPlatform* TargetPlatform : Platforms)
+    {
+        const FString OutputDir = GetCookedContentDir(TargetPlatform, Platforms.Num() > 1) / ScriptRoot;
+        if (!PUERTS_NAMESPACE::DefaultJSModuleLoader::GenerateManifest(ScriptRoot, OutputDir))
+        {
+            UE_LOG(Puerts, Warning, TEXT("generate js module manifest fail: %s"), *OutputDir);
+        }
+    }
+}
+
 void FPuertsEditorModule::ShutdownModule()
 {
+    // 完整cook开始时会清空输出目录，所以等cook结束再写清单
+    if (IsRunningCookCommandlet())
+    {
+        GenerateCookedManifests();
+    }
+
     CmdImpl = nullptr;
     if (JsEnv.IsValid())
     {
@@ -166,6 +220,8 @@ void FPuertsEditorModule::ShutdownModule()
 
 void FPuertsEditorModule::PreBeginPIE(bool bIsSimulating)
 {
+    // 编辑期间可能新增、删除或移动了js文件，PIE用新的查找结果
+    PUERTS_NAMESPACE::DefaultJSModuleLoader::InvalidateAllSearchCaches();
     if (Enabled)
     {
     }
@@ -0,0 +1,144 @@
+/*
+ * Tencent is pleased to support the open source community by making Puerts available.
+ * Copyright (C) 2020 Tencent.  All rights reserved.
+ * Puerts is licensed under the BSD 3-Clause License, except for the third-party components listed in the file 'LICENSE' which may
+ * be subject to their corresponding license terms. This file is subject to the terms and conditions defined in file 'LICENSE',
+ * which is part of this source code package.
+ */
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "WasmEnv.h"
+#include "WasmRuntime.h"
+#include "WasmModuleInstance.h"
+
+static TAutoConsoleVariable<int32> CVarWasmBenchmarkInstantiateCount(
+    TEXT("Wasm.Benchmark.InstantiateCount"), 100, TEXT("How many times Wasm.Benchmark instantiates the module"), ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarWasmBenchmarkCallCount(
+    TEXT("Wasm.Benchmark.CallCount"), 1000000, TEXT("How many times Wasm.Benchmark calls the function"), ECVF_Default);
+
+//每次都用新的runtime,链接分类0,即WASM_BEGIN_LINK_GLOBAL(xxx, 0)注册的函数(包括WasmTestForStaticBinding里的)
+static double BenchmarkInstantiate(const TArray<uint8>& FileData, bool LazyCompile, int32 Count)
+{
+    WasmEnv Env;
+    Env.SetLazyCompile(LazyCompile);
+    double TotalSeconds = 0;
+    for (int32 i = 0; i < Count; ++i)
+    {
+        TArray<uint8> Data = FileData;
+        WasmRuntime Runtime(&Env);
+        const double StartTime = FPlatformTime::Seconds();
+        WasmModuleInstance* Instance = new WasmModuleInstance(Data);
+        const bool Succeeded = Instance->ParseModule(&Env) && Instance->LoadModule(&Runtime, 0);
+        TotalSeconds += FPlatformTime::Seconds() - StartTime;
+        if (!Succeeded)
+        {
+            delete Instance;
+            return -1;
+        }
+    }
+    UE_LOG(LogTemp, Display, TEXT("Wasm.Benchmark: instantiate lazy_compile=%d avg=%.3fms (bytes cache hits=%d misses=%d)"),
+        LazyCompile, TotalSeconds * 1000 / Count, Env.GetModuleBytesCacheHits(), Env.GetModuleBytesCacheMisses());
+    return TotalSeconds;
+}
+
+static void BenchmarkCall(const TArray<uint8>& FileData, const FString& FunctionName, const TArray<FString>& CallArgs, int32 Count)
+{
+    WasmEnv Env;
+    WasmRuntime Runtime(&Env);
+    TArray<uint8> Data = FileData;
+    WasmModuleInstance* Instance = new WasmModuleInstance(Data);
+    if (!Instance->ParseModule(&Env) || !Instance->LoadModule(&Runtime, 0))
+    {
+        delete Instance;
+        return;
+    }
+
+    IM3Function Function = nullptr;
+    M3Result Err = m3_FindFunction(&Function, Runtime.GetRuntime(), TCHAR_TO_UTF8(*FunctionName));
+    if (Err)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Wasm.Benchmark: can not find function %s: %s"), *FunctionName, ANSI_TO_TCHAR(Err));
+        return;
+    }
+    const uint32 ArgCount = m3_GetArgCount(Function);
+    if (ArgCount != static_cast<uint32>(CallArgs.Num()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Wasm.Benchmark: %s expects %u arguments, got %d"), *FunctionName, ArgCount, CallArgs.Num());
+        return;
+    }
+
+    //参数只解析一次,循环里直接m3_Call
+    TArray<uint64> ArgValues;
+    TArray<const void*> ArgPointers;
+    ArgValues.AddZeroed(ArgCount);
+    for (uint32 i = 0; i < ArgCount; ++i)
+    {
+        void* Value = &ArgValues[i];
+        switch (m3_GetArgType(Function, i))
+        {
+            case c_m3Type_i32:
+                *static_cast<int32*>(Value) = FCString::Atoi(*CallArgs[i]);
+                break;
+            case c_m3Type_i64:
+                *static_cast<int64*>(Value) = FCString::Atoi64(*CallArgs[i]);
+                break;
+            case c_m3Type_f32:
+                *static_cast<float*>(Value) = FCString::Atof(*CallArgs[i]);
+                break;
+            case c_m3Type_f64:
+                *static_cast<double*>(Value) = FCString::Atod(*CallArgs[i]);
+                break;
+            default:
+                UE_LOG(LogTemp, Error, TEXT("Wasm.Benchmark: unsupported argument type at %u"), i);
+                return;
+        }
+        ArgPointers.Add(Value);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Count; ++i)
+    {
+        Err = m3_Call(Function, ArgCount, ArgPointers.GetData());
+        if (Err)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Wasm.Benchmark: call %s fail: %s"), *FunctionName, ANSI_TO_TCHAR(Err));
+            return;
+        }
+    }
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+    UE_LOG(LogTemp, Display, TEXT("Wasm.Benchmark: %s calls=%d %.0f calls/s %.1fns/call"), *FunctionName, Count, Count / Seconds,
+        Seconds * 1e9 / Count);
+}
+
+static FAutoConsoleCommand WasmBenchmarkCommand(TEXT("Wasm.Benchmark"),
+    TEXT("Measure module instantiate time (full vs lazy compile) and calls per second of an exported function. "
+         "Args: [WasmFile relative to Content, default JavaScript/wasm/main.wasm] [FunctionName] [FunctionArgs...]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda(
+        [](const TArray<FString>& Args)
+        {
+            const FString WasmFile = Args.Num() > 0 ? Args[0] : TEXT("JavaScript/wasm/main.wasm");
+            const FString FullPath = FPaths::IsRelative(WasmFile) ? FPaths::ProjectContentDir() / WasmFile : WasmFile;
+            TArray<uint8> FileData;
+            if (!FFileHelper::LoadFileToArray(FileData, *FullPath))
+            {
+                UE_LOG(LogTemp, Error, TEXT("Wasm.Benchmark: can not load %s"), *FullPath);
+                return;
+            }
+
+            const int32 InstantiateCount = FMath::Max(CVarWasmBenchmarkInstantiateCount.GetValueOnGameThread(), 1);
+            if (BenchmarkInstantiate(FileData, false, InstantiateCount) < 0 || BenchmarkInstantiate(FileData, true, InstantiateCount) < 0)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Wasm.Benchmark: instantiate %s fail"), *FullPath);
+                return;
+            }
+
+            if (Args.Num() > 1)
+            {
+                TArray<FString> CallArgs(Args.GetData() + 2, Args.Num() - 2);
+                BenchmarkCall(FileData, Args[1], CallArgs, FMath::Max(CVarWasmBenchmarkCallCount.GetValueOnGameThread(), 1));
+            }
+        }));
@@ -20,4 +20,28 @@ WasmEnv::~WasmEnv()
         m3_FreeEnvironment(_Env);
         _Env = nullptr;
     }
-}
\ No newline at end of file
+}
+
+WasmModuleBytes WasmEnv::FindOrAddModuleBytes(TArray<uint8>& InData)
+{
+    const uint32 Hash = FCrc::MemCrc32(InData.GetData(), InData.Num());
+    TArray<TWeakPtr<const TArray<uint8>, ESPMode::ThreadSafe>>& Entries = _ModuleBytesCache.FindOrAdd(Hash);
+    for (int32 i = Entries.Num() - 1; i >= 0; --i)
+    {
+        WasmModuleBytes Bytes = Entries[i].Pin();
+        if (!Bytes.IsValid())
+        {
+            Entries.RemoveAtSwap(i);
+        }
+        else if (Bytes->Num() == InData.Num() && FMemory::Memcmp(Bytes->GetData(), InData.GetData(), InData.Num()) == 0)
+        {
+            ++_ModuleBytesCacheHits;
+            return Bytes;
+        }
+    }
+
+    ++_ModuleBytesCacheMisses;
+    WasmModuleBytes Bytes = MakeShared<const TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(InData));
+    Entries.Add(Bytes);
+    return Bytes;
+}
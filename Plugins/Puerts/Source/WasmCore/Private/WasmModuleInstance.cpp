@@ -12,6 +12,7 @@
 #include "WasmFunction.h"
 #include "WasmStaticLink.h"
 #include "WasmEnv.h"
+#include "m3_compile.h"
 
 WasmModuleInstance::WasmModuleInstance(TArray<uint8>& InData)
 {
@@ -21,12 +22,14 @@ WasmModuleInstance::WasmModuleInstance(TArray<uint8>& InData)
 bool WasmModuleInstance::ParseModule(WasmEnv* Env)
 {
     _Module = nullptr;
-    M3Result err = m3_ParseModule(Env->GetEnv(), &_Module, Data.GetData(), Data.Num());    // m3_FreeModule
+    Bytes = Env->FindOrAddModuleBytes(Data);
+    Data.Empty();
+    M3Result err = m3_ParseModule(Env->GetEnv(), &_Module, Bytes->GetData(), Bytes->Num());    // m3_FreeModule
     if (err)
     {
         _Module = nullptr;
         UE_LOG(LogTemp, Error, TEXT("m3_ParseModule:%s"), ANSI_TO_TCHAR(err));
-        Data.Empty();
+        Bytes.Reset();
         return false;
     }
     return true;
@@ -49,7 +52,7 @@ bool WasmModuleInstance::LoadModule(WasmRuntime* Runtime, int LinkCategory, Addi
         UE_LOG(LogTemp, Error, TEXT("m3_LoadModule:%s"), ANSI_TO_TCHAR(err));
         m3_FreeModule(_Module);
         _Module = nullptr;
-        Data.Empty();
+        Bytes.Reset();
         return false;
     }
 
@@ -57,7 +60,7 @@ bool WasmModuleInstance::LoadModule(WasmRuntime* Runtime, int LinkCategory, Addi
     {
         if (!WasmStaticLinkClass::Link(_Module, LinkCategory))
         {
-            Data.Empty();
+            Bytes.Reset();
             return false;
         }
     }
@@ -67,21 +70,41 @@ bool WasmModuleInstance::LoadModule(WasmRuntime* Runtime, int LinkCategory, Addi
         if (!_Func(_Module))
         {
             UE_LOG(LogTemp, Error, TEXT("wasm module addition link function error"));
-            Data.Empty();
+            Bytes.Reset();
             return false;
         }
     }
 
-    //这里需要把所有函数都compile掉,否则在函数调用的过程中如果触发compile,会有写越界
-    //这是因为compile需要读取wasm的原始数据(类似v8需要js原始代码一样)
-    //这里暂时不想保留wasm的源码,所以先全部compile
-    //未来如果有crash,就再考虑保留源码
-    err = m3_CompileModule(_Module);
-    if (err)
+    // compile需要读取wasm的原始数据(类似v8需要js原始代码一样),在函数调用的过程中触发compile要求字节码还在
+    //延迟编译时只编译导出函数(外部调用的入口,也是进入_AllExportFunctions的前提),其余函数第一次被调用时由wasm3编译,
+    // Bytes随实例一直保留;全部compile的话之后就可以释放字节码
+    const bool LazyCompile = Runtime->GetEnv()->IsLazyCompile();
+    if (LazyCompile)
     {
-        UE_LOG(LogTemp, Error, TEXT("m3_CompileModule: %s"), ANSI_TO_TCHAR(err));
-        Data.Empty();
-        return false;
+        for (u32 i = 0; i < _Module->numFunctions; ++i)
+        {
+            IM3Function f = &_Module->functions[i];
+            if (f->wasm && !f->compiled && f->export_name && *(f->export_name))
+            {
+                err = CompileFunction(f);
+                if (err)
+                {
+                    UE_LOG(LogTemp, Error, TEXT("CompileFunction: %s %s"), ANSI_TO_TCHAR(err), ANSI_TO_TCHAR(f->export_name));
+                    Bytes.Reset();
+                    return false;
+                }
+            }
+        }
+    }
+    else
+    {
+        err = m3_CompileModule(_Module);
+        if (err)
+        {
+            UE_LOG(LogTemp, Error, TEXT("m3_CompileModule: %s"), ANSI_TO_TCHAR(err));
+            Bytes.Reset();
+            return false;
+        }
     }
 
     for (u32 i = 0; i < _Module->numFunctions; ++i)
@@ -92,8 +115,10 @@ bool WasmModuleInstance::LoadModule(WasmRuntime* Runtime, int LinkCategory, Addi
             _AllExportFunctions.Add(f->export_name, new WasmFunction(f));
         }
     }
-    //清理下data,如果有crash就不清理了吧
-    Data.Empty();
+    if (!LazyCompile)
+    {
+        Bytes.Reset();
+    }
     Runtime->OnModuleInstance(this);
     return true;
 
@@ -10,11 +10,23 @@
 #include "CoreMinimal.h"
 #include "WasmCommonIncludes.h"
 
+using WasmModuleBytes = TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>;
+
 class WASMCORE_API WasmEnv final
 {
 private:
     IM3Environment _Env;
 
+    //按内容去重的wasm字节码,同一份字节码多次实例化时共享,只要还有实例在用就不会释放
+    //wasm3解析出的IM3Module以及编译出的代码都属于加载它的runtime,无法跨实例共享,能共享的只有字节码
+    TMap<uint32, TArray<TWeakPtr<const TArray<uint8>, ESPMode::ThreadSafe>>> _ModuleBytesCache;
+
+    bool _LazyCompile = true;
+
+    int32 _ModuleBytesCacheHits = 0;
+
+    int32 _ModuleBytesCacheMisses = 0;
+
 public:
     WasmEnv();
     ~WasmEnv();
@@ -22,4 +34,28 @@ public:
     {
         return _Env;
     }
+
+    //返回与InData内容相同的共享字节码,未命中时InData被移动进缓存
+    WasmModuleBytes FindOrAddModuleBytes(TArray<uint8>& InData);
+
+    //开启时LoadModule只编译导出函数,其余函数在第一次被调用时由wasm3编译,实例需要一直持有字节码
+    FORCEINLINE bool IsLazyCompile() const
+    {
+        return _LazyCompile;
+    }
+
+    FORCEINLINE void SetLazyCompile(bool LazyCompile)
+    {
+        _LazyCompile = LazyCompile;
+    }
+
+    FORCEINLINE int32 GetModuleBytesCacheHits() const
+    {
+        return _ModuleBytesCacheHits;
+    }
+
+    FORCEINLINE int32 GetModuleBytesCacheMisses() const
+    {
+        return _ModuleBytesCacheMisses;
+    }
 };
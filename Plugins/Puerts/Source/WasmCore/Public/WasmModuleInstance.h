@@ -11,6 +11,7 @@
 #include "wasm3.h"
 #include "m3_env.h"
 #include "WasmCommonIncludes.h"
+#include "WasmEnv.h"
 #include <functional>
 class WasmRuntime;
 class WasmFunction;
@@ -24,6 +25,8 @@ private:
     IM3Module _Module;
     TMap<FName, WasmFunction*> _AllExportFunctions;
     TArray<uint8> Data;
+    //ParseModule后的字节码,和同内容的其它实例共享;延迟编译时函数体直接从这里读取,所以要和_Module一样长寿
+    WasmModuleBytes Bytes;
 
 public:
     WasmModuleInstance(TArray<uint8>& InData);
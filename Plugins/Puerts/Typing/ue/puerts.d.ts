@@ -60,6 +60,10 @@ declare module "ue" {
         GetMaxIndex(): number;  // TODO - GetMaxIndex的返回值是InvalidIndex，合理吗？（GetMaxIndex的解释应该是：最大合法index+1），当调用Empty，返回值为0
         IsValidIndex(Index: number): boolean;
         Empty(): void;
+        NextBatch(StartIndex: number, MaxCount: number, Out: T[]): number;  // 返回下一批的起始索引，遍历结束返回-1
+        Values(): T[];
+        AddMany(Values: T[]): void;
+        RemoveMany(Values: T[]): number;
         [Symbol.iterator](): IterableIterator<T>;
     }
     
@@ -74,6 +78,12 @@ declare module "ue" {
         IsValidIndex(Index: number): boolean;
         GetKey(Index: number): TKey;            // TODO - 对于非法index，是否应该返回undefined
         Empty(): void;
+        NextBatch(StartIndex: number, MaxCount: number, Out: [TKey, TValue][]): number;  // 返回下一批的起始索引，遍历结束返回-1
+        Keys(): TKey[];
+        Values(): TValue[];
+        Entries(): [TKey, TValue][];
+        AddMany(Entries: [TKey, TValue][]): void;   // 所有元素写入后只rehash一次
+        RemoveMany(Keys: TKey[]): number;           // 返回实际移除的个数
         [Symbol.iterator](): IterableIterator<[TKey, TValue]>;
     }
 
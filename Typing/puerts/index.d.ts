@@ -92,4 +92,26 @@ declare module "puerts" {
     function $async<T>(x: T) : AsyncObject<T>;*/
 
     function setJsTakeRef(object : Object) : void;
+
+    /**
+     * 在独立线程的isolate上运行的模块，worker里没有UE对象，只能交换可结构化克隆的数据。
+     * worker侧通过self.onmessage接收postMessage，通过self.onrequest处理request并返回结果（可以是Promise）。
+     */
+    class Worker {
+        constructor(moduleName: string);
+        readonly id: number;
+        readonly pendingCount: number;
+        onmessage: ((ev: {data: any}) => void) | undefined;
+        onerror: ((ev: {message: string}) => void) | undefined;
+        postMessage(message: any, transfer?: ArrayBuffer[]): void;
+        request<T = any>(data: any, transfer?: ArrayBuffer[]): Promise<T>;
+        terminate(): void;
+    }
+
+    class WorkerPool {
+        constructor(moduleName: string, size: number);
+        readonly size: number;
+        run<T = any>(data: any, transfer?: ArrayBuffer[]): Promise<T>;
+        terminate(): void;
+    }
 }